@@ -13,17 +13,48 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <locale.h>
+#include <unistd.h>
 #include "../dictionary/dictionary.h"
 #include "../dictionary/word_list.h"
 #include "wctype.h"
 
 #define SINGLE_WORD_MAX_LENGTH 8192 ///<Size of the buffer for single word.
+#define HINTS_BATCH_SIZE 256 ///<Number of misspelled words for which hints are generated at once.
+#define CHECK_BLOCK_TOKENS 256 ///<Number of read pieces of text checked at once.
+#define CHECK_BLOCK_LENGTH (4 * SINGLE_WORD_MAX_LENGTH) ///<Size of the buffer of pieces of text checked at once.
+
+/**
+ * Misspelled word waiting for hints.
+ */
+typedef struct
+{
+    wchar_t* word; ///<Copy of the word.
+    int line; ///<Line number of the word.
+    int column; ///<Column number of the word.
+} Misspelling;
+
+/**
+ * Piece of text waiting to be checked.
+ */
+typedef struct
+{
+    wchar_t* text; ///<The piece, in block_text.
+    bool is_word; ///<True if the piece is a word.
+    int line; ///<Line number of the piece.
+    int column; ///<Column number of the piece.
+} Token;
 
 static struct dictionary* dict; ///<Global pointer to store dict.
 static int line = 1; ///<Variable used by read_it to store current line number.
 static int column = 1; ///<Variable used by read_it to store current column number.
 static int word_line; ///<Variable used to store recently read word line number.
 static int word_column; ///<Variable used to store recently read word column number.
+static Misspelling pending[HINTS_BATCH_SIZE]; ///<Misspelled words waiting for hints.
+static int pending_count = 0; ///<Number of misspelled words waiting for hints.
+static Token tokens[CHECK_BLOCK_TOKENS]; ///<Pieces of text waiting to be checked.
+static int token_count = 0; ///<Number of pieces of text waiting to be checked.
+static wchar_t block_text[CHECK_BLOCK_LENGTH]; ///<Pieces of text waiting to be checked, each ended by L'\0'.
+static size_t block_length = 0; ///<Used length of block_text.
 
 /**
  * @brief read_it Reads word or piece of something.
@@ -72,6 +103,91 @@ static bool read_it(wchar_t* dest, bool* is_word)
     }
 }
 
+/**
+ * @brief flush_hints Generates hints for all pending misspelled words and prints them, the closest first.
+ * @param options Limits of hints generation.
+ */
+static void flush_hints(const Hints_Options* options)
+{
+    if(pending_count == 0)
+        return;
+    const wchar_t* words[HINTS_BATCH_SIZE];
+    struct word_list lists[HINTS_BATCH_SIZE];
+    for(int i = 0; i < pending_count; i++)
+        words[i] = pending[i].word;
+    dictionary_hints_batch(dict, words, pending_count, options, lists);
+
+    for(int i = 0; i < pending_count; i++)
+    {
+        wchar_t** hints_tab = word_list_get_in_order(&lists[i]);
+        int hlen = word_list_size(&lists[i]);
+        fwprintf(stderr, L"%d,%d %ls: ", pending[i].line, pending[i].column, pending[i].word);
+        for(int j = 0; j < hlen; j++)
+        {
+            fwprintf(stderr, L"%ls ", hints_tab[j]);
+            free(hints_tab[j]);
+        }
+        fwprintf(stderr, L"\n");
+        free(hints_tab);
+        word_list_done(&lists[i]);
+        free(pending[i].word);
+    }
+    pending_count = 0;
+}
+
+/**
+ * @brief queue_hints Remembers misspelled word, hints are printed by flush_hints.
+ * @param word The word.
+ * @param line Line number of the word.
+ * @param column Column number of the word.
+ * @param options Limits of hints generation, used if the queue is full.
+ */
+static void queue_hints(const wchar_t* word, int line, int column, const Hints_Options* options)
+{
+    if(pending_count == HINTS_BATCH_SIZE)
+        flush_hints(options);
+    Misspelling* m = &pending[pending_count++];
+    m->word = malloc(sizeof(wchar_t) * (wcslen(word) + 1));
+    if(m->word == NULL)
+    {
+        fwprintf(stderr, L"Out of memory, ending..\n");
+        exit(EXIT_FAILURE);
+    }
+    wcscpy(m->word, word);
+    m->line = line;
+    m->column = column;
+}
+
+/**
+ * @brief flush_block Checks all pending pieces of text at once and prints them.
+ * @param hints True if hints are shown.
+ * @param options Limits of hints generation.
+ */
+static void flush_block(bool hints, const Hints_Options* options)
+{
+    const wchar_t* words[CHECK_BLOCK_TOKENS];
+    bool found[CHECK_BLOCK_TOKENS];
+    int word_count = 0;
+    for(int i = 0; i < token_count; i++)
+        if(tokens[i].is_word)
+            words[word_count++] = tokens[i].text;
+    dictionary_find_batch(dict, words, word_count, found);
+
+    word_count = 0;
+    for(int i = 0; i < token_count; i++)
+    {
+        if(tokens[i].is_word && !found[word_count++])
+        {
+            wprintf(L"#");
+            if(hints)
+                queue_hints(tokens[i].text, tokens[i].line, tokens[i].column, options);
+        }
+        wprintf(L"%ls", tokens[i].text);
+    }
+    token_count = 0;
+    block_length = 0;
+}
+
 /**
  * @brief main Parses arguments, checks text correctess.
  * @param argc Argument count. If less than 2, program terminates.
@@ -85,7 +201,7 @@ int main(int argc, char** argv)
 {
     setlocale(LC_ALL, "pl_PL.UTF-8");
     char* dict_name;
-    bool hints;
+    bool hints = false;
     if(argc < 2)
     {
         wprintf(L"What about dictionary..? Ending\n");
@@ -108,37 +224,40 @@ int main(int argc, char** argv)
         }
 
     }
-    FILE* file = fopen(dict_name, "r");
-    dict = dictionary_load(file);
+    //words saved by editors may still be in the journal of the file
+    dict = dictionary_load_file(dict_name);
     if(dict == NULL)
     {
         fwprintf(stderr, L"Cannot load dictionary, ending..\n");
         exit(EXIT_FAILURE);
     }
-    wchar_t word[SINGLE_WORD_MAX_LENGTH];
     bool is_word;
-    while(read_it(word, &is_word))
+    Hints_Options hints_options;
+    hints_default_options(&hints_options);
+    hints_options.threads = sysconf(_SC_NPROCESSORS_ONLN); //used only for long words
+    if(hints) //the same typos repeat in a text
+        dictionary_hints_cache_enable(dict, HINTS_CACHE_DEFAULT_ENTRIES, HINTS_CACHE_DEFAULT_BYTES);
+    //misspelled words are rejected reading one cache line, saved filter is used if present
+    dictionary_filter_enable(dict, DICTIONARY_FILTER_DEFAULT_RATE, DICTIONARY_FILTER_DEFAULT_BYTES);
+    //other words are checked in constant time, the trie is walked only for hints
+    dictionary_word_hash_enable(dict);
+    //a few hundred words make most of a text
+    dictionary_find_cache_enable(dict, FIND_CACHE_DEFAULT_ENTRIES);
+
+    //pieces are read directly to the block, which always has place for the longest one
+    while(read_it(block_text + block_length, &is_word))
     {
-        if(is_word)
-        {
-            if(dictionary_find(dict, word) != DICTIONARY_WORD_FOUND)
-            {
-                wprintf(L"#");
-                if(hints)
-                {
-                    struct word_list list;
-                    dictionary_hints(dict, word, &list);
-                    wchar_t** hints_tab = word_list_get(&list);
-                    int hlen = word_list_size(&list);
-                    fwprintf(stderr, L"%d,%d %ls: ", word_line, word_column, word);
-                    for(int i = 0; i < hlen; i++)
-                        fwprintf(stderr, L"%ls ", hints_tab[i]);
-
-                    fwprintf(stderr, L"\n");
-                }
-            }
-        }
-        wprintf(L"%ls", word);
+        Token* token = &tokens[token_count++];
+        token->text = block_text + block_length;
+        token->is_word = is_word;
+        token->line = word_line;
+        token->column = word_column;
+        block_length += wcslen(token->text) + 1;
+        if(token_count == CHECK_BLOCK_TOKENS || CHECK_BLOCK_LENGTH - block_length < SINGLE_WORD_MAX_LENGTH)
+            flush_block(hints, &hints_options);
     }
-    wprintf(L"%ls", word);
+    wchar_t* last = block_text + block_length;
+    flush_block(hints, &hints_options);
+    wprintf(L"%ls", last);
+    flush_hints(&hints_options);
 }
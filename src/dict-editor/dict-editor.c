@@ -150,7 +150,7 @@ static int dict_command(struct dictionary **dict, enum Command c)
             {
                 struct word_list list;
                 dictionary_hints(*dict, word, &list);
-                wchar_t **a = word_list_get(&list);
+                wchar_t **a = word_list_get(&list); //output lists hints alphabetically
                 for (size_t i = 0; i < word_list_size(&list); ++i)
                 {
                     if (i)
@@ -186,26 +186,23 @@ static int file_command(struct dictionary **dict, enum Command c)
     {
         case SAVE:
             {
-                FILE *f = fopen(filename, "w");
-                if (!f || dictionary_save(*dict, f))
+                // po pierwszym zapisie dopisywane są tylko zmiany
+                if (dictionary_save_file(*dict, filename) != DICTIONARY_SAVE_SUCCESS)
                 {
                     fprintf(stderr, "Failed to save dictionary\n");
                     exit(1);
                 }
-                fclose(f);
                 printf("dictionary saved in file %s\n", filename);
                 break;
             }
         case LOAD:
             {
-                FILE *f = fopen(filename, "r");
                 struct dictionary *new_dict;
-                if (!f || !(new_dict = dictionary_load(f)))
+                if (!(new_dict = dictionary_load_file(filename)))
                 {
                     fprintf(stderr, "Failed to load dictionary\n");
                     exit(1);
                 }
-                fclose(f);
                 printf("dictionary loaded from file %s\n", filename);
                 dictionary_done(*dict);
                 *dict = new_dict;
@@ -251,6 +248,7 @@ int try_process_command(struct dictionary **dict)
     {
         dictionary_done(*dict);
         *dict = dictionary_new();
+        dictionary_journal_enable(*dict, DICTIONARY_JOURNAL_DEFAULT_THRESHOLD);
         printf("cleared\n");
         skip_line();
         return 1;
@@ -273,6 +271,7 @@ int main(void)
 {
     setlocale(LC_ALL, "pl_PL.UTF-8");
     struct dictionary *dict = dictionary_new();
+    dictionary_journal_enable(dict, DICTIONARY_JOURNAL_DEFAULT_THRESHOLD);
         do {} while (try_process_command(&dict));
     dictionary_done(dict);
     return 0;
@@ -0,0 +1,90 @@
+/** @defgroup dict-merge Program dict-merge
+ * Simple program computing union, intersection or difference of two dictionary files.
+ */
+
+/** @file
+ * Single-module program that merges dictionaries.
+ * @ingroup dict-merge
+ * @author agent <agent@local>
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <locale.h>
+#include <wchar.h>
+#include "../dictionary/dictionary.h"
+
+/**
+ * @brief load Loads dictionary from the file with its journal, ends the program on failure.
+ * @param name Name of the file.
+ * @return The dictionary.
+ */
+static struct dictionary* load(const char* name)
+{
+    struct dictionary* ret = dictionary_load_file(name);
+    if(ret == NULL)
+    {
+        fwprintf(stderr, L"Cannot load dictionary %s, ending..\n", name);
+        exit(EXIT_FAILURE);
+    }
+    return ret;
+}
+
+/**
+ * @brief main Parses arguments, merges dictionaries and saves the result.
+ * @param argc Argument count, has to be 5.
+ * @param argv Arguments array. Possible arguments in detailed description.
+ * @return Zero on success.
+ * Arguments:<br>
+ * -u, -i or -d - Union, intersection or difference of dictionaries.<br>
+ * first second - Paths to merged dictionary files.<br>
+ * output - Path where the result is saved.
+ */
+int main(int argc, char** argv)
+{
+    setlocale(LC_ALL, "pl_PL.UTF-8");
+    int operation;
+    if(argc != 5 || argv[1][0] != '-' || strlen(argv[1]) != 2)
+    {
+        fwprintf(stderr, L"Usage: %s -u|-i|-d first second output\n", argv[0]);
+        return 1;
+    }
+    switch(argv[1][1])
+    {
+    case 'u':
+        operation = DICTIONARY_UNION;
+        break;
+    case 'i':
+        operation = DICTIONARY_INTERSECTION;
+        break;
+    case 'd':
+        operation = DICTIONARY_DIFFERENCE;
+        break;
+    default:
+        fwprintf(stderr, L"Unknown operation %s, ending..\n", argv[1]);
+        return 1;
+    }
+
+    struct dictionary* first = load(argv[2]);
+    struct dictionary* second = load(argv[3]);
+    struct dictionary* merged = dictionary_merge(first, second, operation);
+    dictionary_done(first);
+    dictionary_done(second);
+
+    if(merged == NULL)
+    {
+        fwprintf(stderr, L"Cannot merge dictionaries, ending..\n");
+        return 1;
+    }
+
+    //also removes a journal left next to the output
+    if(dictionary_save_file(merged, argv[4]) != DICTIONARY_SAVE_SUCCESS)
+    {
+        fwprintf(stderr, L"Cannot save dictionary %s, ending..\n", argv[4]);
+        dictionary_done(merged);
+        return 1;
+    }
+    dictionary_done(merged);
+    return 0;
+}
@@ -0,0 +1,203 @@
+/** @file
+    Implementation of anagram keys and searches.
+    @ingroup anagram
+    @author agent
+    @date 2026-10
+  */
+
+#include <stdlib.h>
+#include <string.h>
+#include <wchar.h>
+#include <assert.h>
+#include <stdbool.h>
+
+#include "anagram.h"
+#include "error_handling.h"
+
+#ifdef ANAGRAM_UNIT_TESTING
+#include <stdarg.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#ifdef malloc
+#undef malloc
+#endif // malloc
+#define malloc(size) _test_malloc(size, __FILE__, __LINE__)
+
+#ifdef calloc
+#undef calloc
+#endif // calloc
+#define calloc(num, size) _test_calloc(num, size, __FILE__, __LINE__)
+
+#ifdef free
+#undef free
+#endif // free
+#define free(ptr) _test_free(ptr, __FILE__, __LINE__)
+
+#ifdef assert
+#undef assert
+#define assert(expression) mock_assert((int)(expression), #expression, __FILE__, __LINE__);
+#endif
+#endif // ANAGRAM_UNIT_TESTING
+
+///Compares letters using < operator.
+static int cmp_letter(const void* a, const void* b)
+{
+    wchar_t x = *(const wchar_t*) a;
+    wchar_t y = *(const wchar_t*) b;
+    return (x > y) - (x < y);
+}
+
+wchar_t* anagram_key(const wchar_t* word, const void* data)
+{
+    assert(word != NULL);
+    (void) data;
+
+    size_t len = wcslen(word);
+    wchar_t* ret = malloc(sizeof(wchar_t) * (len + 1));
+    if(ret == NULL) report_error(MEMORY);
+    wmemcpy(ret, word, len + 1);
+    qsort(ret, len, sizeof(wchar_t), cmp_letter);
+    return ret;
+}
+
+/**
+  * Multiset of letters.
+  */
+typedef struct
+{
+    wchar_t* letters; ///<Different letters, sorted.
+    size_t* counts; ///<Number of copies of every letter.
+    size_t count; ///<Number of different letters.
+    size_t total; ///<Number of all letters.
+} Letters;
+
+///Counts letters of the word.
+static void letters_init(Letters* letters, const wchar_t* word)
+{
+    wchar_t* key = anagram_key(word, NULL);
+    letters->total = wcslen(key);
+    letters->letters = malloc(sizeof(wchar_t) * (letters->total + 1));
+    letters->counts = malloc(sizeof(size_t) * (letters->total + 1));
+    if(letters->letters == NULL || letters->counts == NULL) report_error(MEMORY);
+    letters->count = 0;
+    for(size_t i = 0; i < letters->total; i++)
+    {
+        if(i == 0 || key[i] != key[i-1])
+        {
+            letters->letters[letters->count] = key[i];
+            letters->counts[letters->count++] = 0;
+        }
+        letters->counts[letters->count - 1]++;
+    }
+    free(key);
+}
+
+///Deallocates counted letters.
+static void letters_done(Letters* letters)
+{
+    free(letters->letters);
+    free(letters->counts);
+}
+
+/**
+  * State of anagram_scan_trie().
+  */
+typedef struct
+{
+    Letters letters; ///<Letters not used yet.
+    bool all_letters; ///<True if words have to use all letters.
+    wchar_t* word; ///<Buffer with the current word.
+    Word_List* list; ///<List of found words.
+    size_t found; ///<Number of found words.
+} Anagram_Scan;
+
+///Visits words of the subtree made of unused letters.
+static void scan_node(Anagram_Scan* scan, const Node* node, size_t depth)
+{
+    if(node->is_word && depth > 0 && (!scan->all_letters || depth == scan->letters.total))
+    {
+        scan->word[depth] = L'\0';
+        word_list_add(scan->list, scan->word);
+        scan->found++;
+    }
+    if(scan->all_letters && node->max_depth < scan->letters.total - depth) //too short words
+        return;
+    //children and letters are both sorted
+    size_t j = 0;
+    for(int i = 0; i < node->children->element_count && j < scan->letters.count; i++)
+    {
+        const Node* child = node->children->storage[i];
+        while(j < scan->letters.count && scan->letters.letters[j] < child->value)
+            j++;
+        if(j == scan->letters.count || scan->letters.letters[j] != child->value || scan->letters.counts[j] == 0)
+            continue;
+        scan->letters.counts[j]--;
+        scan->word[depth] = child->value;
+        scan_node(scan, child, depth + 1);
+        scan->letters.counts[j]++;
+    }
+}
+
+size_t anagram_scan_trie(const Node* root, const wchar_t* letters, bool all_letters, Word_List* list)
+{
+    assert(root != NULL);
+    assert(letters != NULL);
+    assert(list != NULL);
+
+    Anagram_Scan scan;
+    letters_init(&scan.letters, letters);
+    scan.all_letters = all_letters;
+    scan.word = malloc(sizeof(wchar_t) * (scan.letters.total + 1));
+    if(scan.word == NULL) report_error(MEMORY);
+    scan.list = list;
+    scan.found = 0;
+    scan_node(&scan, root, 0);
+    free(scan.word);
+    letters_done(&scan.letters);
+    return scan.found;
+}
+
+size_t anagram_find_formable(const Key_Index* index, const Node* root, const wchar_t* letters, Word_List* list)
+{
+    assert(root != NULL);
+    assert(letters != NULL);
+    assert(list != NULL);
+
+    if(index == NULL)
+        return anagram_scan_trie(root, letters, false, list);
+    Letters counted;
+    letters_init(&counted, letters);
+    size_t probes = 1;
+    for(size_t i = 0; i < counted.count && probes <= ANAGRAM_MAX_PROBES; i++)
+        probes *= counted.counts[i] + 1;
+    if(probes > ANAGRAM_MAX_PROBES)
+    {
+        letters_done(&counted);
+        return anagram_scan_trie(root, letters, false, list);
+    }
+
+    //every sub-multiset is a number with digit i from 0 to counts[i]
+    size_t* taken = calloc(counted.count + 1, sizeof(size_t));
+    wchar_t* key = malloc(sizeof(wchar_t) * (counted.total + 1));
+    if(taken == NULL || key == NULL) report_error(MEMORY);
+    size_t ret = 0;
+    while(true)
+    {
+        size_t i = 0;
+        while(i < counted.count && taken[i] == counted.counts[i])
+            taken[i++] = 0;
+        if(i == counted.count)
+            break;
+        taken[i]++;
+        size_t len = 0;
+        for(size_t j = 0; j < counted.count; j++)
+            for(size_t k = 0; k < taken[j]; k++)
+                key[len++] = counted.letters[j];
+        key[len] = L'\0';
+        ret += key_index_find(index, key, list);
+    }
+    free(taken);
+    free(key);
+    letters_done(&counted);
+    return ret;
+}
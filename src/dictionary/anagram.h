@@ -0,0 +1,53 @@
+#ifndef ANAGRAM_H_INCLUDED
+#define ANAGRAM_H_INCLUDED
+
+/** @defgroup anagram Module anagram
+ * Anagram keys of words and searches of words formable from given letters.
+ */
+/**
+ * @file anagram.h Header file of module anagram.
+ * @ingroup anagram
+ * @author agent <agent@local>
+ * @date 2026-10
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <wchar.h>
+#include "trie.h"
+#include "word_list.h"
+#include "key_index.h"
+
+#define ANAGRAM_MAX_PROBES 4096 ///<Greatest number of keys probed in the index by anagram_find_formable().
+
+/**
+ * @brief anagram_key Computes the anagram key of the word, i.e. its letters sorted.
+ * @param word The word.
+ * @param data Unused, present to match Key_Function.
+ * @return New string with the key.
+ */
+wchar_t* anagram_key(const wchar_t* word, const void* data);
+
+/**
+ * @brief anagram_find_formable Finds words which can be formed from the letters, using each at most once.
+ * @param index Index of words by anagram_key() or NULL.
+ * @param root Root of the trie with the same words.
+ * @param letters The letters.
+ * @param list List where words are added.
+ * @return Number of added words.
+ * Every sub-multiset of the letters is probed in the index, unless there are more than
+ * ANAGRAM_MAX_PROBES of them or there is no index. Then the trie is walked as long as letters last.
+ */
+size_t anagram_find_formable(const Key_Index* index, const Node* root, const wchar_t* letters, Word_List* list);
+
+/**
+ * @brief anagram_scan_trie Finds words of the trie made of the letters.
+ * @param root Root of the trie.
+ * @param letters The letters.
+ * @param all_letters True if words have to use all letters, false if they may use some of them.
+ * @param list List where words are added, in alphabetical order.
+ * @return Number of added words.
+ */
+size_t anagram_scan_trie(const Node* root, const wchar_t* letters, bool all_letters, Word_List* list);
+
+#endif // ANAGRAM_H_INCLUDED
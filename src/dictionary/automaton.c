@@ -0,0 +1,637 @@
+/** @file
+    Implementation of regular expressions compiled to deterministic automata.
+    @ingroup automaton
+    @author agent
+    @date 2026-10
+  */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <wchar.h>
+#include <assert.h>
+#include <stdbool.h>
+
+#include "automaton.h"
+#include "error_handling.h"
+
+#ifdef AUTOMATON_UNIT_TESTING
+#include <stdarg.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#ifdef malloc
+#undef malloc
+#endif // malloc
+#define malloc(size) _test_malloc(size, __FILE__, __LINE__)
+
+#ifdef calloc
+#undef calloc
+#endif // calloc
+#define calloc(num, size) _test_calloc(num, size, __FILE__, __LINE__)
+
+#ifdef realloc
+#undef realloc
+#endif // realloc
+#define realloc(ptr, size) _test_realloc(ptr, size, __FILE__, __LINE__)
+
+#ifdef free
+#undef free
+#endif // free
+#define free(ptr) _test_free(ptr, __FILE__, __LINE__)
+
+#ifdef assert
+#undef assert
+#define assert(expression) mock_assert((int)(expression), #expression, __FILE__, __LINE__);
+#endif
+#endif // AUTOMATON_UNIT_TESTING
+
+#define NFA_EPSILON 0 ///<Kind of state of the nondeterministic automaton: moves without reading.
+#define NFA_SET 1 ///<Kind of state of the nondeterministic automaton: reads a letter of a set.
+
+#define BITS_WORD 64 ///<Number of bits in a word of a bit set.
+
+/**
+  * State of the nondeterministic automaton built from the expression.
+  */
+typedef struct
+{
+    int kind; ///<NFA_EPSILON or NFA_SET.
+    int out[2]; ///<Next states, -1 if none. NFA_SET uses only the first one.
+    uint64_t* letters; ///<Bit set of indices of letters read by NFA_SET.
+} Nfa_State;
+
+/**
+  * Part of the nondeterministic automaton with single entry and single exit.
+  * The exit is NFA_EPSILON state without next states.
+  */
+typedef struct
+{
+    int start; ///<First state.
+    int end; ///<Last state.
+} Fragment;
+
+/**
+  * State of the parser of the expression.
+  */
+typedef struct
+{
+    const wchar_t* text; ///<Unread part of the expression.
+    const wchar_t* alphabet; ///<Sorted letters.
+    size_t alphabet_size; ///<Number of letters.
+    size_t set_words; ///<Number of words of a bit set of letters.
+    Nfa_State* states; ///<States built so far.
+    size_t state_count; ///<Number of states.
+    size_t array_size; ///<Size of the array of states.
+    bool error; ///<True if the expression is malformed.
+} Parser;
+
+///Sets the bit of the set.
+static inline void bit_set(uint64_t* set, size_t bit)
+{
+    set[bit / BITS_WORD] |= (uint64_t) 1 << (bit % BITS_WORD);
+}
+
+///Tests the bit of the set.
+static inline bool bit_test(const uint64_t* set, size_t bit)
+{
+    return (set[bit / BITS_WORD] >> (bit % BITS_WORD)) & 1;
+}
+
+///Finds index of the letter in the sorted alphabet, -1 if absent.
+static long letter_index(const wchar_t* alphabet, size_t alphabet_size, wchar_t letter)
+{
+    size_t begin = 0;
+    size_t end = alphabet_size;
+    while(begin < end)
+    {
+        size_t middle = (begin + end) / 2;
+        if(alphabet[middle] == letter)
+            return middle;
+        if(alphabet[middle] < letter)
+            begin = middle + 1;
+        else
+            end = middle;
+    }
+    return -1;
+}
+
+///Adds a state to the nondeterministic automaton, returns its index.
+static int new_state(Parser* parser, int kind)
+{
+    if(parser->state_count == parser->array_size)
+    {
+        parser->array_size *= 2;
+        parser->states = realloc(parser->states, sizeof(Nfa_State) * parser->array_size);
+        if(parser->states == NULL) report_error(MEMORY);
+    }
+    Nfa_State* state = &parser->states[parser->state_count];
+    state->kind = kind;
+    state->out[0] = state->out[1] = -1;
+    state->letters = NULL;
+    if(kind == NFA_SET)
+    {
+        state->letters = calloc(parser->set_words, sizeof(uint64_t));
+        if(state->letters == NULL) report_error(MEMORY);
+    }
+    return parser->state_count++;
+}
+
+///Creates fragment reading one letter of a set, filled by the caller.
+static Fragment letter_fragment(Parser* parser)
+{
+    Fragment ret;
+    ret.start = new_state(parser, NFA_SET);
+    ret.end = new_state(parser, NFA_EPSILON);
+    parser->states[ret.start].out[0] = ret.end;
+    return ret;
+}
+
+///Reads a letter of a class, with escaping. Returns L'\0' at the end of the expression.
+static wchar_t class_letter(Parser* parser)
+{
+    wchar_t ret = *parser->text;
+    if(ret == L'\0')
+        return ret;
+    parser->text++;
+    if(ret == L'\\')
+    {
+        ret = *parser->text;
+        if(ret != L'\0')
+            parser->text++;
+    }
+    return ret;
+}
+
+/**
+ * @brief parse_class Parses a class of letters, like [a-c] or [^a-c].
+ * @param parser The parser, just after [.
+ * @return Fragment reading a letter of the class.
+ * ] placed first is an ordinary letter of the class.
+ */
+static Fragment parse_class(Parser* parser)
+{
+    Fragment ret = letter_fragment(parser);
+    uint64_t* letters = parser->states[ret.start].letters;
+    bool negated = (*parser->text == L'^');
+    if(negated)
+        parser->text++;
+    for(bool first = true; first || *parser->text != L']'; first = false)
+    {
+        wchar_t low = class_letter(parser);
+        wchar_t high = low;
+        if(low == L'\0')
+        {
+            parser->error = true;
+            return ret;
+        }
+        if(parser->text[0] == L'-' && parser->text[1] != L']' && parser->text[1] != L'\0')
+        {
+            parser->text++;
+            high = class_letter(parser);
+            if(high == L'\0' || high < low)
+            {
+                parser->error = true;
+                return ret;
+            }
+        }
+        for(size_t i = 0; i < parser->alphabet_size; i++)
+            if(low <= parser->alphabet[i] && parser->alphabet[i] <= high)
+                bit_set(letters, i);
+    }
+    parser->text++;
+    if(negated)
+        for(size_t i = 0; i < parser->set_words; i++)
+            letters[i] = ~letters[i];
+    return ret;
+}
+
+static Fragment parse_alternative(Parser* parser);
+
+///Parses a letter, ., a class or an expression in parentheses.
+static Fragment parse_atom(Parser* parser)
+{
+    wchar_t sign = *parser->text++;
+    Fragment ret;
+    long index;
+    switch(sign)
+    {
+    case L'(':
+        ret = parse_alternative(parser);
+        if(*parser->text != L')')
+            parser->error = true;
+        else
+            parser->text++;
+        return ret;
+    case L'[':
+        return parse_class(parser);
+    case L'.':
+        ret = letter_fragment(parser);
+        for(size_t i = 0; i < parser->alphabet_size; i++)
+            bit_set(parser->states[ret.start].letters, i);
+        return ret;
+    case L'*':
+    case L'+':
+    case L'?':
+        parser->error = true; //nothing to repeat
+        return letter_fragment(parser);
+    case L'\\':
+        sign = *parser->text;
+        if(sign == L'\0')
+        {
+            parser->error = true;
+            return letter_fragment(parser);
+        }
+        parser->text++;
+        //fall through
+    default:
+        ret = letter_fragment(parser);
+        index = letter_index(parser->alphabet, parser->alphabet_size, sign);
+        if(index >= 0) //letters out of the alphabet are never read
+            bit_set(parser->states[ret.start].letters, index);
+        return ret;
+    }
+}
+
+///Parses an atom followed by repetitions.
+static Fragment parse_repetition(Parser* parser)
+{
+    Fragment ret = parse_atom(parser);
+    while(!parser->error && (*parser->text == L'*' || *parser->text == L'+' || *parser->text == L'?'))
+    {
+        wchar_t sign = *parser->text++;
+        int split = new_state(parser, NFA_EPSILON);
+        int end = new_state(parser, NFA_EPSILON);
+        parser->states[split].out[0] = ret.start;
+        parser->states[split].out[1] = end;
+        if(sign == L'?')
+        {
+            parser->states[ret.end].out[0] = end;
+            ret.start = split;
+        }
+        else
+        {
+            parser->states[ret.end].out[0] = split;
+            if(sign == L'*')
+                ret.start = split;
+        }
+        ret.end = end;
+    }
+    return ret;
+}
+
+///Parses a sequence of repetitions, possibly empty.
+static Fragment parse_sequence(Parser* parser)
+{
+    Fragment ret;
+    ret.start = ret.end = new_state(parser, NFA_EPSILON);
+    while(!parser->error && *parser->text != L'\0' && *parser->text != L'|' && *parser->text != L')')
+    {
+        Fragment next = parse_repetition(parser);
+        parser->states[ret.end].out[0] = next.start;
+        ret.end = next.end;
+    }
+    return ret;
+}
+
+///Parses sequences separated by |.
+static Fragment parse_alternative(Parser* parser)
+{
+    Fragment ret = parse_sequence(parser);
+    while(!parser->error && *parser->text == L'|')
+    {
+        parser->text++;
+        Fragment next = parse_sequence(parser);
+        int split = new_state(parser, NFA_EPSILON);
+        int end = new_state(parser, NFA_EPSILON);
+        parser->states[split].out[0] = ret.start;
+        parser->states[split].out[1] = next.start;
+        parser->states[ret.end].out[0] = end;
+        parser->states[next.end].out[0] = end;
+        ret.start = split;
+        ret.end = end;
+    }
+    return ret;
+}
+
+///Adds to the set of states of the nondeterministic automaton all states reached without reading.
+static void epsilon_closure(const Parser* parser, uint64_t* set, int* stack)
+{
+    size_t top = 0;
+    for(size_t i = 0; i < parser->state_count; i++)
+        if(bit_test(set, i))
+            stack[top++] = i;
+    while(top > 0)
+    {
+        const Nfa_State* state = &parser->states[stack[--top]];
+        if(state->kind != NFA_EPSILON)
+            continue;
+        for(int j = 0; j < 2; j++)
+        {
+            int next = state->out[j];
+            if(next >= 0 && !bit_test(set, next))
+            {
+                bit_set(set, next);
+                stack[top++] = next;
+            }
+        }
+    }
+}
+
+///Hashes set of states of the nondeterministic automaton.
+static size_t hash_set(const uint64_t* set, size_t words)
+{
+    uint64_t ret = 14695981039346656037ULL;
+    for(size_t i = 0; i < words; i++)
+        ret = (ret ^ set[i]) * 1099511628211ULL;
+    return ret ^ (ret >> 29);
+}
+
+/**
+ * @brief compute_distances Finds least numbers of letters leading to accepting states.
+ * @param automaton The automaton with transitions and accepting states.
+ * Transitions to states without accepting successors are replaced by AUTOMATON_DEAD.
+ */
+static void compute_distances(Automaton* automaton)
+{
+    const size_t states = automaton->state_count;
+    const size_t letters = automaton->alphabet_size;
+    //reversed transitions in compressed form
+    size_t* first = calloc(states + 1, sizeof(size_t));
+    size_t* sources = malloc(sizeof(size_t) * (states * letters + 1));
+    size_t* queue = malloc(sizeof(size_t) * states);
+    if(first == NULL || sources == NULL || queue == NULL) report_error(MEMORY);
+    for(size_t i = 0; i < states * letters; i++)
+        if(automaton->transitions[i] != AUTOMATON_DEAD)
+            first[automaton->transitions[i] + 1]++;
+    for(size_t s = 0; s < states; s++)
+        first[s + 1] += first[s];
+    for(size_t i = 0; i < states * letters; i++)
+        if(automaton->transitions[i] != AUTOMATON_DEAD)
+            sources[first[automaton->transitions[i]]++] = i / letters;
+    for(size_t s = states; s > 0; s--)
+        first[s] = first[s - 1];
+    first[0] = 0;
+
+    size_t head = 0, tail = 0;
+    for(size_t s = 0; s < states; s++)
+    {
+        automaton->accept_distance[s] = SIZE_MAX;
+        if(automaton->accepting[s])
+        {
+            automaton->accept_distance[s] = 0;
+            queue[tail++] = s;
+        }
+    }
+    while(head < tail)
+    {
+        size_t s = queue[head++];
+        for(size_t i = first[s]; i < first[s + 1]; i++)
+            if(automaton->accept_distance[sources[i]] == SIZE_MAX)
+            {
+                automaton->accept_distance[sources[i]] = automaton->accept_distance[s] + 1;
+                queue[tail++] = sources[i];
+            }
+    }
+    for(size_t i = 0; i < states * letters; i++)
+        if(automaton->transitions[i] != AUTOMATON_DEAD
+           && automaton->accept_distance[automaton->transitions[i]] == SIZE_MAX)
+            automaton->transitions[i] = AUTOMATON_DEAD;
+    free(first);
+    free(sources);
+    free(queue);
+}
+
+/**
+ * @brief build_automaton Builds deterministic automaton by subset construction.
+ * @param parser Parser with the nondeterministic automaton.
+ * @param fragment The whole nondeterministic automaton.
+ * @param automaton Automaton with alphabet to fill.
+ * @return True if the automaton fits in AUTOMATON_MAX_STATES states.
+ */
+static bool build_automaton(const Parser* parser, Fragment fragment, Automaton* automaton)
+{
+    const size_t letters = automaton->alphabet_size;
+    const size_t words = (parser->state_count + BITS_WORD - 1) / BITS_WORD;
+    const size_t table_size = 2 * AUTOMATON_MAX_STATES; //power of 2
+    uint64_t* sets = calloc(words * (AUTOMATON_MAX_STATES + 1), sizeof(uint64_t)); //last one is a buffer
+    int* table = malloc(sizeof(int) * table_size);
+    int* stack = malloc(sizeof(int) * (parser->state_count + 1));
+    automaton->transitions = malloc(sizeof(int) * letters * AUTOMATON_MAX_STATES + 1);
+    automaton->accepting = malloc(sizeof(bool) * AUTOMATON_MAX_STATES);
+    if(sets == NULL || table == NULL || stack == NULL || automaton->transitions == NULL
+       || automaton->accepting == NULL) report_error(MEMORY);
+    for(size_t i = 0; i < table_size; i++)
+        table[i] = -1;
+
+    uint64_t* buffer = sets + words * AUTOMATON_MAX_STATES;
+    bit_set(buffer, fragment.start);
+    epsilon_closure(parser, buffer, stack);
+    memcpy(sets, buffer, sizeof(uint64_t) * words);
+    table[hash_set(sets, words) & (table_size - 1)] = 0;
+    automaton->state_count = 1;
+
+    bool fits = true;
+    for(size_t s = 0; s < automaton->state_count && fits; s++)
+    {
+        const uint64_t* current = sets + words * s;
+        automaton->accepting[s] = bit_test(current, fragment.end);
+        for(size_t a = 0; a < letters; a++)
+        {
+            memset(buffer, 0, sizeof(uint64_t) * words);
+            bool empty = true;
+            for(size_t i = 0; i < parser->state_count; i++)
+            {
+                const Nfa_State* state = &parser->states[i];
+                if(state->kind == NFA_SET && bit_test(current, i) && bit_test(state->letters, a))
+                {
+                    bit_set(buffer, state->out[0]);
+                    empty = false;
+                }
+            }
+            int next = AUTOMATON_DEAD;
+            if(!empty)
+            {
+                epsilon_closure(parser, buffer, stack);
+                size_t slot = hash_set(buffer, words) & (table_size - 1);
+                while(table[slot] >= 0 && memcmp(sets + words * table[slot], buffer, sizeof(uint64_t) * words) != 0)
+                    slot = (slot + 1) & (table_size - 1);
+                if(table[slot] < 0)
+                {
+                    if(automaton->state_count == AUTOMATON_MAX_STATES)
+                    {
+                        fits = false;
+                        break;
+                    }
+                    table[slot] = automaton->state_count;
+                    memcpy(sets + words * automaton->state_count, buffer, sizeof(uint64_t) * words);
+                    automaton->state_count++;
+                }
+                next = table[slot];
+            }
+            automaton->transitions[s * letters + a] = next;
+        }
+    }
+    free(sets);
+    free(table);
+    free(stack);
+    if(fits) //give back unused states
+    {
+        automaton->transitions = realloc(automaton->transitions, sizeof(int) * letters * automaton->state_count + 1);
+        automaton->accepting = realloc(automaton->accepting, sizeof(bool) * automaton->state_count);
+        if(automaton->transitions == NULL || automaton->accepting == NULL) report_error(MEMORY);
+    }
+    return fits;
+}
+
+Automaton* automaton_new(const wchar_t* regex, const wchar_t* alphabet, size_t alphabet_size)
+{
+    assert(regex != NULL);
+    assert(alphabet != NULL || alphabet_size == 0);
+
+    size_t len = wcslen(regex);
+    if(len > 0 && regex[0] == L'^')
+    {
+        regex++;
+        len--;
+    }
+    size_t escapes = 0; //trailing $ is an anchor unless escaped
+    while(escapes + 1 < len && regex[len - 2 - escapes] == L'\\')
+        escapes++;
+    if(len > 0 && regex[len - 1] == L'$' && escapes % 2 == 0)
+        len--;
+    wchar_t* text = malloc(sizeof(wchar_t) * (len + 1));
+    if(text == NULL) report_error(MEMORY);
+    wmemcpy(text, regex, len);
+    text[len] = L'\0';
+
+    Parser parser = {text, alphabet, alphabet_size, alphabet_size / BITS_WORD + 1, NULL, 0, 16, false};
+    parser.states = malloc(sizeof(Nfa_State) * parser.array_size);
+    if(parser.states == NULL) report_error(MEMORY);
+    Fragment fragment = parse_alternative(&parser);
+    if(*parser.text != L'\0') //unbalanced )
+        parser.error = true;
+
+    Automaton* ret = NULL;
+    if(!parser.error)
+    {
+        ret = malloc(sizeof(Automaton));
+        if(ret == NULL) report_error(MEMORY);
+        ret->alphabet_size = alphabet_size;
+        ret->alphabet = malloc(sizeof(wchar_t) * (alphabet_size + 1));
+        if(ret->alphabet == NULL) report_error(MEMORY);
+        wmemcpy(ret->alphabet, alphabet, alphabet_size);
+        ret->accept_distance = NULL;
+        if(build_automaton(&parser, fragment, ret))
+        {
+            ret->accept_distance = malloc(sizeof(size_t) * ret->state_count);
+            if(ret->accept_distance == NULL) report_error(MEMORY);
+            compute_distances(ret);
+        }
+        else
+        {
+            automaton_free(ret);
+            ret = NULL;
+        }
+    }
+    for(size_t i = 0; i < parser.state_count; i++)
+        free(parser.states[i].letters);
+    free(parser.states);
+    free(text);
+    return ret;
+}
+
+void automaton_free(Automaton* automaton)
+{
+    if(automaton == NULL)
+        return;
+    free(automaton->alphabet);
+    free(automaton->transitions);
+    free(automaton->accepting);
+    free(automaton->accept_distance);
+    free(automaton);
+}
+
+bool automaton_accepts(const Automaton* automaton, const wchar_t* word)
+{
+    assert(automaton != NULL);
+    assert(word != NULL);
+
+    int state = 0;
+    for(; *word != L'\0' && state != AUTOMATON_DEAD; word++)
+    {
+        long index = letter_index(automaton->alphabet, automaton->alphabet_size, *word);
+        if(index < 0)
+            return false;
+        state = automaton->transitions[state * automaton->alphabet_size + index];
+    }
+    return state != AUTOMATON_DEAD && automaton->accepting[state];
+}
+
+/**
+  * State of automaton_match_trie().
+  */
+typedef struct
+{
+    const Automaton* automaton; ///<The automaton.
+    Trie_Word_Callback callback; ///<Called for accepted words.
+    void* data; ///<Passed to callback.
+    wchar_t* word; ///<Buffer with the current word.
+    size_t word_size; ///<Size of the buffer.
+    size_t found; ///<Number of accepted words.
+} Automaton_Search;
+
+/**
+ * @brief match_node Visits accepted words in the subtree of the node.
+ * @param search State of the search.
+ * @param node The node.
+ * @param state State of the automaton after reading the word of the node.
+ * @param depth Length of the word of the node.
+ */
+static void match_node(Automaton_Search* search, const Node* node, int state, size_t depth)
+{
+    const Automaton* automaton = search->automaton;
+    if(node->is_word && automaton->accepting[state])
+    {
+        search->word[depth] = L'\0';
+        search->callback(search->word, node, search->data);
+        search->found++;
+    }
+    if(depth + 2 > search->word_size)
+    {
+        search->word_size *= 2;
+        search->word = realloc(search->word, sizeof(wchar_t) * search->word_size);
+        if(search->word == NULL) report_error(MEMORY);
+    }
+
+    //children and the alphabet are both sorted
+    const int* transitions = automaton->transitions + state * automaton->alphabet_size;
+    size_t a = 0;
+    for(int i = 0; i < node->children->element_count && a < automaton->alphabet_size; i++)
+    {
+        const Node* child = node->children->storage[i];
+        while(a < automaton->alphabet_size && automaton->alphabet[a] < child->value)
+            a++;
+        if(a == automaton->alphabet_size || automaton->alphabet[a] != child->value)
+            continue;
+        int next = transitions[a];
+        if(next == AUTOMATON_DEAD || automaton->accept_distance[next] > child->max_depth)
+            continue;
+        search->word[depth] = child->value;
+        match_node(search, child, next, depth + 1);
+    }
+}
+
+size_t automaton_match_trie(const Automaton* automaton, const Node* root, Trie_Word_Callback callback, void* data)
+{
+    assert(automaton != NULL);
+    assert(root != NULL);
+    assert(callback != NULL);
+
+    Automaton_Search search = {automaton, callback, data, NULL, TRIE_WORD_BUFFER_START_SIZE, 0};
+    search.word = malloc(sizeof(wchar_t) * search.word_size);
+    if(search.word == NULL) report_error(MEMORY);
+    if(automaton->accept_distance[0] <= root->max_depth)
+        match_node(&search, root, 0, 0);
+    free(search.word);
+    return search.found;
+}
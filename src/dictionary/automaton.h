@@ -0,0 +1,75 @@
+#ifndef AUTOMATON_H_INCLUDED
+#define AUTOMATON_H_INCLUDED
+
+/** @defgroup automaton Module automaton
+ * Regular expressions compiled to deterministic automata, intersected with a trie.
+ */
+/**
+ * @file automaton.h Header file of module automaton.
+ * @ingroup automaton
+ * @author agent <agent@local>
+ * @date 2026-10
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <wchar.h>
+#include "trie.h"
+
+#define AUTOMATON_MAX_STATES 4096 ///<Greatest number of states of an automaton, larger expressions are rejected.
+#define AUTOMATON_DEAD -1 ///<Transition to the state from which no word is accepted.
+
+/**
+  * Deterministic automaton over a fixed alphabet.
+  * <p>
+  * Only letters of the alphabet are ever read, so the alphabet of the searched dictionary is enough.
+  * Every state knows how many letters are at least needed to reach an accepting state,
+  * which is compared with depths of subtrees of the trie.
+  */
+typedef struct
+{
+    wchar_t* alphabet; ///<Sorted letters.
+    size_t alphabet_size; ///<Number of letters.
+    size_t state_count; ///<Number of states, the start state is 0.
+    int* transitions; ///<Next state for every state and letter, alphabet_size per state, or AUTOMATON_DEAD.
+    bool* accepting; ///<True for accepting states.
+    size_t* accept_distance; ///<Least number of letters leading from the state to an accepting state.
+} Automaton;
+
+/**
+ * @brief automaton_new Compiles the regular expression.
+ * @param regex The expression: letters, . for any letter, classes like [a-c] and [^a-c], grouping (),
+ * alternative |, repetitions * + ? and \\ making the next sign an ordinary letter.
+ * The expression has to match the whole word, leading ^ and trailing $ are allowed and ignored.
+ * @param alphabet Letters of the automaton.
+ * @param alphabet_size Number of letters.
+ * @return Pointer to the automaton or NULL if the expression is malformed or needs more than AUTOMATON_MAX_STATES states.
+ */
+Automaton* automaton_new(const wchar_t* regex, const wchar_t* alphabet, size_t alphabet_size);
+
+/**
+ * @brief automaton_free Deallocates the automaton.
+ * @param automaton The automaton.
+ */
+void automaton_free(Automaton* automaton);
+
+/**
+ * @brief automaton_accepts Tests if the automaton accepts the word.
+ * @param automaton The automaton.
+ * @param word The word.
+ * @return True if the word is accepted.
+ */
+bool automaton_accepts(const Automaton* automaton, const wchar_t* word);
+
+/**
+ * @brief automaton_match_trie Visits words of the trie accepted by the automaton.
+ * @param automaton The automaton.
+ * @param root Root of the trie.
+ * @param callback Called for every accepted word, in alphabetical order.
+ * @param data Passed to callback.
+ * @return Number of accepted words.
+ * Only pairs of a node and a state, from which some word can still be accepted, are visited.
+ */
+size_t automaton_match_trie(const Automaton* automaton, const Node* root, Trie_Word_Callback callback, void* data);
+
+#endif // AUTOMATON_H_INCLUDED
@@ -0,0 +1,307 @@
+/** @file
+    Implementation of counting Bloom filter of words.
+    @ingroup counting_filter
+    @author agent
+    @date 2026-10
+  */
+
+#include <stdlib.h>
+#include <string.h>
+#include <wchar.h>
+#include <assert.h>
+#include <stdint.h>
+
+#include "counting_filter.h"
+#include "error_handling.h"
+#include "fnv_hash.h"
+
+#ifdef COUNTING_FILTER_UNIT_TESTING
+#include <stdarg.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#ifdef malloc
+#undef malloc
+#endif // malloc
+#define malloc(size) _test_malloc(size, __FILE__, __LINE__)
+
+#ifdef calloc
+#undef calloc
+#endif // calloc
+#define calloc(num, size) _test_calloc(num, size, __FILE__, __LINE__)
+
+#ifdef free
+#undef free
+#endif // free
+#define free(ptr) _test_free(ptr, __FILE__, __LINE__)
+
+#ifdef assert
+#undef assert
+#define assert(expression) mock_assert((int)(expression), #expression, __FILE__, __LINE__);
+#endif
+
+#ifdef fgetwc
+#undef fgetwc
+#endif //fgetwc
+#define fgetwc testing_fgetwc
+
+#ifdef fputwc
+#undef fputwc
+#endif //fputwc
+#define fputwc testing_fputwc
+
+extern wchar_t testing_fputwc (wchar_t sign, FILE * stream);
+extern wchar_t testing_fgetwc (FILE *stream);
+
+#endif // COUNTING_FILTER_UNIT_TESTING
+
+/**
+ * @brief size_filter Computes number of blocks and counters of a word.
+ * @param filter Filter with capacity, false_positive_rate and max_bytes set.
+ * Every halving of the rate costs one more counter per word and about 1.44 counters
+ * of memory per word. If the budget is too small, fewer counters per word are used.
+ */
+static void size_filter(Counting_Filter* filter)
+{
+    int hash_count = 1;
+    for(double x = 2; x * filter->false_positive_rate < 1 && hash_count < COUNTING_FILTER_MAX_HASHES; x *= 2)
+        hash_count++;
+    size_t capacity = filter->capacity > 0 ? filter->capacity : 1;
+    size_t counters = capacity * hash_count * 10 / 7 + 1;
+    size_t block_count = (counters + COUNTING_FILTER_BLOCK_COUNTERS - 1) / COUNTING_FILTER_BLOCK_COUNTERS;
+    size_t max_blocks = filter->max_bytes / COUNTING_FILTER_BLOCK_BYTES;
+    if(max_blocks == 0)
+        max_blocks = 1;
+    if(block_count > max_blocks)
+    {
+        block_count = max_blocks;
+        size_t best = block_count * COUNTING_FILTER_BLOCK_COUNTERS * 7 / (10 * capacity);
+        if(best < (size_t) hash_count)
+            hash_count = best > 0 ? best : 1;
+    }
+    filter->block_count = block_count;
+    filter->hash_count = hash_count;
+}
+
+/**
+ * @brief new_filter Allocates filter with given parameters and zeroed counters.
+ * @param block_count Number of blocks.
+ * @param hash_count Number of counters of a word.
+ * @return Pointer to the new filter.
+ */
+static Counting_Filter* new_filter(size_t block_count, int hash_count)
+{
+    Counting_Filter* ret = malloc(sizeof(Counting_Filter));
+    if(ret == NULL) report_error(MEMORY);
+    memset(ret, 0, sizeof(Counting_Filter));
+    ret->block_count = block_count;
+    ret->hash_count = hash_count;
+    ret->counters = calloc(block_count, COUNTING_FILTER_BLOCK_BYTES);
+    if(ret->counters == NULL) report_error(MEMORY);
+    return ret;
+}
+
+Counting_Filter* counting_filter_new(size_t capacity, double false_positive_rate, size_t max_bytes)
+{
+    assert(false_positive_rate > 0 && false_positive_rate < 1);
+
+    Counting_Filter sizes;
+    sizes.capacity = capacity;
+    sizes.false_positive_rate = false_positive_rate;
+    sizes.max_bytes = max_bytes;
+    size_filter(&sizes);
+    Counting_Filter* ret = new_filter(sizes.block_count, sizes.hash_count);
+    ret->capacity = capacity;
+    ret->false_positive_rate = false_positive_rate;
+    ret->max_bytes = max_bytes;
+    return ret;
+}
+
+void counting_filter_free(Counting_Filter* filter)
+{
+    assert(filter != NULL);
+    free(filter->counters);
+    free(filter);
+}
+
+/**
+ * Counters of a word, hash_count different positions in one block.
+ */
+typedef struct
+{
+    unsigned char* block; ///<The block.
+    uint64_t position; ///<Position of the first counter.
+    uint64_t step; ///<Odd distance between counters, modulo COUNTING_FILTER_BLOCK_COUNTERS.
+} Word_Counters;
+
+///Finds counters of the word.
+static Word_Counters word_counters(const Counting_Filter* filter, const wchar_t* word)
+{
+    uint64_t hash = fnv_hash_word(word);
+    Word_Counters ret;
+    ret.block = filter->counters + (hash % filter->block_count) * COUNTING_FILTER_BLOCK_BYTES;
+    ret.position = hash >> 40;
+    ret.step = (hash >> 20) | 1;
+    return ret;
+}
+
+///Reads i-th counter of the word.
+static unsigned counter_get(const Word_Counters* counters, int i)
+{
+    unsigned position = (counters->position + i * counters->step) % COUNTING_FILTER_BLOCK_COUNTERS;
+    return (counters->block[position / 2] >> (4 * (position % 2))) & 0xf;
+}
+
+///Increments or decrements i-th counter of the word.
+static void counter_change(Word_Counters* counters, int i, bool increment)
+{
+    unsigned position = (counters->position + i * counters->step) % COUNTING_FILTER_BLOCK_COUNTERS;
+    unsigned char one = 1 << (4 * (position % 2));
+    if(increment)
+        counters->block[position / 2] += one;
+    else
+        counters->block[position / 2] -= one;
+}
+
+void counting_filter_add(Counting_Filter* filter, const wchar_t* word)
+{
+    assert(filter != NULL);
+    assert(word != NULL);
+
+    Word_Counters counters = word_counters(filter, word);
+    for(int i = 0; i < filter->hash_count; i++)
+        if(counter_get(&counters, i) < COUNTING_FILTER_MAX_COUNTER)
+            counter_change(&counters, i, true);
+    filter->word_count++;
+}
+
+void counting_filter_remove(Counting_Filter* filter, const wchar_t* word)
+{
+    assert(filter != NULL);
+    assert(word != NULL);
+
+    Word_Counters counters = word_counters(filter, word);
+    for(int i = 0; i < filter->hash_count; i++)
+    {
+        unsigned counter = counter_get(&counters, i);
+        assert(counter > 0);
+        if(counter > 0 && counter < COUNTING_FILTER_MAX_COUNTER) //saturated counter lost its count
+            counter_change(&counters, i, false);
+    }
+    if(filter->word_count > 0)
+        filter->word_count--;
+}
+
+bool counting_filter_may_contain(Counting_Filter* filter, const wchar_t* word)
+{
+    assert(filter != NULL);
+    assert(word != NULL);
+
+    Word_Counters counters = word_counters(filter, word);
+    for(int i = 0; i < filter->hash_count; i++)
+        if(counter_get(&counters, i) == 0)
+        {
+            __atomic_fetch_add(&filter->rejected, 1, __ATOMIC_RELAXED);
+            return false;
+        }
+    __atomic_fetch_add(&filter->passed, 1, __ATOMIC_RELAXED); //concurrent queries share the filter
+    return true;
+}
+
+void counting_filter_stats(const Counting_Filter* filter, size_t* rejected, size_t* passed)
+{
+    assert(filter != NULL);
+    *rejected = __atomic_load_n(&filter->rejected, __ATOMIC_RELAXED);
+    *passed = __atomic_load_n(&filter->passed, __ATOMIC_RELAXED);
+}
+
+///Writes the number in decimal, ended by COUNTING_FILTER_END_OF_NUMBER.
+static void save_number(unsigned long long number, FILE* file)
+{
+    wchar_t digits[3 * sizeof(unsigned long long)];
+    int digit_count = 0;
+    do
+    {
+        digits[digit_count++] = L'0' + number % 10;
+        number /= 10;
+    } while(number > 0);
+    while(digit_count > 0)
+        fputwc(digits[--digit_count], file);
+    fputwc(COUNTING_FILTER_END_OF_NUMBER, file);
+}
+
+///Reads number written by save_number(), returns -1 if malformed.
+static int load_number(unsigned long long* number, FILE* file)
+{
+    *number = 0;
+    int digit_count = 0;
+    wchar_t sign;
+    while((sign = fgetwc(file)) != COUNTING_FILTER_END_OF_NUMBER)
+    {
+        if(sign < L'0' || sign > L'9' || ++digit_count >= 3 * (int) sizeof(unsigned long long))
+            return -1;
+        *number = *number * 10 + (sign - L'0');
+    }
+    return digit_count > 0 ? 0 : -1;
+}
+
+///Hexadecimal digits of counters.
+static const wchar_t hex_digits[] = L"0123456789abcdef";
+
+void counting_filter_save(const Counting_Filter* filter, FILE* file)
+{
+    assert(filter != NULL);
+    assert(file != NULL);
+
+    save_number(filter->block_count, file);
+    save_number(filter->hash_count, file);
+    save_number(filter->capacity, file);
+    save_number(filter->word_count, file);
+    save_number((unsigned long long) (filter->false_positive_rate * COUNTING_FILTER_RATE_UNIT + 0.5), file);
+    save_number(filter->max_bytes, file);
+    for(size_t i = 0; i < filter->block_count * COUNTING_FILTER_BLOCK_BYTES; i++)
+    {
+        fputwc(hex_digits[filter->counters[i] & 0xf], file);
+        fputwc(hex_digits[filter->counters[i] >> 4], file);
+    }
+}
+
+///Reads a hexadecimal digit, returns -1 if it is not one.
+static int load_hex_digit(FILE* file)
+{
+    wchar_t sign = fgetwc(file);
+    for(int i = 0; i < 16; i++)
+        if(hex_digits[i] == sign)
+            return i;
+    return -1;
+}
+
+Counting_Filter* counting_filter_load(FILE* file)
+{
+    assert(file != NULL);
+
+    unsigned long long header[6];
+    for(int i = 0; i < 6; i++)
+        if(load_number(&header[i], file) < 0)
+            return NULL;
+    if(header[0] == 0 || header[1] == 0 || header[1] > COUNTING_FILTER_MAX_HASHES
+            || header[4] == 0 || header[4] >= COUNTING_FILTER_RATE_UNIT)
+        return NULL;
+
+    Counting_Filter* ret = new_filter(header[0], header[1]);
+    ret->capacity = header[2];
+    ret->word_count = header[3];
+    ret->false_positive_rate = (double) header[4] / COUNTING_FILTER_RATE_UNIT;
+    ret->max_bytes = header[5];
+    for(size_t i = 0; i < ret->block_count * COUNTING_FILTER_BLOCK_BYTES; i++)
+    {
+        int low = load_hex_digit(file);
+        int high = load_hex_digit(file);
+        if(low < 0 || high < 0)
+        {
+            counting_filter_free(ret);
+            return NULL;
+        }
+        ret->counters[i] = low | (high << 4);
+    }
+    return ret;
+}
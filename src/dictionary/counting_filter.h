@@ -0,0 +1,109 @@
+#ifndef COUNTING_FILTER_H_INCLUDED
+#define COUNTING_FILTER_H_INCLUDED
+
+/** @defgroup counting_filter Module counting_filter
+ * Approximate membership filter of words, supporting deletion.
+ */
+/**
+ * @file counting_filter.h Header file of module counting_filter.
+ * @ingroup counting_filter
+ * @author agent <agent@local>
+ * @date 2026-10
+ */
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <wchar.h>
+
+#define COUNTING_FILTER_BLOCK_BYTES 64 ///<Size of a block, one cache line.
+#define COUNTING_FILTER_BLOCK_COUNTERS (2 * COUNTING_FILTER_BLOCK_BYTES) ///<Number of 4-bit counters in a block.
+#define COUNTING_FILTER_MAX_COUNTER 15 ///<Counters reaching this value are never decremented.
+#define COUNTING_FILTER_MAX_HASHES 16 ///<Greatest number of counters of a word.
+#define COUNTING_FILTER_RATE_UNIT 1000000 ///<False positive rate is saved in millionths.
+#define COUNTING_FILTER_END_OF_NUMBER L';' ///<Value used to label in file an end of number of the header.
+
+/**
+ * Counting Bloom filter with all counters of a word in one block.
+ * <p>
+ * Every word increments hash_count counters of a block chosen by its hash, so a lookup
+ * reads a single cache line. A word which is not in the filter is reported as
+ * possibly present with probability about false_positive_rate, as long as there are
+ * at most capacity words and the memory budget is large enough.
+ */
+typedef struct
+{
+    size_t block_count; ///<Number of blocks.
+    int hash_count; ///<Number of counters of a word.
+    size_t capacity; ///<Number of words the filter was sized for.
+    size_t word_count; ///<Number of words in the filter.
+    double false_positive_rate; ///<Requested false positive rate.
+    size_t max_bytes; ///<Memory budget of counters.
+    unsigned char* counters; ///<Two counters per byte, lower one first.
+    size_t rejected; ///<Number of lookups answered negatively, updated atomically.
+    size_t passed; ///<Number of lookups answered positively, updated atomically.
+} Counting_Filter;
+
+/**
+ * @brief counting_filter_new Creates an empty filter.
+ * @param capacity Expected number of words.
+ * @param false_positive_rate Requested false positive rate, between 0 and 1.
+ * @param max_bytes Memory budget of counters, at least one block is used.
+ * @return Pointer to the new filter.
+ */
+Counting_Filter* counting_filter_new(size_t capacity, double false_positive_rate, size_t max_bytes);
+
+/**
+ * @brief counting_filter_free Deallocates the filter.
+ * @param filter The filter.
+ */
+void counting_filter_free(Counting_Filter* filter);
+
+/**
+ * @brief counting_filter_add Adds the word to the filter.
+ * @param filter The filter.
+ * @param word The word, which is not in the filter yet.
+ */
+void counting_filter_add(Counting_Filter* filter, const wchar_t* word);
+
+/**
+ * @brief counting_filter_remove Removes the word from the filter.
+ * @param filter The filter.
+ * @param word The word, previously added.
+ */
+void counting_filter_remove(Counting_Filter* filter, const wchar_t* word);
+
+/**
+ * @brief counting_filter_may_contain Tests if the word may be in the filter.
+ * @param filter The filter.
+ * @param word The word.
+ * @return False if the word is surely not in the filter.
+ * Concurrent calls are allowed, they only update the counters atomically.
+ */
+bool counting_filter_may_contain(Counting_Filter* filter, const wchar_t* word);
+
+/**
+ * @brief counting_filter_stats Reads counters of lookups.
+ * @param filter The filter.
+ * @param rejected Pointer to store the number of lookups answered negatively.
+ * @param passed Pointer to store the number of lookups answered positively.
+ */
+void counting_filter_stats(const Counting_Filter* filter, size_t* rejected, size_t* passed);
+
+/**
+ * @brief counting_filter_save Saves the filter.
+ * @param filter The filter.
+ * @param file File to save in.
+ * Header numbers are written in decimal, each ended by COUNTING_FILTER_END_OF_NUMBER,
+ * then every counter is written as a hexadecimal digit.
+ */
+void counting_filter_save(const Counting_Filter* filter, FILE* file);
+
+/**
+ * @brief counting_filter_load Loads filter saved by counting_filter_save().
+ * @param file File to load from.
+ * @return Pointer to the loaded filter or NULL if file is malformed.
+ */
+Counting_Filter* counting_filter_load(FILE* file);
+
+#endif // COUNTING_FILTER_H_INCLUDED
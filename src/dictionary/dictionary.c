@@ -15,12 +15,24 @@
 #include <dirent.h>
 #include <wchar.h>
 #include "trie.h"
+#include "heap.h"
 
 #include "error_handling.h"
 #include "dictionary.h"
 
 #define _GNU_SOURCE
 
+#define SECTION_SIGN L'\0' ///<Value used to label in file a beginning of optional section after the alphabet.
+#define FREQUENCY_SECTION_TAG L'f' ///<Value used to label in file a section with frequencies of words.
+#define FILTER_SECTION_TAG L'b' ///<Value used to label in file a section with the filter of words.
+#define HASH_SECTION_TAG L'm' ///<Value used to label in file a section with the hash of words.
+#define HASH_DIGITS 16 ///<Number of hexadecimal digits of a saved hash.
+#define DELTA_ADDED_SIGN L'+' ///<Value starting a word to be inserted in a delta.
+#define DELTA_REMOVED_SIGN L'-' ///<Value starting a word to be deleted in a delta.
+#define DELTA_END_SIGN L'\n' ///<Value ending every line of a delta.
+#define DELTA_FREQUENCY_END_SIGN L' ' ///<Value following frequency of a word to be inserted in a delta.
+#define DELTA_STOP_SIGN L'.' ///<Value ending a delta, so a truncated one is recognized.
+
 
 #ifdef DICTIONARY_UNIT_TESTING
 #include <stdarg.h>
@@ -36,6 +48,11 @@
 #endif // calloc
 #define calloc(num, size) _test_calloc(num, size, __FILE__, __LINE__)
 
+#ifdef realloc
+#undef realloc
+#endif // realloc
+#define realloc(ptr, size) _test_realloc(ptr, size, __FILE__, __LINE__)
+
 #ifdef free
 #undef free
 #endif // free
@@ -115,6 +132,8 @@ static void update_alphabet(Dictionary* dict, const wchar_t* word)
     wchar_t* wch;
     for(int i = 0; word[i] != 0; i++)
     {
+        if(set_find(dict->alphabet, (wchar_t*) &word[i]) != NULL) //most letters are known
+            continue;
         wch = malloc(sizeof(wchar_t));
         *wch = word[i];
         if(wch == NULL) report_error(MEMORY);
@@ -140,6 +159,36 @@ static wchar_t* new_low_wstring(const wchar_t* word)
     return low_word;
 }
 
+/**
+ * @brief restore_spelling Replaces the queried word in its hints by the spelling of the caller.
+ * @param list Hints of the word.
+ * @param low_word The word in lower case.
+ * @param word The word as written by the caller.
+ * Hints are generated from lower case words, but the word itself, if found, is returned as written.
+ */
+static void restore_spelling(struct word_list* list, const wchar_t* low_word, const wchar_t* word)
+{
+    if(wcscmp(low_word, word) == 0)
+        return;
+    for(struct word_node* node = list->first; node != NULL; node = node->next)
+        if(wcscmp(node->word, low_word) == 0)
+        {
+            wcscpy(node->word, word); //lowering keeps the length
+            return;
+        }
+}
+
+///Reverses the word in place.
+static void reverse_wstring(wchar_t* word)
+{
+    for(size_t i = 0, j = wcslen(word); i + 1 < j; i++, j--)
+    {
+        wchar_t tmp = word[i];
+        word[i] = word[j-1];
+        word[j-1] = tmp;
+    }
+}
+
 /**
  * @brief save_alphabet_to_file Saves alphabet of given dict to given file.
  * @param dict The dictionary.
@@ -162,7 +211,7 @@ static Array_Set* load_alphabet_from_file(FILE* file)
     Array_Set* ret = set_new(&alphabet_set_functions);
     wchar_t* alloc = malloc(sizeof(wchar_t));
     if(alloc == NULL) report_error(MEMORY);
-    while((*alloc = fgetwc(file)) != WEOF)
+    while((*alloc = fgetwc(file)) != WEOF && *alloc != SECTION_SIGN)
     {
         set_add(ret, alloc);
         alloc = malloc(sizeof(wchar_t));
@@ -172,6 +221,144 @@ static Array_Set* load_alphabet_from_file(FILE* file)
     return ret;
 }
 
+/**
+ * @brief save_hash Writes hash as HASH_DIGITS hexadecimal digits.
+ * @param hash The hash.
+ * @param file The file.
+ */
+static void save_hash(uint64_t hash, FILE* file)
+{
+    for(int i = HASH_DIGITS - 1; i >= 0; i--)
+        fputwc(L"0123456789abcdef"[(hash >> (4 * i)) & 15], file);
+}
+
+/**
+ * @brief load_hash Reads hash written by save_hash().
+ * @param file The file.
+ * @param hash Pointer to store the hash.
+ * @return 0 on success, -1 if the file does not continue with a hash.
+ */
+static int load_hash(FILE* file, uint64_t* hash)
+{
+    *hash = 0;
+    for(int i = 0; i < HASH_DIGITS; i++)
+    {
+        wint_t sign = fgetwc(file);
+        if(sign >= L'0' && sign <= L'9')
+            *hash = *hash << 4 | (sign - L'0');
+        else if(sign >= L'a' && sign <= L'f')
+            *hash = *hash << 4 | (sign - L'a' + 10);
+        else
+            return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief save_sections_to_file Saves optional sections of given dict, only those which carry any data.
+ * @param dict The dictionary.
+ * @param file The file.
+ * Every section starts with SECTION_SIGN and a tag, so files without sections are read as before.
+ */
+static void save_sections_to_file(const Dictionary* dict, FILE* file)
+{
+    if(dict->trie_root->max_frequency > 0)
+    {
+        fputwc(SECTION_SIGN, file);
+        fputwc(FREQUENCY_SECTION_TAG, file);
+        trie_save_frequencies(dict->trie_root, file);
+    }
+    if(dict->filter != NULL)
+    {
+        fputwc(SECTION_SIGN, file);
+        fputwc(FILTER_SECTION_TAG, file);
+        counting_filter_save(dict->filter, file);
+    }
+    if(dict->trie_root->hash != 0) //saved only if hashes are used and up to date
+    {
+        fputwc(SECTION_SIGN, file);
+        fputwc(HASH_SECTION_TAG, file);
+        save_hash(dict->trie_root->hash, file);
+    }
+}
+
+/**
+ * @brief load_sections_from_file Loads optional sections following the alphabet.
+ * @param dict Dictionary with loaded trie.
+ * @param file File to load from, positioned just after the first SECTION_SIGN.
+ * Reading stops at the end of file or at the first unknown or broken section.
+ */
+static void load_sections_from_file(Dictionary* dict, FILE* file)
+{
+    do
+    {
+        switch(fgetwc(file))
+        {
+        case FREQUENCY_SECTION_TAG:
+            if(trie_load_frequencies(dict->trie_root, file) < 0)
+                return;
+            break;
+        case FILTER_SECTION_TAG:
+            if(dict->filter != NULL)
+                counting_filter_free(dict->filter);
+            dict->filter = counting_filter_load(file);
+            if(dict->filter == NULL)
+                return;
+            break;
+        case HASH_SECTION_TAG:
+            if(load_hash(file, &dict->trie_root->hash) < 0)
+            {
+                dict->trie_root->hash = 0;
+                return;
+            }
+            break;
+        default:
+            return;
+        }
+    } while(fgetwc(file) == SECTION_SIGN);
+}
+
+///Callback of trie_for_each_word() adding the word to the filter.
+static void filter_visit(const wchar_t* word, const Node* node, void* data)
+{
+    (void) node;
+    counting_filter_add(data, word);
+}
+
+/**
+ * @brief build_filter Replaces filter of the dictionary by a new one with all its words.
+ * @param dict Dictionary
+ * @param false_positive_rate Requested false positive rate.
+ * @param max_bytes Memory budget.
+ * The filter is sized for twice as many words as there are now, so it is rebuilt rarely.
+ */
+static void build_filter(Dictionary* dict, double false_positive_rate, size_t max_bytes)
+{
+    if(dict->filter != NULL)
+        counting_filter_free(dict->filter);
+    dict->filter = counting_filter_new(2 * (size_t) dict->trie_root->word_count, false_positive_rate, max_bytes);
+    trie_for_each_word(dict->trie_root, filter_visit, dict->filter);
+}
+
+/**
+ * @brief filter_add Adds new word of the dictionary to its filter.
+ * @param dict Dictionary with a filter.
+ * @param word The word, already inserted to the trie.
+ */
+static void filter_add(Dictionary* dict, const wchar_t* word)
+{
+    counting_filter_add(dict->filter, word);
+    if(dict->filter->word_count > dict->filter->capacity)
+        build_filter(dict, dict->filter->false_positive_rate, dict->filter->max_bytes);
+}
+
+///Remembers changed word in the journal, if it is enabled.
+static void journal_record(Dictionary* dict, const wchar_t* word)
+{
+    if(dict->journal != NULL)
+        word_list_add(&dict->journal->changed, word);
+}
+
 // Interface
 
 Dictionary* dictionary_new()
@@ -180,6 +367,17 @@ Dictionary* dictionary_new()
     if(ret == NULL) report_error(MEMORY);
     ret->alphabet = set_new(&alphabet_set_functions);
     ret->trie_root = trie_new_node();
+    ret->generation = 0;
+    ret->hints_cache = NULL;
+    ret->costs = NULL;
+    ret->phonetic_rules = phonetic_rules(DICTIONARY_DEFAULT_LANG);
+    ret->phonetic_index = NULL;
+    ret->anagram_index = NULL;
+    ret->suffix_root = NULL;
+    ret->filter = NULL;
+    ret->word_hash = NULL;
+    ret->find_cache = NULL;
+    ret->journal = NULL;
     return ret;
 }
 
@@ -187,6 +385,23 @@ void dictionary_done(struct dictionary *dict)
 {
     assert(dict_non_null(dict));
 
+    if(dict->hints_cache != NULL)
+        hints_cache_free(dict->hints_cache);
+    if(dict->costs != NULL)
+        edit_costs_free(dict->costs);
+    if(dict->phonetic_index != NULL)
+        key_index_free(dict->phonetic_index);
+    if(dict->anagram_index != NULL)
+        key_index_free(dict->anagram_index);
+    if(dict->suffix_root != NULL)
+        trie_free_node(dict->suffix_root);
+    if(dict->filter != NULL)
+        counting_filter_free(dict->filter);
+    if(dict->word_hash != NULL)
+        word_hash_free(dict->word_hash);
+    if(dict->find_cache != NULL)
+        find_cache_free(dict->find_cache);
+    dictionary_journal_disable(dict);
     set_free(dict->alphabet);
     trie_free_node(dict->trie_root);
     free(dict);
@@ -204,6 +419,24 @@ int dictionary_insert(struct dictionary *dict, const wchar_t *word)
 
     update_alphabet(dict, low_word);
     int ret = trie_insert_word(dict->trie_root, low_word) == TRIE_INSERT_MODIFIED ? DICTIONARY_INSERT_MODIFIED : DICTIONARY_INSERT_NOT_MODIFIED;
+    if(ret == DICTIONARY_INSERT_MODIFIED)
+    {
+        dict->generation++;
+        journal_record(dict, low_word);
+        if(dict->phonetic_index != NULL)
+            key_index_add(dict->phonetic_index, low_word);
+        if(dict->anagram_index != NULL)
+            key_index_add(dict->anagram_index, low_word);
+        if(dict->filter != NULL)
+            filter_add(dict, low_word);
+        if(dict->word_hash != NULL)
+            word_hash_insert(dict->word_hash, low_word);
+        if(dict->suffix_root != NULL) //last, reverses low_word
+        {
+            reverse_wstring(low_word);
+            trie_insert_word(dict->suffix_root, low_word);
+        }
+    }
     free(low_word);
     return ret;
 }
@@ -218,6 +451,24 @@ int dictionary_delete(struct dictionary *dict, const wchar_t *word)
     wchar_t* low_word = new_low_wstring(word);
 
     int ret = trie_delete_word(dict->trie_root, low_word) == TRIE_WORD_DELETED ? DICTIONARY_WORD_DELETED : DICTIONARY_WORD_NOT_DELETED;
+    if(ret == DICTIONARY_WORD_DELETED)
+    {
+        dict->generation++;
+        journal_record(dict, low_word);
+        if(dict->phonetic_index != NULL)
+            key_index_remove(dict->phonetic_index, low_word);
+        if(dict->anagram_index != NULL)
+            key_index_remove(dict->anagram_index, low_word);
+        if(dict->filter != NULL)
+            counting_filter_remove(dict->filter, low_word);
+        if(dict->word_hash != NULL)
+            word_hash_remove(dict->word_hash, low_word);
+        if(dict->suffix_root != NULL) //last, reverses low_word
+        {
+            reverse_wstring(low_word);
+            trie_delete_word(dict->suffix_root, low_word);
+        }
+    }
     free(low_word);
     return ret;
 }
@@ -229,9 +480,125 @@ bool dictionary_find(const struct dictionary *dict, const wchar_t* word)
 
     if(!dict_non_null(dict) || !word_valid(word)) return TRIE_WORD_NOT_FOUND;
 
+    if(dict->find_cache != NULL)
+    {
+        int cached = find_cache_get(dict->find_cache, word, dict->generation);
+        if(cached != FIND_CACHE_MISS)
+            return cached;
+    }
+    wchar_t* low_word = new_low_wstring(word);
+
+    int ret;
+    if(dict->filter != NULL && !counting_filter_may_contain(dict->filter, low_word))
+        ret = DICTIONARY_WORD_NOT_FOUND;
+    else if(dict->word_hash != NULL)
+        ret = word_hash_contains(dict->word_hash, low_word) ? DICTIONARY_WORD_FOUND : DICTIONARY_WORD_NOT_FOUND;
+    else
+        ret = trie_find_word(dict->trie_root, low_word) == TRIE_WORD_FOUND ? DICTIONARY_WORD_FOUND : DICTIONARY_WORD_NOT_FOUND;
+    free(low_word);
+    if(dict->find_cache != NULL)
+        find_cache_put(dict->find_cache, word, dict->generation, ret);
+    return ret;
+}
+
+void dictionary_find_batch(const struct dictionary *dict, const wchar_t* const* words, size_t count, bool* results)
+{
+    assert(dict_non_null(dict));
+    assert(count == 0 || (words != NULL && results != NULL));
+
+    if(!dict_non_null(dict) || count == 0) return;
+
+    //words not answered by the cache are written in lower case to one buffer
+    size_t* positions = malloc(sizeof(size_t) * count);
+    const wchar_t** low_words = malloc(sizeof(wchar_t*) * count);
+    if(positions == NULL || low_words == NULL) report_error(MEMORY);
+    size_t pending = 0;
+    size_t buffer_len = 0;
+    for(size_t i = 0; i < count; i++)
+    {
+        results[i] = DICTIONARY_WORD_NOT_FOUND;
+        if(!word_valid(words[i]))
+            continue;
+        int cached = dict->find_cache == NULL ? FIND_CACHE_MISS
+                     : find_cache_get(dict->find_cache, words[i], dict->generation);
+        if(cached != FIND_CACHE_MISS)
+            results[i] = cached;
+        else
+        {
+            positions[pending++] = i;
+            buffer_len += wcslen(words[i]) + 1;
+        }
+    }
+    wchar_t* buffer = malloc(sizeof(wchar_t) * (buffer_len + 1));
+    if(buffer == NULL) report_error(MEMORY);
+
+    size_t trie_count = 0;
+    wchar_t* low_word = buffer;
+    for(size_t i = 0; i < pending; i++)
+    {
+        const wchar_t* word = words[positions[i]];
+        size_t len = 0;
+        for(; word[len] != L'\0'; len++)
+            low_word[len] = (wchar_t) towlower((wint_t) word[len]);
+        low_word[len] = L'\0';
+
+        if(dict->filter != NULL && !counting_filter_may_contain(dict->filter, low_word))
+            ; //rejected, the result is set already
+        else if(dict->word_hash != NULL)
+            results[positions[i]] = word_hash_contains(dict->word_hash, low_word);
+        else
+        {
+            positions[trie_count] = positions[i];
+            low_words[trie_count++] = low_word;
+        }
+        low_word += len + 1;
+    }
+    bool* found = malloc(sizeof(bool) * (trie_count + 1));
+    if(found == NULL) report_error(MEMORY);
+    trie_find_words(dict->trie_root, low_words, trie_count, found);
+    for(size_t i = 0; i < trie_count; i++)
+        results[positions[i]] = found[i];
+
+    if(dict->find_cache != NULL)
+        for(size_t i = 0; i < count; i++)
+            if(word_valid(words[i]))
+                find_cache_put(dict->find_cache, words[i], dict->generation, results[i]);
+    free(found);
+    free(buffer);
+    free(low_words);
+    free(positions);
+}
+
+int dictionary_set_frequency(struct dictionary *dict, const wchar_t* word, unsigned frequency)
+{
+    assert(dict_non_null(dict));
+    assert(word_valid(word));
+
+    if(!dict_non_null(dict) || !word_valid(word)) return DICTIONARY_WORD_NOT_FOUND;
+    if(frequency > DICTIONARY_MAX_FREQUENCY)
+        frequency = DICTIONARY_MAX_FREQUENCY;
+
     wchar_t* low_word = new_low_wstring(word);
+    unsigned old_frequency = trie_get_frequency(dict->trie_root, low_word);
+    int ret = trie_set_frequency(dict->trie_root, low_word, frequency) == TRIE_WORD_FOUND ? DICTIONARY_WORD_FOUND : DICTIONARY_WORD_NOT_FOUND;
+    if(ret == DICTIONARY_WORD_FOUND && old_frequency != frequency)
+    {
+        dict->generation++; //ranking of hints changes
+        journal_record(dict, low_word);
+    }
+    free(low_word);
+    return ret;
+}
+
+unsigned dictionary_frequency(const struct dictionary *dict, const wchar_t* word)
+{
+    assert(dict_non_null(dict));
+    assert(word_valid(word));
 
-    int ret = trie_find_word(dict->trie_root, low_word) == TRIE_WORD_FOUND ? DICTIONARY_WORD_FOUND : DICTIONARY_WORD_NOT_FOUND;
+    if(!dict_non_null(dict) || !word_valid(word)) return 0;
+
+    wchar_t* low_word = new_low_wstring(word);
+    unsigned ret = trie_get_frequency(dict->trie_root, low_word);
     free(low_word);
     return ret;
 }
@@ -240,6 +607,7 @@ int dictionary_save(const struct dictionary *dict, FILE* file)
 {
     trie_save_to_file(dict->trie_root, file);
     save_alphabet_to_file(dict, file);
+    save_sections_to_file(dict, file);
     return DICTIONARY_SAVE_SUCCESS;
 }
 
@@ -249,78 +617,74 @@ Dictionary* dictionary_load(FILE* file)
     if(ret == NULL) report_error(MEMORY);
     ret->trie_root = trie_load_from_file(file);
     ret->alphabet = load_alphabet_from_file(file);
+    ret->generation = 0;
+    ret->hints_cache = NULL;
+    ret->costs = NULL;
+    ret->phonetic_rules = phonetic_rules(DICTIONARY_DEFAULT_LANG);
+    ret->phonetic_index = NULL;
+    ret->anagram_index = NULL;
+    ret->suffix_root = NULL;
+    ret->filter = NULL;
+    ret->word_hash = NULL;
+    ret->find_cache = NULL;
+    ret->journal = NULL;
+    if(ret->trie_root != NULL)
+        load_sections_from_file(ret, file);
     return ret;
 }
 
-/**
- * @brief replace_letter Creates new word by exchanging one letter with another.
- * @param word Model word.
- * @param pos Position in word to be replaced.
- * @param letter Letter, which will be substituted at pos in word.
- * @param word_len Length of the word.
- * @return Pointer to a new word, indepenedent from model word.
- */
-static wchar_t* replace_letter(const wchar_t* word, int pos, wchar_t letter, int word_len)
+int dictionary_save_packed(const struct dictionary *dict, FILE* file)
 {
-    assert(word != NULL);
-    assert(wcslen(word) == word_len);
-    assert(0 <= pos && pos < word_len);
-    assert(word_len > 0);
-
-    wchar_t* ret = malloc(sizeof(wchar_t) * (word_len+1));
-    memcpy(ret, word, sizeof(wchar_t) * word_len);
-    ret[pos] = letter;
-    ret[word_len] = L'\0';
+    assert(dict_non_null(dict));
+    assert(file != NULL);
 
-    assert(wcslen(ret) == word_len);
-    return ret;
+    if(front_coding_save(dict->trie_root, FRONT_CODING_BLOCK_WORDS, file) != FRONT_CODING_SAVE_SUCCESS)
+        return -1;
+    return DICTIONARY_SAVE_SUCCESS;
 }
 
 /**
- * @brief insert_letter Creates a new word by inserting 'letter' onto position 'pos' and moving the rest of letters to right.
- * @param word Model word.
- * @param pos Position, where to insert letter.
- * @param letter Letter which will be inserted.
- * @param word_len Length of model word.
- * @return Pointer to a new word, independent from model word.
- */
-static wchar_t* insert_letter(const wchar_t* word, int pos, wchar_t letter, int word_len)
+  * State of dictionary_load_packed().
+  */
+typedef struct
 {
-    assert(word != NULL);
-    assert(wcslen(word) == word_len);
-    assert(0 <= pos && pos <= word_len);
-    assert(word_len > 0);
+    Dictionary* dict; ///<The loaded dictionary.
+    Trie_Builder builder; ///<Builder of its trie.
+    bool failed; ///<True if words were not sorted.
+} Packed_Load;
 
-    wchar_t* ret = malloc(sizeof(wchar_t) * (word_len + 1 + 1)); //1 na '\0' i 1 na nowa litere
-    memcpy(ret, word, sizeof(wchar_t) * pos);
-    ret[pos] = letter;
-    memcpy(&(ret[pos+1]), &word[pos], sizeof(wchar_t) * (word_len - pos));
-    ret[word_len+1] = L'\0';
-
-    assert(wcslen(ret) == word_len+1);
-    return ret;
+///Callback of front_coding_for_each_word() appending the word, already in lower case, to the trie.
+static void load_packed_word(const wchar_t* word, unsigned frequency, void* data)
+{
+    Packed_Load* load = data;
+    int added = trie_builder_add(&load->builder, word, frequency);
+    if(added < 0)
+        load->failed = true;
+    else //letters of the previous nodes are in the alphabet already
+        update_alphabet(load->dict, word + wcslen(word) - added);
 }
 
-/**
- * @brief remove_letter Creates new word by removal one of the letters.
- * @param word Model word.
- * @param pos Position of letter to be removed.
- * @param word_len Length of the model word.
- * @return Pointer to created word.
- */
-static wchar_t* remove_letter(const wchar_t* word, int pos, int word_len)
+Dictionary* dictionary_load_packed(FILE* file)
 {
-    assert(word != NULL);
-    assert(wcslen(word) == word_len);
-    assert(0 <= pos && pos < word_len);
+    assert(file != NULL);
 
-    wchar_t* ret = malloc(sizeof(wchar_t) * word_len); //-1 za litere i +1 za '\0'
-    memcpy(ret, word, sizeof(wchar_t) * pos); //kopiuje pos pierwszych znakow
-    memcpy(&(ret[pos]), &(word[pos+1]), sizeof(wchar_t) * (word_len - pos -1)); //do kolejnych ret-a kopiujemy kolejne word-a, pomijaja pos-ty
-    ret[word_len-1] = L'\0';
-
-    assert(wcslen(word) == word_len);
-    return ret;
+    Front_Coded* coded = front_coding_open(file);
+    if(coded == NULL)
+        return NULL;
+    Packed_Load load;
+    load.dict = dictionary_new();
+    load.failed = false;
+    trie_builder_init(&load.builder);
+    long loaded = front_coding_for_each_word(coded, load_packed_word, &load);
+    front_coding_close(coded);
+    trie_free_node(load.dict->trie_root);
+    load.dict->trie_root = trie_builder_finish(&load.builder);
+    if(loaded < 0 || load.failed)
+    {
+        dictionary_done(load.dict);
+        return NULL;
+    }
+    return load.dict;
 }
 
 #ifndef NDEBUG
@@ -338,174 +702,1762 @@ static void dictionary_print(Dictionary* dict)
 
 void dictionary_hints(const struct dictionary *dict, const wchar_t* word,
                       struct word_list *list)
+{
+    Hints_Options options;
+    hints_default_options(&options);
+    dictionary_hints_with_options(dict, word, &options, list);
+}
+
+int dictionary_hints_with_options(const struct dictionary *dict, const wchar_t* word,
+                                  const Hints_Options* options, struct word_list *list)
 {
     assert(dict_non_null(dict));
     assert(word_valid(word));
+    assert(options != NULL);
     assert(list != NULL);
 
-    if(!dict_non_null(dict) || !word_valid(word) || list == NULL) return;
-
+    if(list == NULL) return DICTIONARY_HINTS_COMPLETE;
     word_list_init(list);
-    int len = wcslen(word);
-    wchar_t* low_word = new_low_wstring(word);
+    if(!dict_non_null(dict) || !word_valid(word) || options == NULL) return DICTIONARY_HINTS_COMPLETE;
 
-    if(dictionary_find(dict, low_word) == DICTIONARY_WORD_FOUND)
-        word_list_add(list, word);
-
-    for(int w = 0; w < dict->alphabet->element_count; w++)
+    wchar_t* low_word = new_low_wstring(word);
+    int ret = DICTIONARY_HINTS_COMPLETE;
+    if(dict->hints_cache == NULL
+       || !hints_cache_get(dict->hints_cache, low_word, options->max_edits, options->max_results, HINTS_CACHE_PLAIN, dict->generation, list))
     {
-        for(int i = 0; i < len; i++) //replace
-        {
-            if(low_word[i] == *(wchar_t*)(dict->alphabet->storage[w])) continue;
-            wchar_t* replaced = replace_letter(low_word, i, *(wchar_t*)(dict->alphabet->storage[w]), len);
-            if(dictionary_find(dict, replaced) == DICTIONARY_WORD_FOUND)
-                word_list_add(list, replaced);
-            free(replaced); //freeing, because list copies when adding.
-        }
-        for(int i = 0; i <= len; i++) //insert
-        {
-            wchar_t* inserted = insert_letter(low_word, i, *(wchar_t*)(dict->alphabet->storage[w]), len);
-            if(dictionary_find(dict, inserted) == DICTIONARY_WORD_FOUND)
-                word_list_add(list, inserted);
-            free(inserted);
-        }
+        ret = hints_generate(dict->trie_root, low_word, options, list);
+        hints_order_by_distance(low_word, list);
+        if(dict->hints_cache != NULL && ret == DICTIONARY_HINTS_COMPLETE)
+            hints_cache_put(dict->hints_cache, low_word, options->max_edits, options->max_results, HINTS_CACHE_PLAIN, dict->generation, list);
     }
+    restore_spelling(list, low_word, word);
+    free(low_word);
+    return ret;
+}
+
+int dictionary_hints_top(const struct dictionary *dict, const wchar_t* word, size_t k,
+                         const Hints_Options* options, struct word_list *list)
+{
+    assert(dict_non_null(dict));
+    assert(word_valid(word));
+    assert(options != NULL);
+    assert(list != NULL);
+
+    if(list == NULL) return DICTIONARY_HINTS_COMPLETE;
+    word_list_init(list);
+    if(!dict_non_null(dict) || !word_valid(word) || options == NULL) return DICTIONARY_HINTS_COMPLETE;
 
-    if(len > 1)
+    wchar_t* low_word = new_low_wstring(word);
+    int ret = DICTIONARY_HINTS_COMPLETE;
+    if(dict->hints_cache == NULL
+       || !hints_cache_get(dict->hints_cache, low_word, options->max_edits, k, HINTS_CACHE_TOP, dict->generation, list))
     {
-        for(int i = 0; i < len; i++) //remove
-        {
-            wchar_t* removed = remove_letter(low_word, i, len);
-            if(dictionary_find(dict, removed) == DICTIONARY_WORD_FOUND)
-                word_list_add(list, removed);
-            free(removed);
-        }
+        ret = hints_generate_top(dict->trie_root, low_word, options, k, list);
+        if(dict->hints_cache != NULL && ret == DICTIONARY_HINTS_COMPLETE)
+            hints_cache_put(dict->hints_cache, low_word, options->max_edits, k, HINTS_CACHE_TOP, dict->generation, list);
     }
+    restore_spelling(list, low_word, word);
+    free(low_word);
+    return ret;
+}
 
-    if(word_list_size(list) == 0)
-        return;
-
-    wchar_t** tab = word_list_get(list);
+int dictionary_hints_weighted(const struct dictionary *dict, const wchar_t* word, size_t k,
+                              const Hints_Options* options, struct word_list *list)
+{
+    assert(dict_non_null(dict));
+    assert(word_valid(word));
+    assert(options != NULL);
+    assert(list != NULL);
 
-    int list_len = word_list_size(list);
-    word_list_done(list);
+    if(list == NULL) return DICTIONARY_HINTS_COMPLETE;
     word_list_init(list);
+    if(!dict_non_null(dict) || !word_valid(word) || options == NULL) return DICTIONARY_HINTS_COMPLETE;
 
-    word_list_add(list, tab[0]);
-    for(int i = 1; i < list_len; i++)
-        if(wcscmp(tab[i], tab[i-1]))
-            word_list_add(list, tab[i]);
-
-    for(int i=0; i < list_len; i++)
-        free(tab[i]);
-    free(tab);
+    wchar_t* low_word = new_low_wstring(word);
+    int ret = DICTIONARY_HINTS_COMPLETE;
+    if(dict->hints_cache == NULL
+       || !hints_cache_get(dict->hints_cache, low_word, options->max_edits, k, HINTS_CACHE_WEIGHTED, dict->generation, list))
+    {
+        Edit_Costs* costs = dict->costs != NULL ? dict->costs : edit_costs_new();
+        ret = hints_generate_weighted(dict->trie_root, low_word, options, costs, k, list);
+        if(costs != dict->costs)
+            edit_costs_free(costs);
+        if(dict->hints_cache != NULL && ret == DICTIONARY_HINTS_COMPLETE)
+            hints_cache_put(dict->hints_cache, low_word, options->max_edits, k, HINTS_CACHE_WEIGHTED, dict->generation, list);
+    }
+    restore_spelling(list, low_word, word);
     free(low_word);
+    return ret;
 }
 
-int dictionary_lang_list(char** list, size_t *list_len)
+void dictionary_set_costs(struct dictionary *dict, Edit_Costs* costs)
 {
-    DIR* main_dir = opendir(CONF_PATH);
-    if(main_dir == NULL) return -1;
+    assert(dict_non_null(dict));
 
-    Word_List* buffer = word_list_new();
-    struct dirent* current_element;
-    *list_len = 0;
-    while((current_element = readdir(main_dir)) != NULL)
+    if(!dict_non_null(dict)) return;
+    if(dict->costs != NULL)
+        edit_costs_free(dict->costs);
+    dict->costs = costs;
+    dict->generation++; //ranking of weighted hints changes
+}
+
+int dictionary_hints_batch(const struct dictionary *dict, const wchar_t* const* words, size_t count,
+                           const Hints_Options* options, struct word_list *lists)
+{
+    assert(dict_non_null(dict));
+    assert(options != NULL);
+    assert(lists != NULL || count == 0);
+
+    for(size_t i = 0; i < count; i++)
+        word_list_init(&lists[i]);
+    if(!dict_non_null(dict) || options == NULL || count == 0) return DICTIONARY_HINTS_COMPLETE;
+
+    wchar_t** low_words = malloc(sizeof(wchar_t*) * count);
+    if(low_words == NULL) report_error(MEMORY);
+    struct word_list* low_lists = malloc(sizeof(struct word_list) * count);
+    if(low_lists == NULL) report_error(MEMORY);
+
+    size_t* positions = malloc(sizeof(size_t) * count);
+    if(positions == NULL) report_error(MEMORY);
+
+    size_t missed = 0;
+    for(size_t i = 0; i < count; i++)
     {
-        if(current_element->d_type != DT_REG) //if not file, then skipping
+        if(!word_valid(words[i]))
+            continue;
+        wchar_t* low_word = new_low_wstring(words[i]);
+        if(dict->hints_cache != NULL
+           && hints_cache_get(dict->hints_cache, low_word, options->max_edits, options->max_results, HINTS_CACHE_PLAIN, dict->generation, &lists[i]))
+        {
+            restore_spelling(&lists[i], low_word, words[i]);
+            free(low_word);
             continue;
+        }
+        low_words[missed] = low_word;
+        word_list_init(&low_lists[missed]);
+        positions[missed] = i;
+        missed++;
+    }
 
-        int name_len = strlen(current_element->d_name);
-        wchar_t* wname = malloc(sizeof(wchar_t) * (name_len + 1));
-        if(wname == NULL) report_error(MEMORY);
-        for(int i = 0; i <= name_len; i++) //copy including \0
-            wname[i] = current_element->d_name[i];
+    int ret = hints_generate_batch(dict->trie_root, (const wchar_t* const*) low_words, missed, options, low_lists);
 
-        *list_len += name_len + 1;
-        word_list_add(buffer, wname);
-    }
-    //for example list may contain
-    //"pl_PL\0en_US\0"
-    *list = malloc(sizeof(char) * (*list_len));
-    if(*list == NULL) report_error(MEMORY);
-    int pos_in_list = 0;
-    int curr_word_len;
-    struct word_node* current_node = buffer->first;
-    while(current_node != NULL) //travel by all nodes in list
+    for(size_t i = 0; i < missed; i++)
     {
-        curr_word_len = wcslen(current_node->word);
-        for(int i = 0; i <= curr_word_len; i++)
-            (*list)[pos_in_list++] = current_node->word[i];
-        current_node = current_node->next;
+        hints_order_by_distance(low_words[i], &low_lists[i]);
+        //partial batch may have stopped before any word, so only complete batches are cached
+        if(dict->hints_cache != NULL && ret == DICTIONARY_HINTS_COMPLETE)
+            hints_cache_put(dict->hints_cache, low_words[i], options->max_edits, options->max_results, HINTS_CACHE_PLAIN, dict->generation, &low_lists[i]);
+        lists[positions[i]] = low_lists[i]; //list takes over words
+        restore_spelling(&lists[positions[i]], low_words[i], words[positions[i]]);
+        free(low_words[i]);
     }
-    assert(pos_in_list == *list_len);
-    return 0;
+    free(positions);
+    free(low_words);
+    free(low_lists);
+    return ret;
 }
 
-/**
- * @brief strcat3 Concatenate three strings.
- * @param str1 String one.
- * @param str2 String two.
- * @param str3 String three.
- * @return str1+str2+str3
- */
-static char* strcat3(char* str1, char* str2, char* str3)
+void dictionary_hints_cache_enable(struct dictionary *dict, size_t max_entries, size_t max_bytes)
 {
-    int len1 = strlen(str1);
-    int len2 = strlen(str2);
-    int len3 = strlen(str3);
-    char* ret = malloc(sizeof(char) * (len1+len2+len3+1));
-    if(ret == NULL) report_error(MEMORY);
-    int global_pos = 0;
-    for(int i = 0; i < len1; i++)
-        ret[global_pos + i] = str1[i];
-    global_pos += len1;
-    for(int i = 0; i < len2; i++)
-        ret[global_pos + i] = str2[i];
-    global_pos += len2;
-    for(int i = 0; i < len3; i++)
-        ret[global_pos + i] = str3[i];
-    global_pos += len3;
-    ret[global_pos] = 0;
-    return ret;
+    assert(dict_non_null(dict));
+    assert(max_entries > 0);
 
+    if(!dict_non_null(dict) || max_entries == 0) return;
+    dictionary_hints_cache_disable(dict);
+    dict->hints_cache = hints_cache_new(max_entries, max_bytes);
+    dict->hints_cache->generation = dict->generation;
 }
 
-Dictionary* dictionary_load_lang(const char* lang)
+void dictionary_hints_cache_disable(struct dictionary *dict)
 {
-    DIR* main_dir = opendir(CONF_PATH);
-    if(main_dir == NULL)
-        return NULL;
+    assert(dict != NULL);
 
-    struct dirent* current_element;
+    if(dict == NULL || dict->hints_cache == NULL) return;
+    hints_cache_free(dict->hints_cache);
+    dict->hints_cache = NULL;
+}
 
-    while((current_element = readdir(main_dir)) != NULL)
-    {
-        if(current_element->d_type != DT_REG) //skipping not-files
+void dictionary_hints_cache_stats(const struct dictionary *dict, size_t *hits, size_t *misses)
+{
+    assert(dict != NULL);
+
+    *hits = 0;
+    *misses = 0;
+    if(dict == NULL || dict->hints_cache == NULL) return;
+    hints_cache_stats(dict->hints_cache, hits, misses);
+}
+
+void dictionary_filter_enable(struct dictionary *dict, double false_positive_rate, size_t max_bytes)
+{
+    assert(dict_non_null(dict));
+    assert(false_positive_rate > 0 && false_positive_rate < 1);
+
+    if(dict->filter == NULL)
+        build_filter(dict, false_positive_rate, max_bytes);
+}
+
+void dictionary_filter_disable(struct dictionary *dict)
+{
+    assert(dict_non_null(dict));
+
+    if(dict->filter != NULL)
+        counting_filter_free(dict->filter);
+    dict->filter = NULL;
+}
+
+void dictionary_filter_stats(const struct dictionary *dict, size_t *rejected, size_t *passed)
+{
+    assert(dict != NULL);
+
+    *rejected = 0;
+    *passed = 0;
+    if(dict == NULL || dict->filter == NULL) return;
+    counting_filter_stats(dict->filter, rejected, passed);
+}
+
+void dictionary_word_hash_enable(struct dictionary *dict)
+{
+    assert(dict_non_null(dict));
+
+    if(dict->word_hash == NULL)
+        dict->word_hash = word_hash_build(dict->trie_root);
+}
+
+void dictionary_word_hash_disable(struct dictionary *dict)
+{
+    assert(dict_non_null(dict));
+
+    if(dict->word_hash != NULL)
+        word_hash_free(dict->word_hash);
+    dict->word_hash = NULL;
+}
+
+void dictionary_phonetic_index_enable(struct dictionary *dict)
+{
+    assert(dict_non_null(dict));
+
+    if(dict->phonetic_index == NULL)
+        dict->phonetic_index = key_index_build(dict->trie_root, phonetic_key, dict->phonetic_rules);
+}
+
+void dictionary_phonetic_index_disable(struct dictionary *dict)
+{
+    assert(dict_non_null(dict));
+
+    if(dict->phonetic_index != NULL)
+        key_index_free(dict->phonetic_index);
+    dict->phonetic_index = NULL;
+}
+
+void dictionary_set_phonetic_lang(struct dictionary *dict, const char* lang)
+{
+    assert(dict_non_null(dict));
+
+    const Phonetic_Rules* rules = phonetic_rules(lang);
+    if(rules == dict->phonetic_rules)
+        return;
+    dict->phonetic_rules = rules;
+    if(dict->phonetic_index != NULL)
+    {
+        dictionary_phonetic_index_disable(dict);
+        dictionary_phonetic_index_enable(dict);
+    }
+}
+
+/**
+  * Word searched by scanning the dictionary without phonetic index.
+  */
+typedef struct
+{
+    const Phonetic_Rules* rules; ///<Rules of the dictionary.
+    const wchar_t* key; ///<Key of the searched word.
+    Word_List* list; ///<List of found words.
+    size_t found; ///<Number of found words.
+} Sounds_Like_Scan;
+
+///Callback of trie_for_each_word() comparing keys.
+static void sounds_like_visit(const wchar_t* word, const Node* node, void* data)
+{
+    (void) node;
+    Sounds_Like_Scan* scan = data;
+    wchar_t* key = phonetic_key(word, scan->rules);
+    if(wcscmp(key, scan->key) == 0)
+    {
+        word_list_add(scan->list, word);
+        scan->found++;
+    }
+    free(key);
+}
+
+size_t dictionary_sounds_like(const struct dictionary *dict, const wchar_t* word, struct word_list *list)
+{
+    assert(dict_non_null(dict));
+    assert(word_valid(word));
+    assert(list != NULL);
+
+    if(!dict_non_null(dict) || !word_valid(word)) return 0;
+
+    wchar_t* low_word = new_low_wstring(word);
+    size_t ret;
+    if(dict->phonetic_index != NULL)
+        ret = key_index_find_like(dict->phonetic_index, low_word, list);
+    else
+    {
+        wchar_t* key = phonetic_key(low_word, dict->phonetic_rules);
+        Sounds_Like_Scan scan = {dict->phonetic_rules, key, list, 0};
+        trie_for_each_word(dict->trie_root, sounds_like_visit, &scan);
+        ret = scan.found;
+        free(key);
+    }
+    free(low_word);
+    return ret;
+}
+
+void dictionary_anagram_index_enable(struct dictionary *dict)
+{
+    assert(dict_non_null(dict));
+
+    if(dict->anagram_index == NULL)
+        dict->anagram_index = key_index_build(dict->trie_root, anagram_key, NULL);
+}
+
+void dictionary_anagram_index_disable(struct dictionary *dict)
+{
+    assert(dict_non_null(dict));
+
+    if(dict->anagram_index != NULL)
+        key_index_free(dict->anagram_index);
+    dict->anagram_index = NULL;
+}
+
+size_t dictionary_anagrams(const struct dictionary *dict, const wchar_t* word, struct word_list *list)
+{
+    assert(dict_non_null(dict));
+    assert(word_valid(word));
+    assert(list != NULL);
+
+    if(!dict_non_null(dict) || !word_valid(word)) return 0;
+
+    wchar_t* low_word = new_low_wstring(word);
+    size_t ret;
+    if(dict->anagram_index != NULL)
+        ret = key_index_find_like(dict->anagram_index, low_word, list);
+    else
+        ret = anagram_scan_trie(dict->trie_root, low_word, true, list);
+    free(low_word);
+    return ret;
+}
+
+size_t dictionary_formable(const struct dictionary *dict, const wchar_t* letters, struct word_list *list)
+{
+    assert(dict_non_null(dict));
+    assert(word_valid(letters));
+    assert(list != NULL);
+
+    if(!dict_non_null(dict) || !word_valid(letters)) return 0;
+
+    wchar_t* low_letters = new_low_wstring(letters);
+    size_t ret = anagram_find_formable(dict->anagram_index, dict->trie_root, low_letters, list);
+    free(low_letters);
+    return ret;
+}
+
+///Callback of trie_for_each_word() adding reversed words to the trie.
+static void suffix_trie_visit(const wchar_t* word, const Node* node, void* data)
+{
+    (void) node;
+    wchar_t* reversed = malloc(sizeof(wchar_t) * (wcslen(word) + 1));
+    if(reversed == NULL) report_error(MEMORY);
+    wcscpy(reversed, word);
+    reverse_wstring(reversed);
+    trie_insert_word(data, reversed);
+    free(reversed);
+}
+
+void dictionary_suffix_trie_enable(struct dictionary *dict)
+{
+    assert(dict_non_null(dict));
+
+    if(dict->suffix_root != NULL)
+        return;
+    dict->suffix_root = trie_new_node();
+    trie_for_each_word(dict->trie_root, suffix_trie_visit, dict->suffix_root);
+}
+
+void dictionary_suffix_trie_disable(struct dictionary *dict)
+{
+    assert(dict_non_null(dict));
+
+    if(dict->suffix_root != NULL)
+        trie_free_node(dict->suffix_root);
+    dict->suffix_root = NULL;
+}
+
+/**
+  * Words ending with a suffix, collected by dictionary_ends_with().
+  */
+typedef struct
+{
+    const wchar_t* suffix; ///<The suffix.
+    size_t suffix_len; ///<Length of the suffix.
+    wchar_t* word; ///<Buffer for a word.
+    size_t size; ///<Size of the buffer.
+    Word_List* list; ///<List of found words.
+    size_t found; ///<Number of found words.
+} Ends_With;
+
+///Callback of trie_for_each_word() on the subtree of reversed suffix, the word is the reversed rest.
+static void ends_with_visit(const wchar_t* rest, const Node* node, void* data)
+{
+    (void) node;
+    Ends_With* query = data;
+    size_t rest_len = wcslen(rest);
+    if(rest_len + query->suffix_len + 1 > query->size)
+    {
+        query->size = 2 * (rest_len + query->suffix_len + 1);
+        query->word = realloc(query->word, sizeof(wchar_t) * query->size);
+        if(query->word == NULL) report_error(MEMORY);
+    }
+    for(size_t i = 0; i < rest_len; i++)
+        query->word[i] = rest[rest_len - 1 - i];
+    wcscpy(query->word + rest_len, query->suffix);
+    word_list_add(query->list, query->word);
+    query->found++;
+}
+
+///Callback of trie_for_each_word() comparing ends of words with the suffix.
+static void ends_with_scan(const wchar_t* word, const Node* node, void* data)
+{
+    (void) node;
+    Ends_With* query = data;
+    size_t len = wcslen(word);
+    if(len >= query->suffix_len && wcscmp(word + len - query->suffix_len, query->suffix) == 0)
+    {
+        word_list_add(query->list, word);
+        query->found++;
+    }
+}
+
+size_t dictionary_ends_with(const struct dictionary *dict, const wchar_t* suffix, struct word_list *list)
+{
+    assert(dict_non_null(dict));
+    assert(word_valid(suffix));
+    assert(list != NULL);
+
+    if(!dict_non_null(dict) || !word_valid(suffix)) return 0;
+
+    wchar_t* low_suffix = new_low_wstring(suffix);
+    Ends_With query = {low_suffix, wcslen(low_suffix), NULL, 0, list, 0};
+    if(dict->suffix_root == NULL)
+        trie_for_each_word(dict->trie_root, ends_with_scan, &query);
+    else
+    {
+        const Node* node = dict->suffix_root;
+        for(size_t i = query.suffix_len; i > 0 && node != NULL; i--)
+            node = trie_child(node, low_suffix[i-1]);
+        if(node != NULL)
+            trie_for_each_word(node, ends_with_visit, &query);
+    }
+    free(query.word);
+    free(low_suffix);
+    return query.found;
+}
+
+size_t dictionary_word_count(const struct dictionary *dict)
+{
+    assert(dict_non_null(dict));
+
+    return dict_non_null(dict) ? dict->trie_root->word_count : 0;
+}
+
+size_t dictionary_rank(const struct dictionary *dict, const wchar_t* word)
+{
+    assert(dict_non_null(dict));
+    assert(word != NULL);
+
+    if(!dict_non_null(dict) || word == NULL) return 0;
+
+    wchar_t* low_word = new_low_wstring(word);
+    size_t ret = trie_rank(dict->trie_root, low_word);
+    free(low_word);
+    return ret;
+}
+
+wchar_t* dictionary_select(const struct dictionary *dict, size_t rank)
+{
+    assert(dict_non_null(dict));
+
+    if(!dict_non_null(dict)) return NULL;
+
+    const Node* node = trie_select(dict->trie_root, rank);
+    return node == NULL ? NULL : trie_node_word(node);
+}
+
+size_t dictionary_prefix_count(const struct dictionary *dict, const wchar_t* prefix)
+{
+    assert(dict_non_null(dict));
+    assert(prefix != NULL);
+
+    if(!dict_non_null(dict) || prefix == NULL) return 0;
+
+    const Node* node = dict->trie_root;
+    for(size_t i = 0; prefix[i] != L'\0' && node != NULL; i++)
+        node = trie_child(node, (wchar_t) towlower((wint_t) prefix[i]));
+    return node == NULL ? 0 : node->word_count;
+}
+
+wchar_t* dictionary_sample(const struct dictionary *dict, uint64_t* state)
+{
+    assert(dict_non_null(dict));
+    assert(state != NULL);
+
+    if(!dict_non_null(dict) || dict->trie_root->word_count == 0) return NULL;
+
+    //xorshift64*, state must not be 0
+    uint64_t x = *state != 0 ? *state : DICTIONARY_SAMPLE_DEFAULT_SEED;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *state = x;
+    x *= 2685821657736338717ULL;
+    return dictionary_select(dict, (x >> 11) % dict->trie_root->word_count);
+}
+
+size_t dictionary_find_id(const struct dictionary *dict, const wchar_t* word)
+{
+    assert(dict_non_null(dict));
+    assert(word_valid(word));
+
+    if(!dict_non_null(dict) || !word_valid(word)) return DICTIONARY_NO_ID;
+
+    wchar_t* low_word = new_low_wstring(word);
+    size_t ret = DICTIONARY_NO_ID;
+    if(trie_find_word(dict->trie_root, low_word) == TRIE_WORD_FOUND)
+        ret = trie_rank(dict->trie_root, low_word);
+    free(low_word);
+    return ret;
+}
+
+wchar_t* dictionary_word_by_id(const struct dictionary *dict, size_t id)
+{
+    return dictionary_select(dict, id);
+}
+
+/**
+ * @brief add_alphabet Adds letters of the alphabet to alphabet of the dictionary.
+ * @param dict The dictionary.
+ * @param alphabet Set of letters.
+ */
+static void add_alphabet(Dictionary* dict, const Array_Set* alphabet)
+{
+    wchar_t* letters = malloc(sizeof(wchar_t) * (alphabet->element_count + 1));
+    if(letters == NULL) report_error(MEMORY);
+    for(int i = 0; i < alphabet->element_count; i++)
+        letters[i] = *(wchar_t*)alphabet->storage[i];
+    letters[alphabet->element_count] = L'\0';
+    update_alphabet(dict, letters);
+    free(letters);
+}
+
+Dictionary* dictionary_merge(const struct dictionary *a, const struct dictionary *b, int operation)
+{
+    assert(dict_non_null(a));
+    assert(dict_non_null(b));
+
+    if(!dict_non_null(a) || !dict_non_null(b)) return NULL;
+
+    Dictionary* ret = dictionary_new();
+    trie_free_node(ret->trie_root);
+    ret->trie_root = trie_merge(a->trie_root, b->trie_root, operation);
+    ret->phonetic_rules = a->phonetic_rules;
+    //letters of the result are among letters of these alphabets, hints only need a superset
+    add_alphabet(ret, a->alphabet);
+    if(operation == DICTIONARY_UNION)
+        add_alphabet(ret, b->alphabet);
+    return ret;
+}
+
+uint64_t dictionary_hash(const struct dictionary *dict)
+{
+    assert(dict_non_null(dict));
+
+    if(!dict_non_null(dict)) return 0;
+    return trie_hash(dict->trie_root);
+}
+
+/**
+  * Passes words of trie_diff() to a callback of a dictionary query.
+  */
+typedef struct
+{
+    Dictionary_Word_Callback callback; ///<The callback.
+    void* data; ///<Passed to the callback.
+} Diff_Callback;
+
+///Passes the word of the node to the callback of dictionary_diff().
+static void report_diff(const wchar_t* word, const Node* node, void* data)
+{
+    const Diff_Callback* diff = data;
+    diff->callback(word, node->frequency, diff->data);
+}
+
+size_t dictionary_diff(const struct dictionary *from, const struct dictionary *to,
+                       Dictionary_Word_Callback removed, Dictionary_Word_Callback added, void* data)
+{
+    assert(dict_non_null(from));
+    assert(dict_non_null(to));
+    assert(removed != NULL);
+    assert(added != NULL);
+
+    if(!dict_non_null(from) || !dict_non_null(to)) return 0;
+    Diff_Callback removed_data = {removed, data};
+    Diff_Callback added_data = {added, data};
+    return trie_diff(from->trie_root, to->trie_root, report_diff, &removed_data, report_diff, &added_data);
+}
+
+///Writes word to be deleted to the delta file.
+static void save_removed(const wchar_t* word, unsigned frequency, void* data)
+{
+    (void) frequency;
+    fputwc(DELTA_REMOVED_SIGN, data);
+    for(; *word != L'\0'; word++)
+        fputwc(*word, data);
+    fputwc(DELTA_END_SIGN, data);
+}
+
+///Writes word to be inserted with its frequency to the delta file.
+static void save_added(const wchar_t* word, unsigned frequency, void* data)
+{
+    wchar_t digits[4];
+    int digit_count = 0;
+    do
+    {
+        digits[digit_count++] = L'0' + frequency % 10;
+        frequency /= 10;
+    } while(frequency > 0);
+    fputwc(DELTA_ADDED_SIGN, data);
+    while(digit_count > 0)
+        fputwc(digits[--digit_count], data);
+    fputwc(DELTA_FREQUENCY_END_SIGN, data);
+    for(; *word != L'\0'; word++)
+        fputwc(*word, data);
+    fputwc(DELTA_END_SIGN, data);
+}
+
+size_t dictionary_save_delta(const struct dictionary *from, const struct dictionary *to, FILE* file)
+{
+    assert(dict_non_null(from));
+    assert(dict_non_null(to));
+    assert(file != NULL);
+
+    if(!dict_non_null(from) || !dict_non_null(to)) return 0;
+    save_hash(dictionary_hash(from), file);
+    fputwc(DELTA_END_SIGN, file);
+    size_t ret = dictionary_diff(from, to, save_removed, save_added, file);
+    fputwc(DELTA_STOP_SIGN, file);
+    return ret;
+}
+
+/**
+ * @brief read_delta_word Reads the rest of a line of a delta.
+ * @param file The file.
+ * @param buffer Pointer to buffer, grown if needed.
+ * @param size Pointer to size of the buffer.
+ * @return True if a nonempty word ended by DELTA_END_SIGN was read.
+ */
+static bool read_delta_word(FILE* file, wchar_t** buffer, size_t* size)
+{
+    size_t length = 0;
+    wint_t sign;
+    while((sign = fgetwc(file)) != DELTA_END_SIGN)
+    {
+        if(sign == WEOF || sign == L'\0')
+            return false;
+        if(length + 1 >= *size)
+        {
+            *size *= 2;
+            *buffer = realloc(*buffer, sizeof(wchar_t) * (*size));
+            if(*buffer == NULL) report_error(MEMORY);
+        }
+        (*buffer)[length++] = sign;
+    }
+    (*buffer)[length] = L'\0';
+    return length > 0;
+}
+
+/**
+ * @brief read_delta_frequency Reads frequency of a word to be inserted.
+ * @param file The file.
+ * @param frequency Pointer to store the frequency.
+ * @return True if digits ended by DELTA_FREQUENCY_END_SIGN were read.
+ */
+static bool read_delta_frequency(FILE* file, unsigned* frequency)
+{
+    *frequency = 0;
+    int digit_count = 0;
+    wint_t sign;
+    while((sign = fgetwc(file)) >= L'0' && sign <= L'9')
+    {
+        *frequency = *frequency * 10 + (sign - L'0');
+        if(*frequency > DICTIONARY_MAX_FREQUENCY)
+            return false;
+        digit_count++;
+    }
+    return digit_count > 0 && sign == DELTA_FREQUENCY_END_SIGN;
+}
+
+/**
+  * Change read from a line of a delta.
+  */
+typedef struct
+{
+    wchar_t* word; ///<The word.
+    unsigned frequency; ///<Frequency of the word to be inserted.
+    bool removed; ///<True if the word is to be deleted.
+} Delta_Line;
+
+/**
+ * @brief read_delta_lines Reads lines of a delta up to its end or the first broken line.
+ * @param file The file, after the hash of a delta or at the beginning of a journal.
+ * @param lines Pointer to store the array of read lines, deallocated by free_delta_lines().
+ * @param end Pointer to store the sign after the read lines: DELTA_STOP_SIGN,
+ * WEOF at the end of the file or the first sign of a broken line.
+ * @return Number of read lines.
+ */
+static size_t read_delta_lines(FILE* file, Delta_Line** lines, wint_t* end)
+{
+    size_t size = TRIE_WORD_BUFFER_START_SIZE;
+    wchar_t* word = malloc(sizeof(wchar_t) * size);
+    if(word == NULL) report_error(MEMORY);
+    size_t capacity = 0;
+    size_t ret = 0;
+    *lines = NULL;
+    while((*end = fgetwc(file)) != DELTA_STOP_SIGN && *end != WEOF)
+    {
+        Delta_Line line;
+        line.frequency = 0;
+        line.removed = *end == DELTA_REMOVED_SIGN;
+        if(!(line.removed || (*end == DELTA_ADDED_SIGN && read_delta_frequency(file, &line.frequency)))
+           || !read_delta_word(file, &word, &size))
+            break;
+        if(ret == capacity)
+        {
+            capacity = capacity == 0 ? TRIE_WORD_BUFFER_START_SIZE : 2 * capacity;
+            *lines = realloc(*lines, sizeof(Delta_Line) * capacity);
+            if(*lines == NULL) report_error(MEMORY);
+        }
+        line.word = malloc(sizeof(wchar_t) * (wcslen(word) + 1));
+        if(line.word == NULL) report_error(MEMORY);
+        wcscpy(line.word, word);
+        (*lines)[ret++] = line;
+    }
+    free(word);
+    return ret;
+}
+
+/**
+ * @brief apply_delta_lines Applies lines read by read_delta_lines().
+ * @param dict The dictionary.
+ * @param lines The lines.
+ * @param count Number of the lines.
+ */
+static void apply_delta_lines(Dictionary* dict, const Delta_Line* lines, size_t count)
+{
+    for(size_t i = 0; i < count; i++)
+    {
+        if(lines[i].removed)
+            dictionary_delete(dict, lines[i].word);
+        else
+        {
+            dictionary_insert(dict, lines[i].word);
+            dictionary_set_frequency(dict, lines[i].word, lines[i].frequency);
+        }
+    }
+}
+
+/**
+ * @brief free_delta_lines Deallocates lines read by read_delta_lines().
+ * @param lines The lines.
+ * @param count Number of the lines.
+ */
+static void free_delta_lines(Delta_Line* lines, size_t count)
+{
+    for(size_t i = 0; i < count; i++)
+        free(lines[i].word);
+    free(lines);
+}
+
+int dictionary_apply_delta(struct dictionary *dict, FILE* file)
+{
+    assert(dict_non_null(dict));
+    assert(file != NULL);
+
+    if(!dict_non_null(dict)) return DICTIONARY_DELTA_INVALID;
+    uint64_t base;
+    if(load_hash(file, &base) < 0 || fgetwc(file) != DELTA_END_SIGN || base != dictionary_hash(dict))
+        return DICTIONARY_DELTA_INVALID;
+
+    //nothing is applied unless the whole delta is valid, so it can be retried
+    Delta_Line* lines;
+    wint_t end;
+    size_t count = read_delta_lines(file, &lines, &end);
+    if(end == DELTA_STOP_SIGN)
+        apply_delta_lines(dict, lines, count);
+    free_delta_lines(lines, count);
+    return end == DELTA_STOP_SIGN ? (int) count : DICTIONARY_DELTA_INVALID;
+}
+
+void dictionary_journal_enable(struct dictionary *dict, size_t threshold)
+{
+    assert(dict_non_null(dict));
+
+    if(!dict_non_null(dict)) return;
+    if(dict->journal == NULL)
+    {
+        dict->journal = malloc(sizeof(Dictionary_Journal));
+        if(dict->journal == NULL) report_error(MEMORY);
+        dict->journal->path = NULL;
+        word_list_init(&dict->journal->changed);
+        dict->journal->base_hash = 0;
+        dict->journal->line_count = 0;
+        dict->journal->broken = false;
+    }
+    dict->journal->threshold = threshold;
+}
+
+void dictionary_journal_disable(struct dictionary *dict)
+{
+    assert(dict_non_null(dict));
+
+    if(!dict_non_null(dict) || dict->journal == NULL) return;
+    free(dict->journal->path);
+    word_list_done(&dict->journal->changed);
+    free(dict->journal);
+    dict->journal = NULL;
+}
+
+void dictionary_find_cache_enable(struct dictionary *dict, size_t entry_count)
+{
+    assert(dict_non_null(dict));
+
+    if(!dict_non_null(dict)) return;
+    dictionary_find_cache_disable(dict);
+    dict->find_cache = find_cache_new(entry_count);
+    dict->find_cache->generation = dict->generation;
+}
+
+void dictionary_find_cache_disable(struct dictionary *dict)
+{
+    assert(dict_non_null(dict));
+
+    if(dict->find_cache != NULL)
+        find_cache_free(dict->find_cache);
+    dict->find_cache = NULL;
+}
+
+void dictionary_find_cache_stats(const struct dictionary *dict, size_t *hits, size_t *misses)
+{
+    assert(dict != NULL);
+
+    *hits = 0;
+    *misses = 0;
+    if(dict == NULL || dict->find_cache == NULL) return;
+    find_cache_stats(dict->find_cache, hits, misses);
+}
+
+Dictionary_Cursor* dictionary_cursor_new(const struct dictionary *dict)
+{
+    assert(dict_non_null(dict));
+
+    Dictionary_Cursor* ret = malloc(sizeof(Dictionary_Cursor));
+    if(ret == NULL) report_error(MEMORY);
+    ret->dict = dict;
+    ret->size = TRIE_WORD_BUFFER_START_SIZE;
+    ret->prefix = malloc(sizeof(wchar_t) * ret->size);
+    if(ret->prefix == NULL) report_error(MEMORY);
+    dictionary_cursor_reset(ret);
+    return ret;
+}
+
+void dictionary_cursor_free(Dictionary_Cursor* cursor)
+{
+    assert(cursor != NULL);
+    free(cursor->prefix);
+    free(cursor);
+}
+
+void dictionary_cursor_reset(Dictionary_Cursor* cursor)
+{
+    assert(cursor != NULL);
+
+    cursor->node = cursor->dict->trie_root;
+    cursor->generation = cursor->dict->generation;
+    cursor->length = 0;
+    cursor->alive_length = 0;
+    cursor->prefix[0] = L'\0';
+}
+
+/**
+ * @brief cursor_sync Finds node of the cursor again, if dictionary was modified.
+ * @param cursor The cursor.
+ */
+static void cursor_sync(Dictionary_Cursor* cursor)
+{
+    if(cursor->generation == cursor->dict->generation)
+        return;
+    cursor->generation = cursor->dict->generation;
+    cursor->node = cursor->dict->trie_root;
+    cursor->alive_length = 0;
+    const Node* child;
+    while(cursor->alive_length < cursor->length
+          && (child = trie_child(cursor->node, cursor->prefix[cursor->alive_length])) != NULL)
+    {
+        cursor->node = child;
+        cursor->alive_length++;
+    }
+}
+
+bool dictionary_cursor_advance(Dictionary_Cursor* cursor, wchar_t letter)
+{
+    assert(cursor != NULL);
+
+    cursor_sync(cursor);
+    if(cursor->length + 1 >= cursor->size)
+    {
+        cursor->size *= 2;
+        cursor->prefix = realloc(cursor->prefix, sizeof(wchar_t) * cursor->size);
+        if(cursor->prefix == NULL) report_error(MEMORY);
+    }
+    letter = (wchar_t) towlower((wint_t) letter);
+    cursor->prefix[cursor->length] = letter;
+    cursor->prefix[cursor->length + 1] = L'\0';
+    if(cursor->length++ == cursor->alive_length)
+    {
+        const Node* child = trie_child(cursor->node, letter);
+        if(child != NULL)
+        {
+            cursor->node = child;
+            cursor->alive_length++;
+        }
+    }
+    return cursor->length == cursor->alive_length;
+}
+
+bool dictionary_cursor_back(Dictionary_Cursor* cursor)
+{
+    assert(cursor != NULL);
+
+    if(cursor->length == 0)
+        return false;
+    cursor_sync(cursor);
+    if(cursor->length-- == cursor->alive_length)
+    {
+        cursor->node = cursor->node->parent;
+        cursor->alive_length--;
+    }
+    cursor->prefix[cursor->length] = L'\0';
+    return true;
+}
+
+bool dictionary_cursor_is_word(Dictionary_Cursor* cursor)
+{
+    assert(cursor != NULL);
+
+    cursor_sync(cursor);
+    return cursor->length == cursor->alive_length && cursor->node->is_word;
+}
+
+bool dictionary_cursor_has_children(Dictionary_Cursor* cursor)
+{
+    assert(cursor != NULL);
+
+    cursor_sync(cursor);
+    return cursor->length == cursor->alive_length && cursor->node->children->element_count > 0;
+}
+
+/**
+  * Words collected by collect_completions().
+  */
+typedef struct
+{
+    wchar_t* word; ///<Buffer with the current word.
+    size_t size; ///<Size of the buffer.
+    size_t limit; ///<Maximal number of collected words.
+    Word_List* list; ///<List of collected words.
+    size_t found; ///<Number of collected words.
+} Completions;
+
+/**
+ * @brief collect_completions Adds words of the subtree to the list in alphabetical order.
+ * @param node Root of the subtree.
+ * @param depth Length of the word of the node, already in the buffer.
+ * @param completions Collected words.
+ */
+static void collect_completions(const Node* node, size_t depth, Completions* completions)
+{
+    if(depth + 1 >= completions->size)
+    {
+        completions->size *= 2;
+        completions->word = realloc(completions->word, sizeof(wchar_t) * completions->size);
+        if(completions->word == NULL) report_error(MEMORY);
+    }
+    if(node->is_word && completions->found < completions->limit)
+    {
+        completions->word[depth] = L'\0';
+        word_list_add(completions->list, completions->word);
+        completions->found++;
+    }
+    for(int i = 0; i < node->children->element_count && completions->found < completions->limit; i++)
+    {
+        const Node* child = node->children->storage[i];
+        completions->word[depth] = child->value;
+        collect_completions(child, depth + 1, completions);
+    }
+}
+
+size_t dictionary_cursor_completions(Dictionary_Cursor* cursor, size_t limit, struct word_list *list)
+{
+    assert(cursor != NULL);
+    assert(list != NULL);
+
+    cursor_sync(cursor);
+    if(cursor->length != cursor->alive_length || limit == 0)
+        return 0;
+    Completions completions = {NULL, cursor->size, limit, list, 0};
+    completions.word = malloc(sizeof(wchar_t) * completions.size);
+    if(completions.word == NULL) report_error(MEMORY);
+    wmemcpy(completions.word, cursor->prefix, cursor->length);
+    collect_completions(cursor->node, cursor->length, &completions);
+    free(completions.word);
+    return completions.found;
+}
+
+Dictionary_Iterator* dictionary_iterator_new(const struct dictionary *dict)
+{
+    assert(dict_non_null(dict));
+
+    Dictionary_Iterator* ret = malloc(sizeof(Dictionary_Iterator));
+    if(ret == NULL) report_error(MEMORY);
+    ret->dict = dict;
+    ret->generation = dict->generation;
+    ret->key = NULL;
+    ret->returned = false;
+    trie_iterator_init(&ret->trie, dict->trie_root);
+    return ret;
+}
+
+void dictionary_iterator_free(Dictionary_Iterator* iterator)
+{
+    assert(iterator != NULL);
+    trie_iterator_done(&iterator->trie);
+    free(iterator->key);
+    free(iterator);
+}
+
+void dictionary_iterator_seek(Dictionary_Iterator* iterator, const wchar_t* key)
+{
+    assert(iterator != NULL);
+    assert(key != NULL);
+
+    free(iterator->key);
+    iterator->key = new_low_wstring(key);
+    iterator->returned = false;
+    iterator->generation = iterator->dict->generation;
+    trie_iterator_seek(&iterator->trie, iterator->key);
+}
+
+/**
+ * @brief iterator_sync Finds position of the iterator again, if dictionary was modified.
+ * @param iterator The iterator.
+ */
+static void iterator_sync(Dictionary_Iterator* iterator)
+{
+    if(iterator->generation == iterator->dict->generation)
+        return;
+    iterator->generation = iterator->dict->generation;
+    if(!iterator->returned)
+    {
+        trie_iterator_seek(&iterator->trie, iterator->key != NULL ? iterator->key : L"");
+        return;
+    }
+    //the buffer holds the last word and is long enough to be sought in place
+    trie_iterator_seek(&iterator->trie, iterator->trie.word);
+    iterator->trie.pending = false;
+}
+
+const wchar_t* dictionary_iterator_next(Dictionary_Iterator* iterator)
+{
+    assert(iterator != NULL);
+
+    iterator_sync(iterator);
+    const wchar_t* ret = trie_iterator_next(&iterator->trie);
+    if(ret != NULL)
+        iterator->returned = true;
+    return ret;
+}
+
+/**
+  * Entry of the frontier of dictionary_complete().
+  * Frontier is ordered by bound of frequency (descending), then depth, words before subtrees.
+  */
+typedef struct
+{
+    const Node* node; ///<The node.
+    size_t depth; ///<Length of the word of the node.
+    unsigned bound; ///<Frequency of the word or greatest frequency in the subtree.
+    bool word; ///<True if entry stands for the word of the node, not the subtree.
+    size_t order; ///<Number of creation, makes the order linear.
+} Completion_Entry;
+
+/**
+  * Completion found by dictionary_complete().
+  */
+typedef struct
+{
+    wchar_t* word; ///<The word.
+    size_t depth; ///<Length of the word.
+    unsigned frequency; ///<Frequency of the word.
+    unsigned bound; ///<Frequency used for ranking, 0 if ranked by length.
+} Completion;
+
+///Compares entries of the frontier of dictionary_complete().
+static int cmp_completion_entry(void* a, void* b)
+{
+    const Completion_Entry* x = a;
+    const Completion_Entry* y = b;
+    if(x->bound != y->bound)
+        return x->bound > y->bound ? -1 : 1;
+    if(x->depth != y->depth)
+        return x->depth < y->depth ? -1 : 1;
+    if(x->word != y->word)
+        return x->word ? -1 : 1;
+    return x->order < y->order ? -1 : (x->order > y->order);
+}
+
+///Compares completions, the best first.
+static int cmp_completion(const void* a, const void* b)
+{
+    const Completion* x = a;
+    const Completion* y = b;
+    if(x->bound != y->bound)
+        return x->bound > y->bound ? -1 : 1;
+    if(x->depth != y->depth)
+        return x->depth < y->depth ? -1 : 1;
+    return wcscmp(x->word, y->word);
+}
+
+///Creates entry of the frontier of dictionary_complete().
+static Completion_Entry* new_completion_entry(const Node* node, size_t depth, unsigned bound, bool word, size_t* order)
+{
+    Completion_Entry* ret = malloc(sizeof(Completion_Entry));
+    if(ret == NULL) report_error(MEMORY);
+    ret->node = node;
+    ret->depth = depth;
+    ret->bound = bound;
+    ret->word = word;
+    ret->order = (*order)++;
+    return ret;
+}
+
+size_t dictionary_complete(const struct dictionary *dict, const wchar_t* prefix, size_t k, int order,
+                           Dictionary_Word_Callback callback, void* data)
+{
+    assert(dict_non_null(dict));
+    assert(prefix != NULL);
+    assert(order == DICTIONARY_COMPLETE_BY_FREQUENCY || order == DICTIONARY_COMPLETE_BY_LENGTH);
+    assert(callback != NULL);
+
+    if(!dict_non_null(dict) || prefix == NULL || callback == NULL || k == 0)
+        return 0;
+    const Node* node = dict->trie_root;
+    size_t depth = 0;
+    for(; prefix[depth] != L'\0' && node != NULL; depth++)
+        node = trie_child(node, (wchar_t) towlower((wint_t) prefix[depth]));
+    if(node == NULL)
+        return 0;
+    const bool by_frequency = (order == DICTIONARY_COMPLETE_BY_FREQUENCY);
+
+    size_t created = 0;
+    Heap* frontier = heap_new(cmp_completion_entry);
+    heap_push(frontier, new_completion_entry(node, depth, by_frequency ? node->max_frequency : 0, false, &created));
+    Completion* found = malloc(sizeof(Completion) * k);
+    if(found == NULL) report_error(MEMORY);
+    size_t found_count = 0;
+    size_t found_size = k;
+
+    Completion_Entry* entry;
+    while((entry = heap_pop(frontier)) != NULL)
+    {
+        if(found_count >= k) //completions equal to the k-th one are still collected to sort them alphabetically
+        {
+            const Completion* kth = &found[k-1];
+            if(entry->bound < kth->bound || (entry->bound == kth->bound && entry->depth > kth->depth))
+            {
+                free(entry);
+                break;
+            }
+        }
+        if(entry->word)
+        {
+            if(found_count == found_size)
+            {
+                found_size *= 2;
+                found = realloc(found, sizeof(Completion) * found_size);
+                if(found == NULL) report_error(MEMORY);
+            }
+            found[found_count].word = trie_node_word(entry->node);
+            found[found_count].depth = entry->depth;
+            found[found_count].frequency = entry->node->frequency;
+            found[found_count].bound = entry->bound;
+            found_count++;
+            free(entry);
+            continue;
+        }
+        const Node* current = entry->node;
+        if(current->is_word)
+            heap_push(frontier, new_completion_entry(current, entry->depth, by_frequency ? current->frequency : 0,
+                                                     true, &created));
+        for(int i = 0; i < current->children->element_count; i++)
+        {
+            const Node* child = current->children->storage[i];
+            heap_push(frontier, new_completion_entry(child, entry->depth + 1, by_frequency ? child->max_frequency : 0,
+                                                     false, &created));
+        }
+        free(entry);
+    }
+    while((entry = heap_pop(frontier)) != NULL)
+        free(entry);
+    heap_free(frontier);
+
+    qsort(found, found_count, sizeof(Completion), cmp_completion);
+    size_t reported = found_count < k ? found_count : k;
+    for(size_t i = 0; i < found_count; i++)
+    {
+        if(i < reported)
+            callback(found[i].word, found[i].frequency, data);
+        free(found[i].word);
+    }
+    free(found);
+    return reported;
+}
+
+/**
+  * Callback of a query on the dictionary, called by trie_for_each_word() like functions.
+  */
+typedef struct
+{
+    Dictionary_Word_Callback callback; ///<The callback.
+    void* data; ///<Its user data.
+} Word_Callback_Data;
+
+///Passes the word of the node to the callback of the query.
+static void report_word(const wchar_t* word, const Node* node, void* data)
+{
+    const Word_Callback_Data* query = data;
+    query->callback(word, node->frequency, query->data);
+}
+
+int dictionary_match(const struct dictionary *dict, const wchar_t* pattern,
+                     Dictionary_Word_Callback callback, void* data)
+{
+    assert(dict_non_null(dict));
+    assert(pattern != NULL);
+    assert(callback != NULL);
+
+    if(!dict_non_null(dict) || pattern == NULL || callback == NULL)
+        return DICTIONARY_PATTERN_INVALID;
+    wchar_t* low_pattern = new_low_wstring(pattern);
+    Pattern* compiled = pattern_new(low_pattern);
+    free(low_pattern);
+    if(compiled == NULL)
+        return DICTIONARY_PATTERN_INVALID;
+    Word_Callback_Data query = {callback, data};
+    size_t found = pattern_match_trie(compiled, dict->trie_root, report_word, &query);
+    pattern_free(compiled);
+    return found;
+}
+
+int dictionary_match_regex(const struct dictionary *dict, const wchar_t* regex,
+                           Dictionary_Word_Callback callback, void* data)
+{
+    assert(dict_non_null(dict));
+    assert(regex != NULL);
+    assert(callback != NULL);
+
+    if(!dict_non_null(dict) || regex == NULL || callback == NULL)
+        return DICTIONARY_PATTERN_INVALID;
+    size_t alphabet_size = dict->alphabet->element_count;
+    wchar_t* alphabet = malloc(sizeof(wchar_t) * (alphabet_size + 1));
+    if(alphabet == NULL) report_error(MEMORY);
+    for(size_t i = 0; i < alphabet_size; i++)
+        alphabet[i] = *(wchar_t*)dict->alphabet->storage[i];
+    wchar_t* low_regex = new_low_wstring(regex);
+    Automaton* automaton = automaton_new(low_regex, alphabet, alphabet_size);
+    free(low_regex);
+    free(alphabet);
+    if(automaton == NULL)
+        return DICTIONARY_PATTERN_INVALID;
+    Word_Callback_Data query = {callback, data};
+    size_t found = automaton_match_trie(automaton, dict->trie_root, report_word, &query);
+    automaton_free(automaton);
+    return found;
+}
+
+///Suffixes of names of files kept next to dictionaries, which are not dictionaries themselves.
+static const char* auxiliary_suffixes[] = {DICTIONARY_COSTS_SUFFIX, DICTIONARY_PHONETIC_SUFFIX,
+                                           DICTIONARY_ANAGRAM_SUFFIX, DICTIONARY_JOURNAL_SUFFIX,
+                                           DICTIONARY_TEMPORARY_SUFFIX};
+
+/**
+ * @brief is_auxiliary_file Tests whether file in CONF_PATH belongs to a dictionary, but is not one.
+ * @param name Name of the file.
+ * @return True if name ends with one of auxiliary_suffixes.
+ */
+static bool is_auxiliary_file(const char* name)
+{
+    size_t name_len = strlen(name);
+    for(size_t i = 0; i < sizeof(auxiliary_suffixes) / sizeof(char*); i++)
+    {
+        size_t suffix_len = strlen(auxiliary_suffixes[i]);
+        if(name_len > suffix_len && strcmp(name + name_len - suffix_len, auxiliary_suffixes[i]) == 0)
+            return true;
+    }
+    return false;
+}
+
+int dictionary_lang_list(char** list, size_t *list_len)
+{
+    DIR* main_dir = opendir(CONF_PATH);
+    if(main_dir == NULL) return -1;
+
+    Word_List* buffer = word_list_new();
+    struct dirent* current_element;
+    *list_len = 0;
+    while((current_element = readdir(main_dir)) != NULL)
+    {
+        if(current_element->d_type != DT_REG) //if not file, then skipping
+            continue;
+        if(is_auxiliary_file(current_element->d_name))
+            continue;
+
+        int name_len = strlen(current_element->d_name);
+        wchar_t* wname = malloc(sizeof(wchar_t) * (name_len + 1));
+        if(wname == NULL) report_error(MEMORY);
+        for(int i = 0; i <= name_len; i++) //copy including \0
+            wname[i] = current_element->d_name[i];
+
+        *list_len += name_len + 1;
+        word_list_add(buffer, wname);
+    }
+    //for example list may contain
+    //"pl_PL\0en_US\0"
+    *list = malloc(sizeof(char) * (*list_len));
+    if(*list == NULL) report_error(MEMORY);
+    int pos_in_list = 0;
+    int curr_word_len;
+    struct word_node* current_node = buffer->first;
+    while(current_node != NULL) //travel by all nodes in list
+    {
+        curr_word_len = wcslen(current_node->word);
+        for(int i = 0; i <= curr_word_len; i++)
+            (*list)[pos_in_list++] = current_node->word[i];
+        current_node = current_node->next;
+    }
+    assert(pos_in_list == *list_len);
+    return 0;
+}
+
+/**
+ * @brief strcat3 Concatenate three strings.
+ * @param str1 String one.
+ * @param str2 String two.
+ * @param str3 String three.
+ * @return str1+str2+str3
+ */
+static char* strcat3(char* str1, char* str2, char* str3)
+{
+    int len1 = strlen(str1);
+    int len2 = strlen(str2);
+    int len3 = strlen(str3);
+    char* ret = malloc(sizeof(char) * (len1+len2+len3+1));
+    if(ret == NULL) report_error(MEMORY);
+    int global_pos = 0;
+    for(int i = 0; i < len1; i++)
+        ret[global_pos + i] = str1[i];
+    global_pos += len1;
+    for(int i = 0; i < len2; i++)
+        ret[global_pos + i] = str2[i];
+    global_pos += len2;
+    for(int i = 0; i < len3; i++)
+        ret[global_pos + i] = str3[i];
+    global_pos += len3;
+    ret[global_pos] = 0;
+    return ret;
+
+}
+
+/**
+ * @brief load_costs Loads edit costs of the language, if its file exists.
+ * @param dict Dictionary of the language.
+ * @param lang Name of the language.
+ */
+static void load_costs(Dictionary* dict, char* lang)
+{
+    char* full_path = strcat3(CONF_PATH "/", lang, DICTIONARY_COSTS_SUFFIX);
+    FILE* costs_file = fopen(full_path, "r");
+    free(full_path);
+    if(costs_file == NULL)
+        return;
+    Edit_Costs* costs = edit_costs_load(costs_file);
+    fclose(costs_file);
+    if(costs != NULL)
+        dictionary_set_costs(dict, costs);
+}
+
+/**
+ * @brief index_hash_matches Reads the hash of words starting a saved index and compares it.
+ * @param file File of the index.
+ * @param hash Hash of words of the dictionary file, see dictionary_hash().
+ * @return True if the index was saved with the dictionary file of the hash.
+ */
+static bool index_hash_matches(FILE* file, uint64_t hash)
+{
+    uint64_t saved_hash;
+    return load_hash(file, &saved_hash) == 0 && fgetwc(file) == DELTA_END_SIGN && saved_hash == hash;
+}
+
+/**
+ * @brief load_key_index Loads saved index of words of the language, if it exists.
+ * @param root Root of the trie of the dictionary file, to build the index again.
+ * @param lang Name of the language.
+ * @param suffix Suffix of the name of the file of the index.
+ * @param key_function Function computing keys of the index.
+ * @param key_data Passed to key_function.
+ * @return Pointer to the index or NULL if it is not saved.
+ * An index saved with another version of the dictionary file, for example one changed
+ * by another program, or a broken one is built again from the trie.
+ */
+static Key_Index* load_key_index(Node* root, char* lang, char* suffix, Key_Function key_function,
+                                 const void* key_data)
+{
+    char* full_path = strcat3(CONF_PATH "/", lang, suffix);
+    FILE* index_file = fopen(full_path, "r");
+    free(full_path);
+    if(index_file == NULL)
+        return NULL;
+    Key_Index* ret = NULL;
+    if(index_hash_matches(index_file, trie_hash(root)))
+        ret = key_index_load(index_file, key_function, key_data);
+    fclose(index_file);
+    if(ret == NULL)
+        ret = key_index_build(root, key_function, key_data);
+    return ret;
+}
+
+/**
+ * @brief save_key_index Saves index of words of the language or removes the stale one.
+ * @param index The index or NULL if disabled.
+ * @param hash Hash of words of the saved dictionary file, written before the index.
+ * @param lang Name of the language.
+ * @param suffix Suffix of the name of the file of the index.
+ */
+static void save_key_index(const Key_Index* index, uint64_t hash, const char* lang, char* suffix)
+{
+    char* full_path = strcat3(CONF_PATH "/", (char*) lang, suffix);
+    if(index == NULL)
+        remove(full_path); //saved index would be stale
+    else
+    {
+        FILE* index_file = fopen(full_path, "w");
+        if(index_file != NULL)
+        {
+            save_hash(hash, index_file);
+            fputwc(DELTA_END_SIGN, index_file);
+            key_index_save(index, index_file);
+            fclose(index_file);
+        }
+    }
+    free(full_path);
+}
+
+/**
+ * @brief load_phonetic_index Sets phonetic rules of the language and loads its index, if saved.
+ * @param dict Dictionary of the language, as loaded from its file.
+ * @param lang Name of the language.
+ */
+static void load_phonetic_index(Dictionary* dict, char* lang)
+{
+    dictionary_set_phonetic_lang(dict, lang);
+    dict->phonetic_index = load_key_index(dict->trie_root, lang, DICTIONARY_PHONETIC_SUFFIX, phonetic_key,
+                                          dict->phonetic_rules);
+}
+
+/**
+ * @brief file_exists Tests whether the file can be read.
+ * @param path Name of the file.
+ * @return True if the file exists and can be opened.
+ */
+static bool file_exists(const char* path)
+{
+    FILE* file = fopen(path, "r");
+    if(file == NULL)
+        return false;
+    fclose(file);
+    return true;
+}
+
+/**
+ * @brief key_index_saved Tests whether saved index of the language matches the enabled one.
+ * @param index The index or NULL if disabled.
+ * @param hash Hash of words of the dictionary file.
+ * @param lang Name of the language.
+ * @param suffix Suffix of the name of the file of the index.
+ * @return True if the file of the index exists exactly when the index is enabled
+ * and it was saved with the dictionary file.
+ */
+static bool key_index_saved(const Key_Index* index, uint64_t hash, const char* lang, char* suffix)
+{
+    char* full_path = strcat3(CONF_PATH "/", (char*) lang, suffix);
+    bool ret;
+    if(index == NULL)
+        ret = !file_exists(full_path);
+    else
+    {
+        FILE* index_file = fopen(full_path, "r");
+        ret = index_file != NULL && index_hash_matches(index_file, hash);
+        if(index_file != NULL)
+            fclose(index_file);
+    }
+    free(full_path);
+    return ret;
+}
+
+/**
+ * @brief journal_appendable Tests whether saving dictionary to the file may only append changes.
+ * @param dict The dictionary.
+ * @param path Name of the dictionary file.
+ * @return True if the journal belongs to the file, is not broken and stays within its threshold.
+ */
+static bool journal_appendable(const Dictionary* dict, const char* path)
+{
+    const Dictionary_Journal* journal = dict->journal;
+    return journal != NULL && journal->path != NULL && strcmp(journal->path, path) == 0 && !journal->broken
+           && journal->line_count + word_list_size(&journal->changed) <= journal->threshold;
+}
+
+/**
+ * @brief append_journal Appends current state of every changed word to the journal file.
+ * @param dict The dictionary, with the journal appendable.
+ * @return DICTIONARY_SAVE_SUCCESS or DICTIONARY_SAVE_FAILURE.
+ * The first lines start a new journal file, which replaces a journal of another dictionary file.
+ */
+static int append_journal(Dictionary* dict)
+{
+    Dictionary_Journal* journal = dict->journal;
+    if(word_list_size(&journal->changed) == 0)
+        return DICTIONARY_SAVE_SUCCESS;
+    char* journal_path = strcat3(journal->path, DICTIONARY_JOURNAL_SUFFIX, "");
+    FILE* file = fopen(journal_path, journal->line_count == 0 ? "w" : "a");
+    free(journal_path);
+    if(file == NULL)
+        return DICTIONARY_SAVE_FAILURE;
+    if(journal->line_count == 0)
+    {
+        save_hash(journal->base_hash, file);
+        fputwc(DELTA_END_SIGN, file);
+    }
+    for(struct word_node* node = journal->changed.first; node != NULL; node = node->next)
+    {
+        if(trie_find_word(dict->trie_root, node->word) == TRIE_WORD_FOUND)
+            save_added(node->word, trie_get_frequency(dict->trie_root, node->word), file);
+        else
+            save_removed(node->word, 0, file);
+    }
+    bool failed = ferror(file) != 0;
+    failed = fclose(file) != 0 || failed;
+    if(failed)
+    {
+        journal->broken = true; //the last line may be written partially
+        return DICTIONARY_SAVE_FAILURE;
+    }
+    journal->line_count += word_list_size(&journal->changed);
+    word_list_done(&journal->changed);
+    return DICTIONARY_SAVE_SUCCESS;
+}
+
+/**
+ * @brief save_whole_file Writes the whole dictionary file and removes its journal.
+ * @param dict The dictionary.
+ * @param path Name of the dictionary file.
+ * @return DICTIONARY_SAVE_SUCCESS or DICTIONARY_SAVE_FAILURE.
+ * The dictionary is written to a temporary file renamed to path, so the previous file stays
+ * if writing fails. The hash of words is saved too, so a journal left by an interrupted save
+ * is not replayed on the new file.
+ */
+static int save_whole_file(Dictionary* dict, const char* path)
+{
+    uint64_t hash = dictionary_hash(dict);
+    char* temporary_path = strcat3((char*) path, DICTIONARY_TEMPORARY_SUFFIX, "");
+    FILE* file = fopen(temporary_path, "w");
+    if(file == NULL)
+    {
+        free(temporary_path);
+        return DICTIONARY_SAVE_FAILURE;
+    }
+    dictionary_save(dict, file);
+    bool failed = ferror(file) != 0;
+    failed = fclose(file) != 0 || failed;
+    if(failed || rename(temporary_path, path) != 0)
+    {
+        remove(temporary_path);
+        free(temporary_path);
+        return DICTIONARY_SAVE_FAILURE;
+    }
+    free(temporary_path);
+    char* journal_path = strcat3((char*) path, DICTIONARY_JOURNAL_SUFFIX, "");
+    remove(journal_path);
+    free(journal_path);
+
+    Dictionary_Journal* journal = dict->journal;
+    if(journal != NULL)
+    {
+        free(journal->path);
+        journal->path = strcat3((char*) path, "", "");
+        word_list_done(&journal->changed);
+        journal->base_hash = hash;
+        journal->line_count = 0;
+        journal->broken = false;
+    }
+    return DICTIONARY_SAVE_SUCCESS;
+}
+
+/**
+ * @brief replay_journal Applies the journal of the loaded dictionary file and enables the journal.
+ * @param dict The dictionary, just loaded.
+ * @param path Name of the dictionary file.
+ */
+static void replay_journal(Dictionary* dict, const char* path)
+{
+    uint64_t hash = dictionary_hash(dict); //saved in the file, unless it is an old one
+    size_t line_count = 0;
+    bool broken = false;
+    char* journal_path = strcat3((char*) path, DICTIONARY_JOURNAL_SUFFIX, "");
+    FILE* file = fopen(journal_path, "r");
+    free(journal_path);
+    if(file != NULL)
+    {
+        uint64_t base_hash;
+        if(load_hash(file, &base_hash) == 0 && fgetwc(file) == DELTA_END_SIGN && base_hash == hash)
+        {
+            //lines before a broken one were saved completely
+            Delta_Line* lines;
+            wint_t end;
+            line_count = read_delta_lines(file, &lines, &end);
+            apply_delta_lines(dict, lines, line_count);
+            free_delta_lines(lines, line_count);
+            broken = end != WEOF;
+        }
+        fclose(file);
+    }
+    dictionary_journal_enable(dict, DICTIONARY_JOURNAL_DEFAULT_THRESHOLD);
+    dict->journal->path = strcat3((char*) path, "", "");
+    dict->journal->base_hash = hash;
+    dict->journal->line_count = line_count;
+    dict->journal->broken = broken;
+}
+
+int dictionary_save_file(struct dictionary *dict, const char* path)
+{
+    assert(dict_non_null(dict));
+    assert(path != NULL);
+
+    if(!dict_non_null(dict) || path == NULL) return DICTIONARY_SAVE_FAILURE;
+    if(journal_appendable(dict, path))
+        return append_journal(dict);
+    return save_whole_file(dict, path);
+}
+
+Dictionary* dictionary_load_file(const char* path)
+{
+    assert(path != NULL);
+
+    FILE* file = fopen(path, "r");
+    if(file == NULL)
+        return NULL;
+    Dictionary* ret = dictionary_load(file);
+    fclose(file);
+    if(ret != NULL && !dict_non_null(ret)) //malformed file
+    {
+        if(ret->trie_root != NULL)
+            trie_free_node(ret->trie_root);
+        if(ret->alphabet != NULL)
+            set_free(ret->alphabet);
+        free(ret);
+        return NULL;
+    }
+    if(ret != NULL)
+        replay_journal(ret, path);
+    return ret;
+}
+
+Dictionary* dictionary_load_lang(const char* lang)
+{
+    DIR* main_dir = opendir(CONF_PATH);
+    if(main_dir == NULL)
+        return NULL;
+
+    struct dirent* current_element;
+
+    while((current_element = readdir(main_dir)) != NULL)
+    {
+        if(current_element->d_type != DT_REG) //skipping not-files
             continue;
         if(strcmp(current_element->d_name, lang) == 0) //if name matches, load it
         {
             char* full_path = strcat3(CONF_PATH, "/", current_element->d_name);
             FILE* dict_file = fopen(full_path, "r");
-            free(full_path);
             if(dict_file == NULL)
+            {
+                free(full_path);
                 return NULL;
+            }
             Dictionary* ret = dictionary_load(dict_file);
             fclose(dict_file);
+            if(ret != NULL && ret->trie_root != NULL)
+            {
+                load_costs(ret, current_element->d_name);
+                load_phonetic_index(ret, current_element->d_name);
+                ret->anagram_index = load_key_index(ret->trie_root, current_element->d_name,
+                                                    DICTIONARY_ANAGRAM_SUFFIX, anagram_key, NULL);
+                //saved indexes match the dictionary file, replay updates them
+                replay_journal(ret, full_path);
+            }
+            free(full_path);
             return ret;
         }
     }
     return NULL; //no such dictionary
 }
 
-int dictionary_save_lang(const Dictionary* dict, const char *lang)
+int dictionary_save_lang(Dictionary* dict, const char *lang)
 {
     char* full_path = strcat3(CONF_PATH, "/", (char*) lang);
-    FILE* dict_file = fopen(full_path, "w");
+    int ret;
+    //appended changes are replayed on saved indexes, which have to match the dictionary file
+    if(journal_appendable(dict, full_path)
+       && key_index_saved(dict->phonetic_index, dict->journal->base_hash, lang, DICTIONARY_PHONETIC_SUFFIX)
+       && key_index_saved(dict->anagram_index, dict->journal->base_hash, lang, DICTIONARY_ANAGRAM_SUFFIX))
+        ret = append_journal(dict);
+    else
+    {
+        ret = save_whole_file(dict, full_path);
+        if(ret == DICTIONARY_SAVE_SUCCESS)
+        {
+            uint64_t hash = dictionary_hash(dict);
+            save_key_index(dict->phonetic_index, hash, lang, DICTIONARY_PHONETIC_SUFFIX);
+            save_key_index(dict->anagram_index, hash, lang, DICTIONARY_ANAGRAM_SUFFIX);
+        }
+    }
     free(full_path);
-    if(dict_file == NULL)
-        return -1;
-    dictionary_save(dict, dict_file);
-    fclose(dict_file);
-    return 0;
+    return ret;
 }
@@ -16,20 +16,103 @@
 
 
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <wchar.h>
 #include "word_list.h"
 #include "trie.h"
+#include "hints.h"
+#include "hints_cache.h"
+#include "edit_costs.h"
+#include "key_index.h"
+#include "phonetic.h"
+#include "counting_filter.h"
+#include "word_hash.h"
+#include "find_cache.h"
+#include "pattern.h"
+#include "automaton.h"
+#include "anagram.h"
+#include "front_coding.h"
+
+/**
+  Journal of changes of a dictionary saved in a file.
+  <p>
+  Words changed since the last save are remembered and a save only appends their current state
+  to the journal next to the dictionary file, so it costs time proportional to the change.
+  Once the journal grows past the threshold, the whole dictionary file is written again instead.
+  */
+typedef struct
+{
+    char* path; ///<Name of the dictionary file, which the journal belongs to, or NULL if not saved yet.
+    Word_List changed; ///<Words changed since the journal was last written, may repeat.
+    uint64_t base_hash; ///<Hash of words of the dictionary file, written at the beginning of the journal file.
+    size_t line_count; ///<Number of lines in the journal file.
+    size_t threshold; ///<Number of lines of the journal file after which it is compacted.
+    bool broken; ///<True if the journal file ends with a broken line, so it cannot be appended.
+} Dictionary_Journal;
 
 /**
   Struct containing dictionary.
+  <p>
+  Queries taking a const dictionary may run concurrently, caches and counters they update
+  are guarded inside their modules. Modifications need exclusive access.
   */
 typedef struct dictionary
 {
     Node* trie_root; ///<Root of prefix tree.
     Array_Set* alphabet; ///<Set of letters of which consists all words in trie, used in hints.
+    unsigned long generation; ///<Incremented on every modification of the trie.
+    Hints_Cache* hints_cache; ///<Cache of generated hints or NULL if disabled.
+    Edit_Costs* costs; ///<Costs of edits used by weighted hints or NULL for equal costs.
+    const Phonetic_Rules* phonetic_rules; ///<Rules of phonetic keys of the language.
+    Key_Index* phonetic_index; ///<Index of words by phonetic key or NULL if disabled.
+    Key_Index* anagram_index; ///<Index of words by sorted letters or NULL if disabled.
+    Node* suffix_root; ///<Root of trie of reversed words or NULL if disabled.
+    Counting_Filter* filter; ///<Filter rejecting most absent words before the trie or the hash set is searched or NULL if disabled.
+    Word_Hash* word_hash; ///<Hash set answering dictionary_find() instead of the trie or NULL if disabled.
+    Find_Cache* find_cache; ///<Cache of results of dictionary_find() or NULL if disabled.
+    Dictionary_Journal* journal; ///<Journal of changes or NULL if disabled.
 } Dictionary;
 
+/**
+  Position in the dictionary after reading a prefix letter by letter.
+  <p>
+  The cursor keeps the node of the longest prefix of the read letters, which is a prefix of
+  some word, so reading or unreading one letter costs one step in the trie.
+  After a modification of the dictionary the node is found again from the root.
+  */
+typedef struct
+{
+    const struct dictionary* dict; ///<The dictionary.
+    const Node* node; ///<Node of the first alive_length letters.
+    unsigned long generation; ///<Generation of the dictionary of the node.
+    wchar_t* prefix; ///<Read letters, in lower case.
+    size_t length; ///<Number of read letters.
+    size_t alive_length; ///<Number of read letters being a prefix of some word.
+    size_t size; ///<Size of prefix array.
+} Dictionary_Cursor;
+
+/**
+  Position in the words of the dictionary, in alphabetical order.
+  <p>
+  Words are returned one at a time from a buffer of the iterator, without allocations per word.
+  After a modification of the dictionary the iterator finds its position again from the root.
+  */
+typedef struct
+{
+    const struct dictionary* dict; ///<The dictionary.
+    Trie_Iterator trie; ///<Position in the trie.
+    unsigned long generation; ///<Generation of the dictionary of the position.
+    wchar_t* key; ///<Key of the last seek, in lower case, or NULL.
+    bool returned; ///<True if a word was returned since the last seek.
+} Dictionary_Iterator;
+
+/**
+  * Receives words found by queries like dictionary_complete() or dictionary_match().
+  * Arguments are the word, valid only during the call, its frequency and user data.
+  */
+typedef void (*Dictionary_Word_Callback)(const wchar_t* word, unsigned frequency, void* data);
+
 #define DICTIONARY_INSERT_MODIFIED 1 ///<Return value
 #define DICTIONARY_INSERT_NOT_MODIFIED 0 ///<Return value
 #define DICTIONARY_WORD_DELETED 1 ///<Return value
@@ -37,6 +120,28 @@ typedef struct dictionary
 #define DICTIONARY_WORD_FOUND 1 ///<Return value
 #define DICTIONARY_WORD_NOT_FOUND 0 ///<Return value
 #define DICTIONARY_SAVE_SUCCESS 0 ///<Return value
+#define DICTIONARY_SAVE_FAILURE -1 ///<Return value
+#define DICTIONARY_HINTS_COMPLETE HINTS_COMPLETE ///<Return value
+#define DICTIONARY_HINTS_PARTIAL HINTS_PARTIAL ///<Return value
+#define DICTIONARY_MAX_FREQUENCY TRIE_MAX_FREQUENCY ///<Greatest frequency of a word, greater ones are clamped.
+#define DICTIONARY_COSTS_SUFFIX ".costs" ///<Suffix of the name of the edit costs file of a language, see edit_costs.h.
+#define DICTIONARY_PHONETIC_SUFFIX ".phon" ///<Suffix of the name of the saved phonetic index of a language.
+#define DICTIONARY_ANAGRAM_SUFFIX ".anagram" ///<Suffix of the name of the saved anagram index of a language.
+#define DICTIONARY_JOURNAL_SUFFIX ".journal" ///<Suffix of the name of the journal of a dictionary file.
+#define DICTIONARY_TEMPORARY_SUFFIX ".new" ///<Suffix of the name of a dictionary file being written.
+#define DICTIONARY_JOURNAL_DEFAULT_THRESHOLD 4096 ///<Default number of lines of a journal after which it is compacted.
+#define DICTIONARY_FILTER_DEFAULT_RATE 0.01 ///<Default false positive rate of the filter.
+#define DICTIONARY_FILTER_DEFAULT_BYTES (1 << 22) ///<Default memory budget of the filter.
+#define DICTIONARY_COMPLETE_BY_FREQUENCY 0 ///<Order of dictionary_complete(): the most frequent first, then the shortest.
+#define DICTIONARY_COMPLETE_BY_LENGTH 1 ///<Order of dictionary_complete(): the shortest first.
+#define DICTIONARY_PATTERN_INVALID -1 ///<Return value
+#define DICTIONARY_SAMPLE_DEFAULT_SEED 88172645463325252ULL ///<Used by dictionary_sample() instead of zero state.
+#define DICTIONARY_NO_ID SIZE_MAX ///<Return value of dictionary_find_id() for absent words.
+#define DICTIONARY_UNION TRIE_MERGE_UNION ///<Operation of dictionary_merge(): words of any dictionary.
+#define DICTIONARY_INTERSECTION TRIE_MERGE_INTERSECTION ///<Operation of dictionary_merge(): words of both dictionaries.
+#define DICTIONARY_DIFFERENCE TRIE_MERGE_DIFFERENCE ///<Operation of dictionary_merge(): words of the first dictionary only.
+#define DICTIONARY_DELTA_INVALID -1 ///<Return value
+#define DICTIONARY_DEFAULT_LANG "pl_PL" ///<Language of dictionaries not loaded by dictionary_load_lang().
 
 /**
  * @brief dictionary_new Creation and initialization of a dictionary.
@@ -81,6 +186,34 @@ int dictionary_delete(struct dictionary *dict, const wchar_t* word);
  */
 bool dictionary_find(const struct dictionary *dict, const wchar_t* word);
 
+/**
+ * @brief dictionary_find_batch Tests existence of many words at once.
+ * @param dict Dicionary
+ * @param words The words.
+ * @param count Number of words.
+ * @param results Array of count results, true if dict contains the word.
+ * Gives the same results as dictionary_find() for every word, but searches the trie for
+ * many words in lockstep, so waiting for memory of one search overlaps with others.
+ */
+void dictionary_find_batch(const struct dictionary *dict, const wchar_t* const* words, size_t count, bool* results);
+
+/**
+ * @brief dictionary_set_frequency Sets frequency of a word, used to rank hints.
+ * @param dict Dictionary
+ * @param word Word present in dictionary.
+ * @param frequency Frequency of the word, clamped to DICTIONARY_MAX_FREQUENCY. Words start with 0.
+ * @return DICTIONARY_WORD_FOUND or DICTIONARY_WORD_NOT_FOUND, when word is not in dict.
+ * Frequencies are saved and loaded together with the dictionary.
+ */
+int dictionary_set_frequency(struct dictionary *dict, const wchar_t* word, unsigned frequency);
+
+/**
+ * @brief dictionary_frequency Reads frequency of a word.
+ * @param dict Dictionary
+ * @param word The word.
+ * @return Frequency of the word, 0 if word is not in dict.
+ */
+unsigned dictionary_frequency(const struct dictionary *dict, const wchar_t* word);
 
 /**
  * @brief dictionary_save Saves the dictionary.
@@ -97,15 +230,541 @@ int dictionary_save(const struct dictionary *dict, FILE* stream);
  */
 Dictionary* dictionary_load(FILE* stream);
 
+/**
+ * @brief dictionary_save_packed Saves words and frequencies of the dictionary in front coded format.
+ * @param dict Dictionary to save.
+ * @param stream Stream opened in binary mode.
+ * @return 0 if succeeded, <0 otherwise.
+ * The file is much smaller than the one of dictionary_save() and can be searched without loading,
+ * see front_coding_open() and front_coding_find(). Optional sections like the filter are not saved.
+ */
+int dictionary_save_packed(const struct dictionary *dict, FILE* stream);
+
+/**
+ * @brief dictionary_load_packed Creates and loads dictionary saved by dictionary_save_packed().
+ * @param stream Stream to load from.
+ * @return A dictionary loaded from stream or NULL if the stream is not front coded or is broken.
+ */
+Dictionary* dictionary_load_packed(FILE* stream);
+
 /**
  * @brief dictionary_hints Generates a list of hints for given word according to dict content.
  * @param dict Dictionary upon which hints will be generated.
  * @param word Word to give hints of.
- * @param list Container for generated hints.
+ * @param list Container for generated hints, the closest ones first.
+ * Use word_list_get_in_order() to keep the ranking, word_list_get() sorts the words.
  */
 void dictionary_hints(const struct dictionary *dict, const wchar_t* word,
                       struct word_list *list);
 
+/**
+ * @brief dictionary_hints_with_options Generates hints for given word within given limits.
+ * @param dict Dictionary upon which hints will be generated.
+ * @param word Word to give hints of.
+ * @param options Limits of generation (edit distance, results, visited nodes, time), see hints_default_options().
+ * @param list Container for generated hints, the closest ones first.
+ * @return DICTIONARY_HINTS_COMPLETE or DICTIONARY_HINTS_PARTIAL if a limit was hit and list may be incomplete.
+ * Hints are ordered by Damerau distance from the word, see hints_order_by_distance().
+ * Use word_list_get_in_order() to keep the ranking, word_list_get() sorts the words.
+ */
+int dictionary_hints_with_options(const struct dictionary *dict, const wchar_t* word,
+                                  const Hints_Options* options, struct word_list *list);
+
+/**
+ * @brief dictionary_hints_top Generates at most k best hints for given word.
+ * @param dict Dictionary upon which hints will be generated.
+ * @param word Word to give hints of.
+ * @param k Number of wanted hints.
+ * @param options Limits of generation, see hints_generate_top().
+ * @param list Container for generated hints, the best one first.
+ * @return DICTIONARY_HINTS_COMPLETE or DICTIONARY_HINTS_PARTIAL if a limit was hit.
+ * Hints are ranked by frequency of words, then by edit distance, then alphabetically.
+ * Use word_list_get_in_order() to keep the ranking, word_list_get() sorts the words.
+ */
+int dictionary_hints_top(const struct dictionary *dict, const wchar_t* word, size_t k,
+                         const Hints_Options* options, struct word_list *list);
+
+/**
+ * @brief dictionary_hints_weighted Generates at most k cheapest hints for given word.
+ * @param dict Dictionary upon which hints will be generated.
+ * @param word Word to give hints of.
+ * @param k Number of wanted hints.
+ * @param options Limits of generation, cost of a hint is at most options->max_edits * EDIT_COSTS_UNIT.
+ * @param list Container for generated hints, the cheapest one first.
+ * @return DICTIONARY_HINTS_COMPLETE or DICTIONARY_HINTS_PARTIAL if a limit was hit.
+ * Costs of edits are taken from dictionary_set_costs(), see hints_generate_weighted().
+ */
+int dictionary_hints_weighted(const struct dictionary *dict, const wchar_t* word, size_t k,
+                              const Hints_Options* options, struct word_list *list);
+
+/**
+ * @brief dictionary_set_costs Sets costs of edits used by dictionary_hints_weighted().
+ * @param dict The dictionary.
+ * @param costs Costs of edits, owned by dict from now on, or NULL for equal costs.
+ * dictionary_load_lang() loads costs from file named lang + DICTIONARY_COSTS_SUFFIX, if it exists.
+ */
+void dictionary_set_costs(struct dictionary *dict, Edit_Costs* costs);
+
+/**
+ * @brief dictionary_hints_batch Generates hints for many words at once.
+ * @param dict Dictionary upon which hints will be generated.
+ * @param words Array of words to give hints of.
+ * @param count Number of words.
+ * @param options Limits of generation, node and time budgets are shared by the whole batch.
+ * @param lists Array of count containers, hints of words[i] are stored in lists[i], the closest ones first.
+ * @return DICTIONARY_HINTS_COMPLETE or DICTIONARY_HINTS_PARTIAL if a limit was hit.
+ * Words are sorted and walk the trie together, so common prefixes are visited once.
+ * Once a budget is exhausted, words not reached yet get no hints, see hints_generate_batch().
+ */
+int dictionary_hints_batch(const struct dictionary *dict, const wchar_t* const* words, size_t count,
+                           const Hints_Options* options, struct word_list *lists);
+
+/**
+ * @brief dictionary_hints_cache_enable Starts caching hints of the dictionary.
+ * @param dict The dictionary.
+ * @param max_entries Maximal number of cached words, must be positive.
+ * @param max_bytes Maximal memory used by cached hints.
+ * Previous cache, if any, is dropped. Only complete results are cached,
+ * every insertion or deletion which modifies the dictionary invalidates the cache.
+ */
+void dictionary_hints_cache_enable(struct dictionary *dict, size_t max_entries, size_t max_bytes);
+
+/**
+ * @brief dictionary_hints_cache_disable Stops caching hints and frees the cache.
+ * @param dict The dictionary.
+ */
+void dictionary_hints_cache_disable(struct dictionary *dict);
+
+/**
+ * @brief dictionary_hints_cache_stats Reads counters of the hints cache.
+ * @param dict The dictionary.
+ * @param hits Pointer to store number of lookups served from cache.
+ * @param misses Pointer to store number of lookups which generated hints.
+ * Both counters are 0 if cache is disabled.
+ */
+void dictionary_hints_cache_stats(const struct dictionary *dict, size_t *hits, size_t *misses);
+
+/**
+ * @brief dictionary_filter_enable Builds filter checked by dictionary_find() before the trie or the hash set, if not built yet.
+ * @param dict Dictionary
+ * @param false_positive_rate Fraction of absent words passed to the trie, between 0 and 1.
+ * @param max_bytes Memory budget, if too small the false positive rate is higher.
+ * The filter is kept up to date by insertions and deletions and saved with the dictionary.
+ * To change parameters of an existing filter, disable it first.
+ */
+void dictionary_filter_enable(struct dictionary *dict, double false_positive_rate, size_t max_bytes);
+
+/**
+ * @brief dictionary_filter_disable Frees the filter.
+ * @param dict Dictionary
+ */
+void dictionary_filter_disable(struct dictionary *dict);
+
+/**
+ * @brief dictionary_filter_stats Reads counters of the filter.
+ * @param dict Dictionary
+ * @param rejected Number of lookups answered by the filter alone.
+ * @param passed Number of lookups passed to the trie.
+ */
+void dictionary_filter_stats(const struct dictionary *dict, size_t *rejected, size_t *passed);
+
+/**
+ * @brief dictionary_word_hash_enable Builds hash set of words, used by dictionary_find() instead of the trie.
+ * @param dict Dictionary
+ * The set is kept up to date by insertions and deletions, hints still use the trie.
+ * It is not saved with the dictionary.
+ */
+void dictionary_word_hash_enable(struct dictionary *dict);
+
+/**
+ * @brief dictionary_word_hash_disable Frees the hash set of words.
+ * @param dict Dictionary
+ */
+void dictionary_word_hash_disable(struct dictionary *dict);
+
+/**
+ * @brief dictionary_phonetic_index_enable Builds index of words by phonetic key, if not built yet.
+ * @param dict Dictionary
+ * The index is kept up to date by insertions and deletions and saved by dictionary_save_lang().
+ */
+void dictionary_phonetic_index_enable(struct dictionary *dict);
+
+/**
+ * @brief dictionary_phonetic_index_disable Frees the phonetic index.
+ * @param dict Dictionary
+ */
+void dictionary_phonetic_index_disable(struct dictionary *dict);
+
+/**
+ * @brief dictionary_set_phonetic_lang Chooses rules of phonetic keys.
+ * @param dict Dictionary
+ * @param lang Name of the language, see phonetic_rules().
+ * Phonetic index, if enabled, is built again.
+ */
+void dictionary_set_phonetic_lang(struct dictionary *dict, const char* lang);
+
+/**
+ * @brief dictionary_sounds_like Finds words sounding like the given one.
+ * @param dict Dictionary
+ * @param word The word.
+ * @param list List where words with the same phonetic key are added, in alphabetical order.
+ * @return Number of added words.
+ * With phonetic index it is a single lookup, otherwise all words are scanned.
+ */
+size_t dictionary_sounds_like(const struct dictionary *dict, const wchar_t* word, struct word_list *list);
+
+/**
+ * @brief dictionary_anagram_index_enable Builds index of words by their sorted letters, if not built yet.
+ * @param dict Dictionary
+ * The index is kept up to date by insertions and deletions and saved by dictionary_save_lang().
+ */
+void dictionary_anagram_index_enable(struct dictionary *dict);
+
+/**
+ * @brief dictionary_anagram_index_disable Frees the anagram index.
+ * @param dict Dictionary
+ */
+void dictionary_anagram_index_disable(struct dictionary *dict);
+
+/**
+ * @brief dictionary_anagrams Finds words made of exactly the letters of the given one.
+ * @param dict Dictionary
+ * @param word The word, not necessarily in the dictionary.
+ * @param list List where anagrams are added, in alphabetical order. The word itself is among them, if present.
+ * @return Number of added words.
+ * With anagram index it is a single lookup, otherwise the trie is walked as long as letters last.
+ */
+size_t dictionary_anagrams(const struct dictionary *dict, const wchar_t* word, struct word_list *list);
+
+/**
+ * @brief dictionary_formable Finds words which can be formed from the letters, using each at most once.
+ * @param dict Dictionary
+ * @param letters The letters, repeated as many times as they may be used.
+ * @param list List where words are added.
+ * @return Number of added words.
+ * With anagram index every subset of letters is a lookup, see anagram_find_formable().
+ */
+size_t dictionary_formable(const struct dictionary *dict, const wchar_t* letters, struct word_list *list);
+
+/**
+ * @brief dictionary_suffix_trie_enable Builds trie of reversed words, if not built yet.
+ * @param dict Dictionary
+ * The trie is kept up to date by insertions and deletions. It is not saved, but built again from the dictionary.
+ */
+void dictionary_suffix_trie_enable(struct dictionary *dict);
+
+/**
+ * @brief dictionary_suffix_trie_disable Frees the trie of reversed words.
+ * @param dict Dictionary
+ */
+void dictionary_suffix_trie_disable(struct dictionary *dict);
+
+/**
+ * @brief dictionary_ends_with Finds words ending with the suffix.
+ * @param dict Dictionary
+ * @param suffix The suffix.
+ * @param list List where words are added.
+ * @return Number of added words.
+ * With trie of reversed words it costs O(|suffix| + results), otherwise all words are scanned.
+ */
+size_t dictionary_ends_with(const struct dictionary *dict, const wchar_t* suffix, struct word_list *list);
+
+/**
+ * @brief dictionary_word_count Returns number of words.
+ * @param dict Dictionary
+ * @return Number of words.
+ */
+size_t dictionary_word_count(const struct dictionary *dict);
+
+/**
+ * @brief dictionary_rank Counts words preceding the word.
+ * @param dict Dictionary
+ * @param word The word, not necessarily in the dictionary.
+ * @return Number of smaller words in trie order, i.e. by codes of letters. For a word of the dictionary it is its position.
+ */
+size_t dictionary_rank(const struct dictionary *dict, const wchar_t* word);
+
+/**
+ * @brief dictionary_select Finds the word at given position in trie order.
+ * @param dict Dictionary
+ * @param rank Position of the word, from 0.
+ * @return New string with the word, to be freed by the caller, or NULL if rank is not less than dictionary_word_count().
+ */
+wchar_t* dictionary_select(const struct dictionary *dict, size_t rank);
+
+/**
+ * @brief dictionary_prefix_count Counts words starting with the prefix.
+ * @param dict Dictionary
+ * @param prefix The prefix, may be empty.
+ * @return Number of words, counted in O(|prefix|).
+ */
+size_t dictionary_prefix_count(const struct dictionary *dict, const wchar_t* prefix);
+
+/**
+ * @brief dictionary_sample Draws a word uniformly at random.
+ * @param dict Dictionary
+ * @param state State of the random generator, updated by the call. Equal states give equal sequences of words.
+ * @return New string with the word, to be freed by the caller, or NULL if the dictionary is empty.
+ */
+wchar_t* dictionary_sample(const struct dictionary *dict, uint64_t* state);
+
+/**
+ * @brief dictionary_find_id Returns identifier of the word.
+ * @param dict Dictionary
+ * @param word The word.
+ * @return Identifier from 0 to dictionary_word_count() - 1 or DICTIONARY_NO_ID if the word is absent.
+ * Identifiers are positions of words in trie order, see dictionary_rank(), so side tables of words
+ * can be plain arrays. They stay valid until the dictionary is modified, i.e. its generation changes.
+ */
+size_t dictionary_find_id(const struct dictionary *dict, const wchar_t* word);
+
+/**
+ * @brief dictionary_word_by_id Returns the word with given identifier.
+ * @param dict Dictionary
+ * @param id Identifier returned by dictionary_find_id().
+ * @return New string with the word, to be freed by the caller, or NULL if there is no such identifier.
+ */
+wchar_t* dictionary_word_by_id(const struct dictionary *dict, size_t id);
+
+/**
+ * @brief dictionary_merge Creates dictionary from words of two dictionaries.
+ * @param a The first dictionary.
+ * @param b The second dictionary.
+ * @param operation DICTIONARY_UNION, DICTIONARY_INTERSECTION or DICTIONARY_DIFFERENCE.
+ * @return Pointer to the new dictionary, with rules of the language of the first one.
+ * Both tries are walked together once, see trie_merge(), instead of inserting words one by one.
+ * A word of both dictionaries gets the greater frequency. Indexes and caches are not enabled.
+ */
+struct dictionary* dictionary_merge(const struct dictionary *a, const struct dictionary *b, int operation);
+
+/**
+ * @brief dictionary_hash Computes hash of words and frequencies of the dictionary.
+ * @param dict The dictionary.
+ * @return The hash, equal for dictionaries with equal words and frequencies.
+ * Hashes of subtrees are kept in the trie, so only parts changed since the last call are hashed again.
+ * The hash is saved with the dictionary once computed.
+ */
+uint64_t dictionary_hash(const struct dictionary *dict);
+
+/**
+ * @brief dictionary_diff Visits words which differ between the dictionaries.
+ * @param from The first dictionary.
+ * @param to The second dictionary.
+ * @param removed Called for words of the first dictionary absent in the second one.
+ * @param added Called for words of the second dictionary absent in the first one or with other frequency.
+ * @param data Passed to callbacks.
+ * @return Number of visited words.
+ * Subtrees with equal hashes are skipped, so the cost depends on the changed parts only.
+ */
+size_t dictionary_diff(const struct dictionary *from, const struct dictionary *to,
+                       Dictionary_Word_Callback removed, Dictionary_Word_Callback added, void* data);
+
+/**
+ * @brief dictionary_save_delta Saves changes turning one dictionary into another one.
+ * @param from The first dictionary.
+ * @param to The second dictionary.
+ * @param file The file.
+ * @return Number of saved changes.
+ * The delta starts with hash of the first dictionary, then every word to be deleted or inserted has its line.
+ */
+size_t dictionary_save_delta(const struct dictionary *from, const struct dictionary *to, FILE* file);
+
+/**
+ * @brief dictionary_apply_delta Applies changes saved by dictionary_save_delta().
+ * @param dict The dictionary, equal to the first dictionary of the delta.
+ * @param file The file.
+ * @return Number of applied changes or DICTIONARY_DELTA_INVALID if the dictionary has another hash
+ * or the delta is broken. The whole delta is read before any change is applied,
+ * so the dictionary is not modified by a broken one.
+ */
+int dictionary_apply_delta(struct dictionary *dict, FILE* file);
+
+/**
+ * @brief dictionary_journal_enable Starts remembering changed words, so saves append only them.
+ * @param dict The dictionary.
+ * @param threshold Number of lines of the journal file after which the whole dictionary file is written again.
+ * The journal is used by dictionary_save_file() and dictionary_save_lang().
+ * If it is already enabled, only the threshold is changed.
+ */
+void dictionary_journal_enable(struct dictionary *dict, size_t threshold);
+
+/**
+ * @brief dictionary_journal_disable Stops remembering changed words, the next save writes the whole dictionary.
+ * @param dict The dictionary.
+ */
+void dictionary_journal_disable(struct dictionary *dict);
+
+/**
+ * @brief dictionary_save_file Saves dictionary to the named file, appending only changes if possible.
+ * @param dict The dictionary.
+ * @param path Name of the file.
+ * @return DICTIONARY_SAVE_SUCCESS or DICTIONARY_SAVE_FAILURE if a file cannot be written.
+ * If the journal is enabled and the file was last saved or loaded with it, words changed since then
+ * are appended to the file named path + DICTIONARY_JOURNAL_SUFFIX, which is a delta of dictionary_save_delta()
+ * from the dictionary file, but without its final sign.
+ * Otherwise, or if the journal would grow past its threshold, the dictionary is written to
+ * path + DICTIONARY_TEMPORARY_SUFFIX, renamed to path and the journal is removed,
+ * so a failed save never destroys the previous file.
+ */
+int dictionary_save_file(struct dictionary *dict, const char* path);
+
+/**
+ * @brief dictionary_load_file Loads dictionary from the named file and replays its journal.
+ * @param path Name of the file.
+ * @return Pointer to the loaded dictionary, with the journal enabled, or NULL if the file cannot be read
+ * or is malformed.
+ * A broken last line of the journal, left by an interrupted save, is ignored, and so is a journal
+ * starting with hash of another dictionary, left by an interrupted rewrite of the file.
+ */
+struct dictionary* dictionary_load_file(const char* path);
+
+/**
+ * @brief dictionary_find_cache_enable Starts caching results of dictionary_find() for short words.
+ * @param dict The dictionary.
+ * @param entry_count Number of cached words, rounded up to a power of two.
+ * Cached words are compared as given, before conversion to lower case.
+ */
+void dictionary_find_cache_enable(struct dictionary *dict, size_t entry_count);
+
+/**
+ * @brief dictionary_find_cache_disable Stops caching results of dictionary_find() and frees the cache.
+ * @param dict The dictionary.
+ */
+void dictionary_find_cache_disable(struct dictionary *dict);
+
+/**
+ * @brief dictionary_find_cache_stats Reads counters of the cache of dictionary_find().
+ * @param dict The dictionary.
+ * @param hits Pointer to store number of lookups served from cache.
+ * @param misses Pointer to store number of lookups passed to the dictionary.
+ */
+void dictionary_find_cache_stats(const struct dictionary *dict, size_t *hits, size_t *misses);
+
+/**
+ * @brief dictionary_cursor_new Creates cursor at the empty prefix.
+ * @param dict The dictionary, must outlive the cursor.
+ * @return Pointer to the new cursor.
+ */
+Dictionary_Cursor* dictionary_cursor_new(const struct dictionary *dict);
+
+/**
+ * @brief dictionary_cursor_free Deallocates the cursor.
+ * @param cursor The cursor.
+ */
+void dictionary_cursor_free(Dictionary_Cursor* cursor);
+
+/**
+ * @brief dictionary_cursor_reset Moves the cursor back to the empty prefix.
+ * @param cursor The cursor.
+ */
+void dictionary_cursor_reset(Dictionary_Cursor* cursor);
+
+/**
+ * @brief dictionary_cursor_advance Reads one more letter.
+ * @param cursor The cursor.
+ * @param letter The letter.
+ * @return True if some word starts with the read letters.
+ */
+bool dictionary_cursor_advance(Dictionary_Cursor* cursor, wchar_t letter);
+
+/**
+ * @brief dictionary_cursor_back Unreads the last letter, i.e. after a backspace.
+ * @param cursor The cursor.
+ * @return False if no letters were read.
+ */
+bool dictionary_cursor_back(Dictionary_Cursor* cursor);
+
+/**
+ * @brief dictionary_cursor_is_word Tests if the read letters make a word.
+ * @param cursor The cursor.
+ * @return True if the dictionary contains the read word.
+ */
+bool dictionary_cursor_is_word(Dictionary_Cursor* cursor);
+
+/**
+ * @brief dictionary_cursor_has_children Tests if the read letters can be continued.
+ * @param cursor The cursor.
+ * @return True if there are longer words starting with the read letters.
+ */
+bool dictionary_cursor_has_children(Dictionary_Cursor* cursor);
+
+/**
+ * @brief dictionary_cursor_completions Lists words starting with the read letters.
+ * @param cursor The cursor.
+ * @param limit Maximal number of listed words.
+ * @param list Initialized list, where the words are added in alphabetical order.
+ * @return Number of added words.
+ */
+size_t dictionary_cursor_completions(Dictionary_Cursor* cursor, size_t limit, struct word_list *list);
+
+/**
+ * @brief dictionary_iterator_new Creates iterator before the first word.
+ * @param dict The dictionary, must outlive the iterator.
+ * @return Pointer to the new iterator.
+ */
+Dictionary_Iterator* dictionary_iterator_new(const struct dictionary *dict);
+
+/**
+ * @brief dictionary_iterator_free Deallocates the iterator.
+ * @param iterator The iterator.
+ */
+void dictionary_iterator_free(Dictionary_Iterator* iterator);
+
+/**
+ * @brief dictionary_iterator_seek Moves the iterator before the first word not smaller than the key.
+ * @param iterator The iterator.
+ * @param key The key, f.e. a prefix, words starting with it come first.
+ */
+void dictionary_iterator_seek(Dictionary_Iterator* iterator, const wchar_t* key);
+
+/**
+ * @brief dictionary_iterator_next Moves to the next word.
+ * @param iterator The iterator.
+ * @return The word, valid until the next call, or NULL after the last word.
+ * Words inserted behind the position are returned, deleted ones are not.
+ */
+const wchar_t* dictionary_iterator_next(Dictionary_Iterator* iterator);
+
+/**
+ * @brief dictionary_complete Finds at most k best words starting with the prefix.
+ * @param dict The dictionary.
+ * @param prefix The prefix, may be empty.
+ * @param k Number of wanted completions.
+ * @param order DICTIONARY_COMPLETE_BY_FREQUENCY or DICTIONARY_COMPLETE_BY_LENGTH.
+ * @param callback Called for every completion, the best one first.
+ * @param data Passed to the callback.
+ * @return Number of reported completions.
+ * Ties are broken by length, then alphabetically. The search is best-first over subtrees of the prefix node,
+ * bounded by their greatest frequency, so under short prefixes only a small part of the subtree is visited.
+ */
+size_t dictionary_complete(const struct dictionary *dict, const wchar_t* prefix, size_t k, int order,
+                           Dictionary_Word_Callback callback, void* data);
+
+/**
+ * @brief dictionary_match Finds words matching the wildcard pattern.
+ * @param dict The dictionary.
+ * @param pattern The pattern: ? matches any letter, * any sequence of letters, [a-c] and [^a-c] letters
+ * of a class or out of it, \\ makes the next sign an ordinary letter. Matching ignores case.
+ * @param callback Called for every matching word, in alphabetical order.
+ * @param data Passed to the callback.
+ * @return Number of matching words or DICTIONARY_PATTERN_INVALID if the pattern is malformed.
+ * Subtrees whose words are too short or too long for the rest of the pattern are not visited.
+ */
+int dictionary_match(const struct dictionary *dict, const wchar_t* pattern,
+                     Dictionary_Word_Callback callback, void* data);
+
+/**
+ * @brief dictionary_match_regex Finds words matching the regular expression.
+ * @param dict The dictionary.
+ * @param regex The expression, see automaton_new(). It has to match the whole word, matching ignores case.
+ * @param callback Called for every matching word, in alphabetical order.
+ * @param data Passed to the callback.
+ * @return Number of matching words or DICTIONARY_PATTERN_INVALID if the expression is malformed or too complex.
+ * The expression is compiled to a deterministic automaton over the alphabet of the dictionary and
+ * the trie is walked together with it, leaving subtrees in which no word can be accepted.
+ */
+int dictionary_match_regex(const struct dictionary *dict, const wchar_t* regex,
+                           Dictionary_Word_Callback callback, void* data);
 
 /**
  * @brief dictionary_lang_list Returns list of available dictionaries.
@@ -118,6 +777,7 @@ void dictionary_hints(const struct dictionary *dict, const wchar_t* word,
  * Representation of the languages list is similiar to chars strings lists [argz in glibc].
  * Pointer 'list' points onto begining of the buffer in which strings representing languages are stored continously, separated by one \0 sign.
  * If list is non-empty, then also the whole list is ended with \0.
+ * Auxiliary files of languages, like edit costs, are not listed.
  */
 int dictionary_lang_list(char **list, size_t *list_len);
 
@@ -134,6 +794,7 @@ int dictionary_lang_list(char **list, size_t *list_len);
  * @param lang Name of language, see dictionary_lang_list().
  * @return Pointer to a dictionary for given language or null, if operation fail.
  * The loaded dictionary should be disposed by dictionary_done()
+ * Its journal is replayed and enabled, see dictionary_load_file().
  */
 struct dictionary * dictionary_load_lang(const char *lang);
 
@@ -142,7 +803,11 @@ struct dictionary * dictionary_load_lang(const char *lang);
  * @param dict Dictionary
  * @param lang Name of the dictionary, @see dictionary_lang_list().
  * @return <0 if operation fails, 0 otherwise.
+ * Only changes are appended if possible, see dictionary_save_file().
+ * Indexes are saved with the whole dictionary file, as journal replay keeps loaded indexes up to date.
+ * Each index file starts with the hash of words of the dictionary file, an index saved with
+ * another version of the file is built again by dictionary_load_lang().
  */
-int dictionary_save_lang(const Dictionary *dict, const char *lang);
+int dictionary_save_lang(Dictionary *dict, const char *lang);
     
 #endif /* __DICTIONARY_H__ */
@@ -7,6 +7,7 @@
 #include <stdarg.h>
 #include <stddef.h>
 #include <setjmp.h>
+#include <stdlib.h>
 #include <cmocka.h>
 #include <wchar.h>
 #include <stdio.h>
@@ -234,6 +235,29 @@ static void test_hints_add(void** state)
     TEST_END;
 }
 
+///Tests that the word itself is returned as written, also from the cache.
+static void test_hints_spelling(void** state)
+{
+    TEST_EMPTY_BEGIN;
+    assert_true(dictionary_insert(dict, L"kot"));
+    assert_true(dictionary_insert(dict, L"kit"));
+    dictionary_hints_cache_enable(dict, HINTS_CACHE_DEFAULT_ENTRIES, HINTS_CACHE_DEFAULT_BYTES);
+    for(int i = 0; i < 2; i++)
+    {
+        struct word_list list;
+        dictionary_hints(dict, L"Kot", &list);
+        wchar_t** hints = word_list_get(&list);
+        assert_int_equal(word_list_size(&list), 2);
+        assert_true(wcscmp(hints[0], L"Kot") == 0 || wcscmp(hints[1], L"Kot") == 0);
+        assert_true(wcscmp(hints[0], L"kit") == 0 || wcscmp(hints[1], L"kit") == 0);
+        for(size_t j = 0; j < word_list_size(&list); j++)
+            free(hints[j]);
+        free(hints);
+        word_list_done(&list);
+    }
+    TEST_END;
+}
+
 ///Tests hints by replacing letter.
 static void test_hints_replace(void** state)
 {
@@ -289,11 +313,1041 @@ static void test_hints_delete(void** state)
     TEST_END;
 }
 
+///Tests limits of hints generation: edit distance, number of results and visited nodes.
+static void test_hints_limits(void** state)
+{
+    TEST_EMPTY_BEGIN;
+    wchar_t* hintee = L"kot";
+    wchar_t* words[] = {L"kot", L"kat", L"kit", L"kret", L"koc", L"pies"};
+    int words_len = sizeof(words)/sizeof(wchar_t*);
+    for(int i = 0; i < words_len; i++)
+        assert_true(dictionary_insert(dict, words[i]));
+
+    Hints_Options options;
+    hints_default_options(&options);
+    Word_List* hlist = word_list_new();
+
+    assert_int_equal(dictionary_hints_with_options(dict, hintee, &options, hlist), DICTIONARY_HINTS_COMPLETE);
+    assert_int_equal(word_list_size(hlist), 4); //kot, kat, kit, koc
+    word_list_done(hlist);
+
+    options.max_edits = 2;
+    assert_int_equal(dictionary_hints_with_options(dict, hintee, &options, hlist), DICTIONARY_HINTS_COMPLETE);
+    assert_int_equal(word_list_size(hlist), 5); //and kret
+    word_list_done(hlist);
+
+    options.max_results = 5;
+    assert_int_equal(dictionary_hints_with_options(dict, hintee, &options, hlist), DICTIONARY_HINTS_COMPLETE);
+    assert_int_equal(word_list_size(hlist), 5);
+    word_list_done(hlist);
+
+    options.max_results = 2;
+    assert_int_equal(dictionary_hints_with_options(dict, hintee, &options, hlist), DICTIONARY_HINTS_PARTIAL);
+    assert_int_equal(word_list_size(hlist), 2);
+    word_list_done(hlist);
+
+    options.max_results = HINTS_UNLIMITED;
+    options.max_visited_nodes = 1; //only root
+    assert_int_equal(dictionary_hints_with_options(dict, hintee, &options, hlist), DICTIONARY_HINTS_PARTIAL);
+    assert_int_equal(word_list_size(hlist), 0);
+
+    word_list_free(hlist);
+    TEST_END;
+}
+
+///Tests hints of a word long enough for many threads, which are tested by hints_threads_test.
+static void test_hints_long_word(void** state)
+{
+    TEST_EMPTY_BEGIN;
+    wchar_t* hintee = L"konstantynopolitanczykowianeczka";
+    wchar_t* words[] = {L"konstantynopolitanczykowianeczka", L"konstantynopolitanczykowianeczki",
+                        L"konstantynopolitanczykowianeczek", L"onstantynopolitanczykowianeczka",
+                        L"kkonstantynopolitanczykowianeczka", L"zonstantynopolitanczykowianeczka",
+                        L"konstantynopolitanczykowianeczkaa", L"kot", L"pies"};
+    int words_len = sizeof(words)/sizeof(wchar_t*);
+    for(int i = 0; i < words_len; i++)
+        assert_true(dictionary_insert(dict, words[i]));
+
+    Hints_Options options;
+    hints_default_options(&options);
+    Word_List* all = word_list_new();
+    Word_List* first = word_list_new();
+    assert_int_equal(dictionary_hints_with_options(dict, hintee, &options, all), DICTIONARY_HINTS_COMPLETE);
+    assert_int_equal(word_list_size(all), 6);
+
+    options.max_results = 3;
+    assert_int_equal(dictionary_hints_with_options(dict, hintee, &options, first), DICTIONARY_HINTS_PARTIAL);
+    assert_int_equal(word_list_size(first), 3);
+    struct word_node* a = all->first;
+    for(struct word_node* b = first->first; b != NULL; a = a->next, b = b->next)
+        assert_true(wcscmp(a->word, b->word) == 0);
+
+    word_list_free(all);
+    word_list_free(first);
+    TEST_END;
+}
+
+///Tests that batch hints are the same as hints generated word by word.
+static void test_hints_batch(void** state)
+{
+    TEST_EMPTY_BEGIN;
+    wchar_t* words[] = {L"kot", L"kat", L"kit", L"kret", L"koc", L"pies", L"piec", L"las", L"lis"};
+    int words_len = sizeof(words)/sizeof(wchar_t*);
+    for(int i = 0; i < words_len; i++)
+        assert_true(dictionary_insert(dict, words[i]));
+
+    const wchar_t* queries[] = {L"kxt", L"Pies", L"lus", L"kxt", L"zzzzz", L"k"};
+    int queries_len = sizeof(queries)/sizeof(wchar_t*);
+    struct word_list lists[sizeof(queries)/sizeof(wchar_t*)];
+    Hints_Options options;
+    hints_default_options(&options);
+    assert_int_equal(dictionary_hints_batch(dict, queries, queries_len, &options, lists), DICTIONARY_HINTS_COMPLETE);
+    assert_int_equal(word_list_size(&lists[0]), 3); //kot, kat, kit
+
+    Word_List* single = word_list_new();
+    for(int i = 0; i < queries_len; i++)
+    {
+        dictionary_hints(dict, queries[i], single);
+        assert_int_equal(word_list_size(single), word_list_size(&lists[i]));
+        for(struct word_node *a = single->first, *b = lists[i].first; a != NULL; a = a->next, b = b->next)
+            assert_true(wcscmp(a->word, b->word) == 0);
+        word_list_done(single);
+        word_list_done(&lists[i]);
+    }
+    word_list_free(single);
+    TEST_END;
+}
+
+///Tests counting of cache hits and invalidation of cached hints by modifications.
+static void test_hints_cache(void** state)
+{
+    TEST_EMPTY_BEGIN;
+    assert_true(dictionary_insert(dict, L"kot"));
+    assert_true(dictionary_insert(dict, L"kat"));
+    dictionary_hints_cache_enable(dict, 2, 4096);
+
+    size_t hits, misses;
+    struct word_list list;
+    dictionary_hints(dict, L"kxt", &list);
+    assert_int_equal(word_list_size(&list), 2);
+    word_list_done(&list);
+    dictionary_hints(dict, L"KXT", &list);
+    assert_int_equal(word_list_size(&list), 2);
+    word_list_done(&list);
+    dictionary_hints_cache_stats(dict, &hits, &misses);
+    assert_int_equal(hits, 1);
+    assert_int_equal(misses, 1);
+
+    assert_true(dictionary_insert(dict, L"kit"));
+    dictionary_hints(dict, L"kxt", &list);
+    assert_int_equal(word_list_size(&list), 3);
+    word_list_done(&list);
+    dictionary_hints_cache_stats(dict, &hits, &misses);
+    assert_int_equal(hits, 1);
+    assert_int_equal(misses, 2);
+
+    const wchar_t* queries[] = {L"kxt", L"kot", L"kit", L"kxt"};
+    struct word_list lists[4];
+    Hints_Options options;
+    hints_default_options(&options);
+    assert_int_equal(dictionary_hints_batch(dict, queries, 4, &options, lists), DICTIONARY_HINTS_COMPLETE);
+    for(int i = 0; i < 4; i++)
+    {
+        assert_int_equal(word_list_size(&lists[i]), 3);
+        word_list_done(&lists[i]);
+    }
+    assert_true(dict->hints_cache->entry_count <= 2);
+
+    dictionary_hints_cache_disable(dict);
+    dictionary_hints_cache_stats(dict, &hits, &misses);
+    assert_int_equal(hits + misses, 0);
+    TEST_END;
+}
+
+///Tests ranking of the best hints by frequency, distance and order.
+static void test_hints_top(void** state)
+{
+    TEST_EMPTY_BEGIN;
+    wchar_t* words[] = {L"kot", L"kat", L"kit", L"kret", L"koc", L"kto"};
+    int words_len = sizeof(words)/sizeof(wchar_t*);
+    for(int i = 0; i < words_len; i++)
+        assert_true(dictionary_insert(dict, words[i]));
+    assert_true(dictionary_set_frequency(dict, L"Kit", 30));
+    assert_true(dictionary_set_frequency(dict, L"kat", 1000)); //clamped
+    assert_false(dictionary_set_frequency(dict, L"kut", 5));
+    assert_int_equal(dictionary_frequency(dict, L"kat"), DICTIONARY_MAX_FREQUENCY);
+
+    Hints_Options options;
+    hints_default_options(&options);
+    options.max_edits = 2;
+    struct word_list list;
+    assert_int_equal(dictionary_hints_top(dict, L"kot", 4, &options, &list), DICTIONARY_HINTS_COMPLETE);
+    wchar_t* expected[] = {L"kat", L"kit", L"kot", L"koc"};
+    wchar_t** got = word_list_get_in_order(&list);
+    assert_int_equal(word_list_size(&list), 4);
+    for(int i = 0; i < 4; i++)
+    {
+        assert_true(wcscmp(got[i], expected[i]) == 0);
+        free(got[i]);
+    }
+    free(got);
+    word_list_done(&list);
+
+    dictionary_hints_top(dict, L"kot", 0, &options, &list);
+    assert_int_equal(word_list_size(&list), 0);
+    TEST_END;
+}
+
+///Tests ranking of the cheapest hints with confusion costs of letters.
+static void test_hints_weighted(void** state)
+{
+    TEST_EMPTY_BEGIN;
+    wchar_t* words[] = {L"ząb", L"żab", L"zub", L"zaba", L"kot"};
+    int words_len = sizeof(words)/sizeof(wchar_t*);
+    for(int i = 0; i < words_len; i++)
+        assert_true(dictionary_insert(dict, words[i]));
+    assert_true(dictionary_set_frequency(dict, L"zaba", 5));
+
+    Edit_Costs* costs = edit_costs_new();
+    edit_costs_set(costs, L'a', L'ą', 2);
+    edit_costs_set(costs, L'z', L'ż', 3);
+    assert_int_equal(edit_costs_replace(costs, L'ą', L'a'), 2);
+    assert_int_equal(edit_costs_replace(costs, L'a', L'b'), EDIT_COSTS_UNIT);
+    dictionary_set_costs(dict, costs);
+
+    Hints_Options options;
+    hints_default_options(&options);
+    struct word_list list;
+    assert_int_equal(dictionary_hints_weighted(dict, L"zab", 3, &options, &list), DICTIONARY_HINTS_COMPLETE);
+    wchar_t* expected[] = {L"ząb", L"żab", L"zaba"};
+    assert_int_equal(word_list_size(&list), 3);
+    int i = 0;
+    for(struct word_node* node = list.first; node != NULL; node = node->next, i++)
+        assert_true(wcscmp(node->word, expected[i]) == 0);
+    word_list_done(&list);
+
+    dictionary_set_costs(dict, NULL);
+    dictionary_hints_weighted(dict, L"zab", 10, &options, &list);
+    assert_int_equal(word_list_size(&list), 4); //every edit costs the same
+    assert_true(wcscmp(list.first->word, L"zaba") == 0);
+    word_list_done(&list);
+    TEST_END;
+}
+
+///Tests reading edit costs from a file.
+static void test_load_costs(void** state)
+{
+    FILE* file = tmpfile();
+    fputws(L"# comment\n\ndefault 20\na b 3\n", file);
+    rewind(file);
+    Edit_Costs* costs = edit_costs_load(file);
+    fclose(file);
+    assert_non_null(costs);
+    assert_int_equal(costs->insert_cost, 20);
+    assert_int_equal(edit_costs_replace(costs, L'b', L'a'), 3);
+    assert_int_equal(edit_costs_replace(costs, L'b', L'c'), 20);
+    edit_costs_free(costs);
+
+    file = tmpfile();
+    fputws(L"a b\n", file);
+    rewind(file);
+    assert_null(edit_costs_load(file));
+    fclose(file);
+}
+
+///Test of phonetic keys and sound-alike words, with and without index.
+static void test_sounds_like(void** state)
+{
+    const Phonetic_Rules* rules = phonetic_rules("pl_PL");
+    wchar_t* keys[][2] = {{L"morze", L"może"}, {L"wież", L"wiesz"}, {L"chleb", L"hlep"},
+                          {L"mąka", L"monka"}, {L"lekki", L"leki"}};
+    for(size_t i = 0; i < sizeof(keys) / sizeof(keys[0]); i++)
+    {
+        wchar_t* key = phonetic_key(keys[i][0], rules);
+        assert_true(wcscmp(key, keys[i][1]) == 0);
+        free(key);
+    }
+
+    TEST_EMPTY_BEGIN;
+    wchar_t* words[] = {L"może", L"morze", L"chleb", L"góra", L"kot"};
+    int words_len = sizeof(words)/sizeof(wchar_t*);
+    for(int i = 0; i < words_len; i++)
+        assert_true(dictionary_insert(dict, words[i]));
+
+    struct word_list list;
+    word_list_init(&list);
+    for(int with_index = 0; with_index < 2; with_index++)
+    {
+        if(with_index)
+            dictionary_phonetic_index_enable(dict);
+        assert_int_equal(dictionary_sounds_like(dict, L"może", &list), 2);
+        assert_true(wcscmp(list.first->word, L"morze") == 0);
+        assert_true(wcscmp(list.last->word, L"może") == 0);
+        word_list_done(&list);
+        assert_int_equal(dictionary_sounds_like(dict, L"hlep", &list), 1);
+        assert_true(wcscmp(list.first->word, L"chleb") == 0);
+        word_list_done(&list);
+    }
+
+    assert_true(dictionary_delete(dict, L"morze"));
+    assert_true(dictionary_insert(dict, L"gura"));
+    assert_int_equal(dictionary_sounds_like(dict, L"może", &list), 1);
+    word_list_done(&list);
+    assert_int_equal(dictionary_sounds_like(dict, L"góra", &list), 2);
+    word_list_done(&list);
+
+    Key_Index* index = key_index_new(phonetic_key, rules);
+    assert_int_equal(key_index_add(index, L"hata"), 1);
+    assert_int_equal(key_index_add(index, L"chata"), 1);
+    assert_int_equal(key_index_add(index, L"kot"), 1);
+    assert_int_equal(key_index_add(index, L"kot"), 0);
+    FILE* file = tmpfile();
+    key_index_save(index, file);
+    key_index_free(index);
+    rewind(file);
+    Key_Index* loaded = key_index_load(file, phonetic_key, rules);
+    fclose(file);
+    assert_non_null(loaded);
+    assert_int_equal(loaded->entry_count, 3);
+    assert_int_equal(key_index_find(loaded, L"hata", &list), 2);
+    assert_true(wcscmp(list.first->word, L"chata") == 0);
+    word_list_done(&list);
+    assert_int_equal(key_index_remove(loaded, L"hata"), 1);
+    assert_int_equal(key_index_remove(loaded, L"hata"), 0);
+    key_index_free(loaded);
+
+    file = tmpfile();
+    fputws(L"b\tb\na\ta\n", file); //not sorted
+    rewind(file);
+    assert_null(key_index_load(file, phonetic_key, rules));
+    fclose(file);
+    TEST_END;
+}
+
+///Test of the filter kept in sync with insertions and deletions.
+static void test_filter(void** state)
+{
+    TEST_EMPTY_BEGIN;
+    wchar_t word[] = L"aa";
+    for(int i = 0; i < 10; i++, word[0]++)
+        assert_true(dictionary_insert(dict, word));
+    dictionary_filter_enable(dict, 0.01, DICTIONARY_FILTER_DEFAULT_BYTES);
+    assert_non_null(dict->filter);
+    assert_int_equal(dict->filter->word_count, 10);
+    assert_int_equal(dict->filter->capacity, 20);
+    assert_int_equal(dict->filter->hash_count, 7);
+
+    for(int i = 0; i < 30; i++, word[0]++) //filter is rebuilt when full
+        assert_true(dictionary_insert(dict, word));
+    assert_true(dict->filter->capacity >= 40);
+    word[0] = L'a';
+    for(int i = 0; i < 40; i++, word[0]++)
+        assert_true(dictionary_find(dict, word));
+    assert_true(dictionary_delete(dict, L"aa"));
+    assert_false(dictionary_find(dict, L"aa"));
+    assert_int_equal(dict->filter->word_count, 39);
+
+    word[1] = L'b';
+    for(int i = 0; i < 40; i++, word[0]++)
+        assert_false(dictionary_find(dict, word));
+    size_t rejected, passed;
+    dictionary_filter_stats(dict, &rejected, &passed);
+    assert_int_equal(rejected + passed, 81);
+    assert_true(rejected >= 35);
+
+    dictionary_filter_disable(dict);
+    assert_null(dict->filter);
+    dictionary_filter_enable(dict, 0.5, 1); //budget smaller than a block
+    assert_int_equal(dict->filter->block_count, 1);
+    TEST_END;
+}
+
+///Test of the hash set of words, growing and reclaiming deleted slots.
+static void test_word_hash(void** state)
+{
+    TEST_EMPTY_BEGIN;
+    wchar_t word[] = L"aaa";
+    assert_true(dictionary_insert(dict, word));
+    dictionary_word_hash_enable(dict);
+    assert_non_null(dict->word_hash);
+    for(int i = 0; i < 400; i++)
+    {
+        word[1] = L'a' + i / 20;
+        word[2] = L'a' + i % 20;
+        dictionary_insert(dict, word);
+    }
+    assert_int_equal(dict->word_hash->word_count, 400);
+    assert_true(dict->word_hash->word_count * 8 <= dict->word_hash->group_count * WORD_HASH_GROUP * 7);
+    for(int round = 0; round < 3; round++)
+    {
+        for(int i = 0; i < 400; i += 2)
+        {
+            word[1] = L'a' + i / 20;
+            word[2] = L'a' + i % 20;
+            assert_true(dictionary_delete(dict, word));
+        }
+        for(int i = 0; i < 400; i++)
+        {
+            word[1] = L'a' + i / 20;
+            word[2] = L'a' + i % 20;
+            assert_int_equal(dictionary_find(dict, word), i % 2);
+            assert_int_equal(dictionary_find(dict, word), trie_find_word(dict->trie_root, word));
+        }
+        for(int i = 0; i < 400; i += 2)
+        {
+            word[1] = L'a' + i / 20;
+            word[2] = L'a' + i % 20;
+            assert_true(dictionary_insert(dict, word));
+        }
+    }
+    assert_int_equal(dict->word_hash->word_count, 400);
+    assert_false(dictionary_find(dict, L"zzz"));
+    assert_false(word_hash_remove(dict->word_hash, L"zzz"));
+    assert_false(word_hash_insert(dict->word_hash, L"aaa"));
+    dictionary_word_hash_disable(dict);
+    assert_null(dict->word_hash);
+    TEST_END;
+}
+
+///Test of the cache of dictionary_find(), dropped after modifications.
+static void test_find_cache(void** state)
+{
+    TEST_EMPTY_BEGIN;
+    assert_true(dictionary_insert(dict, L"kot"));
+    dictionary_find_cache_enable(dict, 3);
+    assert_int_equal(dict->find_cache->entry_count, 4);
+    size_t hits, misses;
+    for(int i = 0; i < 5; i++)
+    {
+        assert_true(dictionary_find(dict, L"kot"));
+        assert_false(dictionary_find(dict, L"pies"));
+    }
+    dictionary_find_cache_stats(dict, &hits, &misses);
+    assert_true(hits >= 6); //unless both words share an entry
+    assert_int_equal(hits + misses, 10);
+
+    assert_true(dictionary_insert(dict, L"pies"));
+    assert_true(dictionary_find(dict, L"pies"));
+    assert_true(dictionary_delete(dict, L"kot"));
+    assert_false(dictionary_find(dict, L"kot"));
+    assert_false(dictionary_find(dict, L"bardzo długie słowo"));
+    assert_false(dictionary_find(dict, L"bardzo długie słowo"));
+    dictionary_find_cache_stats(dict, &hits, &misses);
+    assert_int_equal(hits + misses, 14);
+    dictionary_find_cache_disable(dict);
+    assert_null(dict->find_cache);
+    TEST_END;
+}
+
+///Test of lockstep search, compared with dictionary_find().
+static void test_find_batch(void** state)
+{
+    TEST_EMPTY_BEGIN;
+    const wchar_t* words[100];
+    wchar_t texts[100][6];
+    bool results[100];
+    srand(7);
+    for(int i = 0; i < 100; i++)
+    {
+        int len = 1 + rand() % 5;
+        for(int j = 0; j < len; j++)
+            texts[i][j] = L'a' + rand() % 3;
+        texts[i][len] = L'\0';
+        words[i] = texts[i];
+        if(i % 3 == 0)
+            dictionary_insert(dict, texts[i]);
+    }
+    texts[1][0] = L'A';
+    texts[2][0] = L'\0';
+    for(int round = 0; round < 3; round++)
+    {
+        if(round == 1)
+            dictionary_filter_enable(dict, 0.1, DICTIONARY_FILTER_DEFAULT_BYTES);
+        if(round == 2)
+            dictionary_find_cache_enable(dict, FIND_CACHE_DEFAULT_ENTRIES);
+        dictionary_find_batch(dict, words, 100, results);
+        for(int i = 0; i < 100; i++)
+            if(i != 2)
+                assert_int_equal(results[i], dictionary_find(dict, words[i]));
+        assert_false(results[2]); //empty word
+    }
+    TEST_END;
+}
+
+///Test of cursor reading and unreading letters, also after modifications.
+static void test_cursor(void** state)
+{
+    TEST_EMPTY_BEGIN;
+    wchar_t* words[] = {L"kot", L"kotek", L"kotka", L"koza", L"pies"};
+    int words_len = sizeof(words)/sizeof(wchar_t*);
+    for(int i = 0; i < words_len; i++)
+        assert_true(dictionary_insert(dict, words[i]));
+
+    Dictionary_Cursor* cursor = dictionary_cursor_new(dict);
+    assert_true(dictionary_cursor_has_children(cursor));
+    assert_false(dictionary_cursor_is_word(cursor));
+    assert_true(dictionary_cursor_advance(cursor, L'K'));
+    assert_true(dictionary_cursor_advance(cursor, L'o'));
+    assert_true(dictionary_cursor_advance(cursor, L't'));
+    assert_true(dictionary_cursor_is_word(cursor));
+    assert_true(dictionary_cursor_has_children(cursor));
+
+    struct word_list list;
+    word_list_init(&list);
+    assert_int_equal(dictionary_cursor_completions(cursor, 2, &list), 2);
+    assert_true(wcscmp(list.first->word, L"kot") == 0);
+    assert_true(wcscmp(list.last->word, L"kotek") == 0);
+    word_list_done(&list);
+
+    assert_false(dictionary_cursor_advance(cursor, L'x'));
+    assert_false(dictionary_cursor_advance(cursor, L'y'));
+    assert_false(dictionary_cursor_is_word(cursor));
+    assert_int_equal(dictionary_cursor_completions(cursor, 10, &list), 0);
+    assert_true(dictionary_cursor_back(cursor));
+    assert_true(dictionary_cursor_back(cursor));
+    assert_true(dictionary_cursor_is_word(cursor));
+
+    assert_false(dictionary_cursor_advance(cursor, L'x'));
+    assert_false(dictionary_cursor_has_children(cursor));
+    assert_true(dictionary_insert(dict, L"kotx"));
+    assert_true(dictionary_cursor_is_word(cursor));
+    assert_true(dictionary_delete(dict, L"kotek"));
+    assert_true(dictionary_delete(dict, L"kotka"));
+    assert_true(dictionary_delete(dict, L"kotx"));
+    assert_false(dictionary_cursor_is_word(cursor));
+    assert_true(dictionary_cursor_back(cursor));
+    assert_true(dictionary_cursor_is_word(cursor));
+    assert_false(dictionary_cursor_has_children(cursor));
+    assert_int_equal(dictionary_cursor_completions(cursor, 10, &list), 1);
+    word_list_done(&list);
+
+    dictionary_cursor_reset(cursor);
+    assert_false(dictionary_cursor_back(cursor));
+    for(int i = 0; i < 100; i++)
+        dictionary_cursor_advance(cursor, L'p');
+    assert_int_equal(cursor->alive_length, 1);
+    dictionary_cursor_free(cursor);
+    TEST_END;
+}
+
+///Appends completions to the word list.
+static void add_completion(const wchar_t* word, unsigned frequency, void* data)
+{
+    (void) frequency;
+    word_list_add(data, word);
+}
+
+///Tests ranking of completions.
+static void test_complete(void** state)
+{
+    TEST_EMPTY_BEGIN;
+    wchar_t* words[] = {L"kot", L"kotek", L"kotka", L"koza", L"kozica", L"ko", L"pies"};
+    int words_len = sizeof(words)/sizeof(wchar_t*);
+    for(int i = 0; i < words_len; i++)
+        assert_true(dictionary_insert(dict, words[i]));
+    assert_true(dictionary_set_frequency(dict, L"kozica", 9));
+    assert_true(dictionary_set_frequency(dict, L"kotka", 5));
+    assert_true(dictionary_set_frequency(dict, L"kotek", 5));
+
+    struct word_list list;
+    word_list_init(&list);
+    assert_int_equal(dictionary_complete(dict, L"Ko", 3, DICTIONARY_COMPLETE_BY_FREQUENCY, add_completion, &list), 3);
+    wchar_t* by_frequency[] = {L"kozica", L"kotek", L"kotka"};
+    wchar_t** got = word_list_get_in_order(&list);
+    for(int i = 0; i < 3; i++)
+    {
+        assert_true(wcscmp(got[i], by_frequency[i]) == 0);
+        free(got[i]);
+    }
+    free(got);
+    word_list_done(&list);
+
+    word_list_init(&list);
+    assert_int_equal(dictionary_complete(dict, L"ko", 3, DICTIONARY_COMPLETE_BY_LENGTH, add_completion, &list), 3);
+    wchar_t* by_length[] = {L"ko", L"kot", L"koza"};
+    got = word_list_get_in_order(&list);
+    for(int i = 0; i < 3; i++)
+    {
+        assert_true(wcscmp(got[i], by_length[i]) == 0);
+        free(got[i]);
+    }
+    free(got);
+    word_list_done(&list);
+
+    word_list_init(&list);
+    assert_int_equal(dictionary_complete(dict, L"", 100, DICTIONARY_COMPLETE_BY_LENGTH, add_completion, &list),
+                     words_len);
+    assert_int_equal(dictionary_complete(dict, L"kox", 3, DICTIONARY_COMPLETE_BY_LENGTH, add_completion, &list), 0);
+    assert_int_equal(dictionary_complete(dict, L"pies", 0, DICTIONARY_COMPLETE_BY_LENGTH, add_completion, &list), 0);
+    word_list_done(&list);
+    TEST_END;
+}
+
+///Tests wildcard patterns.
+static void test_match(void** state)
+{
+    TEST_EMPTY_BEGIN;
+    wchar_t* words[] = {L"kat", L"kit", L"kot", L"kotek", L"koty", L"kt", L"pies", L"a]b"};
+    int words_len = sizeof(words)/sizeof(wchar_t*);
+    for(int i = 0; i < words_len; i++)
+        assert_true(dictionary_insert(dict, words[i]));
+
+    struct word_list list;
+    word_list_init(&list);
+    assert_int_equal(dictionary_match(dict, L"K?t", add_completion, &list), 3);
+    wchar_t** got = word_list_get_in_order(&list);
+    wchar_t* any_letter[] = {L"kat", L"kit", L"kot"};
+    for(int i = 0; i < 3; i++)
+    {
+        assert_true(wcscmp(got[i], any_letter[i]) == 0);
+        free(got[i]);
+    }
+    free(got);
+    word_list_done(&list);
+
+    word_list_init(&list);
+    assert_int_equal(dictionary_match(dict, L"k*t*", add_completion, &list), 6);
+    assert_int_equal(dictionary_match(dict, L"k**t", add_completion, &list), 4);
+    assert_int_equal(dictionary_match(dict, L"k[^a-i]t", add_completion, &list), 1);
+    assert_int_equal(dictionary_match(dict, L"?o???", add_completion, &list), 1);
+    assert_int_equal(dictionary_match(dict, L"*", add_completion, &list), words_len);
+    assert_int_equal(dictionary_match(dict, L"??????*", add_completion, &list), 0);
+    assert_int_equal(dictionary_match(dict, L"a[]]b", add_completion, &list), 1);
+    assert_int_equal(dictionary_match(dict, L"a\\]b", add_completion, &list), 1);
+    assert_int_equal(dictionary_match(dict, L"", add_completion, &list), 0);
+    assert_int_equal(dictionary_match(dict, L"k[a-", add_completion, &list), DICTIONARY_PATTERN_INVALID);
+    assert_int_equal(dictionary_match(dict, L"k[z-a]t", add_completion, &list), DICTIONARY_PATTERN_INVALID);
+    assert_int_equal(dictionary_match(dict, L"kot\\", add_completion, &list), DICTIONARY_PATTERN_INVALID);
+    word_list_done(&list);
+    TEST_END;
+}
+
+///Tests regular expressions.
+static void test_match_regex(void** state)
+{
+    TEST_EMPTY_BEGIN;
+    wchar_t* words[] = {L"ab", L"abab", L"abc", L"ac", L"b", L"ba", L"cab", L"kot", L"koty"};
+    int words_len = sizeof(words)/sizeof(wchar_t*);
+    for(int i = 0; i < words_len; i++)
+        assert_true(dictionary_insert(dict, words[i]));
+
+    struct word_list list;
+    word_list_init(&list);
+    assert_int_equal(dictionary_match_regex(dict, L"(AB)+", add_completion, &list), 2);
+    wchar_t** got = word_list_get_in_order(&list);
+    assert_true(wcscmp(got[0], L"ab") == 0);
+    assert_true(wcscmp(got[1], L"abab") == 0);
+    free(got[0]);
+    free(got[1]);
+    free(got);
+    word_list_done(&list);
+
+    word_list_init(&list);
+    assert_int_equal(dictionary_match_regex(dict, L"a[bc]", add_completion, &list), 2);
+    assert_int_equal(dictionary_match_regex(dict, L"^.b?.$", add_completion, &list), 4);
+    assert_int_equal(dictionary_match_regex(dict, L"kot|ba|x", add_completion, &list), 2);
+    assert_int_equal(dictionary_match_regex(dict, L"koty?", add_completion, &list), 2);
+    assert_int_equal(dictionary_match_regex(dict, L"[^k].*", add_completion, &list), 7);
+    assert_int_equal(dictionary_match_regex(dict, L"(a|b)*c", add_completion, &list), 2);
+    assert_int_equal(dictionary_match_regex(dict, L"z.*", add_completion, &list), 0);
+    assert_int_equal(dictionary_match_regex(dict, L"", add_completion, &list), 0);
+    assert_int_equal(dictionary_match_regex(dict, L"(ab", add_completion, &list), DICTIONARY_PATTERN_INVALID);
+    assert_int_equal(dictionary_match_regex(dict, L"ab)", add_completion, &list), DICTIONARY_PATTERN_INVALID);
+    assert_int_equal(dictionary_match_regex(dict, L"*a", add_completion, &list), DICTIONARY_PATTERN_INVALID);
+    assert_int_equal(dictionary_match_regex(dict, L"[b-a]", add_completion, &list), DICTIONARY_PATTERN_INVALID);
+    word_list_done(&list);
+    TEST_END;
+}
+
+///Tests anagrams and words formable from letters, with and without index.
+static void test_anagrams(void** state)
+{
+    wchar_t* key = anagram_key(L"kota", NULL);
+    assert_true(wcscmp(key, L"akot") == 0);
+    free(key);
+
+    TEST_EMPTY_BEGIN;
+    wchar_t* words[] = {L"kot", L"tok", L"kto", L"ok", L"o", L"kotka", L"tak", L"lis"};
+    int words_len = sizeof(words)/sizeof(wchar_t*);
+    for(int i = 0; i < words_len; i++)
+        assert_true(dictionary_insert(dict, words[i]));
+
+    struct word_list list;
+    word_list_init(&list);
+    for(int with_index = 0; with_index < 2; with_index++)
+    {
+        if(with_index)
+            dictionary_anagram_index_enable(dict);
+        assert_int_equal(dictionary_anagrams(dict, L"OTK", &list), 3);
+        assert_true(wcscmp(list.first->word, L"kot") == 0);
+        assert_true(wcscmp(list.last->word, L"tok") == 0);
+        word_list_done(&list);
+        assert_int_equal(dictionary_anagrams(dict, L"kk", &list), 0);
+        assert_int_equal(dictionary_formable(dict, L"tkoo", &list), 5);
+        word_list_done(&list);
+        assert_int_equal(dictionary_formable(dict, L"atkkoo", &list), 7);
+        word_list_done(&list);
+    }
+
+    assert_true(dictionary_delete(dict, L"tok"));
+    assert_true(dictionary_insert(dict, L"ktoś"));
+    assert_int_equal(dictionary_anagrams(dict, L"kot", &list), 2);
+    word_list_done(&list);
+    assert_int_equal(dictionary_formable(dict, L"śkot", &list), 5);
+    word_list_done(&list);
+    //too many subsets for probing, the trie is walked
+    assert_int_equal(dictionary_formable(dict, L"abcdefghijklmnot", &list), 5);
+    word_list_done(&list);
+    TEST_END;
+}
+
+///Tests suffix queries with and without the trie of reversed words.
+static void test_suffix_trie(void** state)
+{
+    TEST_EMPTY_BEGIN;
+    wchar_t* words[] = {L"pisanie", L"czytanie", L"granie", L"gra", L"kot", L"ie"};
+    int words_len = sizeof(words)/sizeof(wchar_t*);
+    for(int i = 0; i < words_len; i++)
+        assert_true(dictionary_insert(dict, words[i]));
+
+    struct word_list list;
+    word_list_init(&list);
+    for(int with_trie = 0; with_trie < 2; with_trie++)
+    {
+        if(with_trie)
+            dictionary_suffix_trie_enable(dict);
+        assert_int_equal(dictionary_ends_with(dict, L"aNIE", &list), 3);
+        word_list_done(&list);
+        assert_int_equal(dictionary_ends_with(dict, L"ie", &list), 4);
+        word_list_done(&list);
+        assert_int_equal(dictionary_ends_with(dict, L"xie", &list), 0);
+    }
+    assert_true(dictionary_delete(dict, L"granie"));
+    assert_true(dictionary_insert(dict, L"pranie"));
+    assert_int_equal(dictionary_ends_with(dict, L"ranie", &list), 1);
+    assert_true(wcscmp(list.first->word, L"pranie") == 0);
+    word_list_done(&list);
+
+    dictionary_suffix_trie_disable(dict);
+    assert_int_equal(dictionary_ends_with(dict, L"ranie", &list), 1);
+    word_list_done(&list);
+    TEST_END;
+}
+
+///Tests counting, rank and select of words.
+static void test_order_statistics(void** state)
+{
+    TEST_EMPTY_BEGIN;
+    assert_int_equal(dictionary_word_count(dict), 0);
+    uint64_t seed = 1;
+    assert_null(dictionary_sample(dict, &seed));
+    wchar_t* words[] = {L"a", L"ala", L"alan", L"kot", L"kotek", L"koza", L"pies"};
+    int words_len = sizeof(words)/sizeof(wchar_t*);
+    for(int i = words_len - 1; i >= 0; i--)
+        assert_true(dictionary_insert(dict, words[i]));
+    assert_false(dictionary_insert(dict, L"kot"));
+
+    assert_int_equal(dictionary_word_count(dict), words_len);
+    for(int i = 0; i < words_len; i++)
+    {
+        assert_int_equal(dictionary_rank(dict, words[i]), i);
+        wchar_t* word = dictionary_select(dict, i);
+        assert_true(wcscmp(word, words[i]) == 0);
+        free(word);
+    }
+    assert_null(dictionary_select(dict, words_len));
+    assert_int_equal(dictionary_rank(dict, L"al"), 1);
+    assert_int_equal(dictionary_rank(dict, L"kotz"), 5);
+    assert_int_equal(dictionary_rank(dict, L"zebra"), words_len);
+    assert_int_equal(dictionary_rank(dict, L""), 0);
+    assert_int_equal(dictionary_prefix_count(dict, L"Ko"), 3);
+    assert_int_equal(dictionary_prefix_count(dict, L"kot"), 2);
+    assert_int_equal(dictionary_prefix_count(dict, L"x"), 0);
+    assert_int_equal(dictionary_prefix_count(dict, L""), words_len);
+
+    assert_true(dictionary_delete(dict, L"kot"));
+    assert_false(dictionary_delete(dict, L"kot"));
+    assert_int_equal(dictionary_word_count(dict), words_len - 1);
+    assert_int_equal(dictionary_prefix_count(dict, L"kot"), 1);
+    assert_int_equal(dictionary_rank(dict, L"pies"), words_len - 2);
+
+    uint64_t other_seed = 1;
+    for(int i = 0; i < 20; i++)
+    {
+        wchar_t* word = dictionary_sample(dict, &seed);
+        wchar_t* same = dictionary_sample(dict, &other_seed);
+        assert_true(dictionary_find(dict, word));
+        assert_true(wcscmp(word, same) == 0);
+        free(word);
+        free(same);
+    }
+    TEST_END;
+}
+
+///Tests identifiers of words used as indices of a side table.
+static void test_word_ids(void** state)
+{
+    TEST_EMPTY_BEGIN;
+    wchar_t* words[] = {L"pies", L"kot", L"kotek", L"ala", L"a"};
+    unsigned lengths[] = {4, 3, 5, 3, 1};
+    int words_len = sizeof(words)/sizeof(wchar_t*);
+    for(int i = 0; i < words_len; i++)
+        assert_true(dictionary_insert(dict, words[i]));
+
+    unsigned table[5];
+    for(int i = 0; i < words_len; i++)
+    {
+        size_t id = dictionary_find_id(dict, words[i]);
+        assert_true(id < dictionary_word_count(dict));
+        table[id] = lengths[i];
+    }
+    for(size_t id = 0; id < dictionary_word_count(dict); id++)
+    {
+        wchar_t* word = dictionary_word_by_id(dict, id);
+        assert_int_equal(wcslen(word), table[id]);
+        assert_int_equal(dictionary_find_id(dict, word), id);
+        free(word);
+    }
+    assert_int_equal(dictionary_find_id(dict, L"KOT"), 2);
+    assert_int_equal(dictionary_find_id(dict, L"ko"), DICTIONARY_NO_ID);
+    assert_int_equal(dictionary_find_id(dict, L"kotki"), DICTIONARY_NO_ID);
+    assert_null(dictionary_word_by_id(dict, words_len));
+    TEST_END;
+}
+
+///Tests iterating over words in order, seeking and modifications while iterating.
+static void test_iterator(void** state)
+{
+    TEST_EMPTY_BEGIN;
+    wchar_t* words[] = {L"pies", L"kot", L"kotek", L"ala", L"a"};
+    wchar_t* sorted[] = {L"a", L"ala", L"kot", L"kotek", L"pies"};
+    for(int i = 0; i < 5; i++)
+        assert_true(dictionary_insert(dict, words[i]));
+
+    Dictionary_Iterator* iterator = dictionary_iterator_new(dict);
+    for(int i = 0; i < 5; i++)
+        assert_true(wcscmp(dictionary_iterator_next(iterator), sorted[i]) == 0);
+    assert_null(dictionary_iterator_next(iterator));
+
+    dictionary_iterator_seek(iterator, L"KO");
+    assert_true(wcscmp(dictionary_iterator_next(iterator), L"kot") == 0);
+    assert_true(dictionary_delete(dict, L"kot"));
+    assert_true(dictionary_insert(dict, L"kota"));
+    assert_true(dictionary_insert(dict, L"b"));
+    assert_true(wcscmp(dictionary_iterator_next(iterator), L"kota") == 0);
+    assert_true(wcscmp(dictionary_iterator_next(iterator), L"kotek") == 0);
+
+    dictionary_iterator_seek(iterator, L"c");
+    assert_true(dictionary_delete(dict, L"kota"));
+    assert_true(wcscmp(dictionary_iterator_next(iterator), L"kotek") == 0);
+    assert_true(wcscmp(dictionary_iterator_next(iterator), L"pies") == 0);
+    assert_null(dictionary_iterator_next(iterator));
+    dictionary_iterator_free(iterator);
+    TEST_END;
+}
+
+///Tests set operations on dictionaries.
+static void test_merge(void** state)
+{
+    TEST_EMPTY_BEGIN;
+    Dictionary* other = dictionary_new();
+    assert_true(dictionary_insert(dict, L"kot"));
+    assert_true(dictionary_insert(dict, L"pies"));
+    assert_true(dictionary_insert(other, L"kot"));
+    assert_true(dictionary_insert(other, L"żółw"));
+    dictionary_set_frequency(dict, L"kot", 3);
+    dictionary_set_frequency(other, L"kot", 8);
+
+    Dictionary* merged = dictionary_merge(dict, other, DICTIONARY_UNION);
+    assert_int_equal(dictionary_word_count(merged), 3);
+    assert_true(dictionary_find(merged, L"żółw"));
+    assert_int_equal(dictionary_frequency(merged, L"kot"), 8);
+    assert_true(dictionary_insert(merged, L"ćma"));
+    assert_int_equal(dictionary_word_count(merged), 4);
+    dictionary_done(merged);
+
+    merged = dictionary_merge(dict, other, DICTIONARY_INTERSECTION);
+    assert_int_equal(dictionary_word_count(merged), 1);
+    assert_true(dictionary_find(merged, L"kot"));
+    dictionary_done(merged);
+
+    merged = dictionary_merge(dict, other, DICTIONARY_DIFFERENCE);
+    assert_int_equal(dictionary_word_count(merged), 1);
+    assert_true(dictionary_find(merged, L"pies"));
+    assert_true(dictionary_delete(merged, L"pies"));
+    assert_int_equal(dictionary_word_count(merged), 0);
+    dictionary_done(merged);
+    dictionary_done(other);
+    TEST_END;
+}
+
+///Tests front coded files, searched without loading and loaded back.
+static void test_packed(void** state)
+{
+    TEST_EMPTY_BEGIN;
+    wchar_t word[8] = L"aaa";
+    for(int i = 0; i < 100; i++) //more words than in one block
+    {
+        word[1] = L'a' + i / 10;
+        word[2] = L'a' + i % 10;
+        assert_true(dictionary_insert(dict, word));
+    }
+    assert_true(dictionary_insert(dict, L"żółw"));
+    assert_true(dictionary_insert(dict, L"a"));
+    assert_true(dictionary_set_frequency(dict, L"ajj", 7));
+
+    FILE* file = tmpfile();
+    assert_int_equal(dictionary_save_packed(dict, file), DICTIONARY_SAVE_SUCCESS);
+    Front_Coded* coded = front_coding_open(file);
+    assert_non_null(coded);
+    assert_int_equal(coded->word_count, 102);
+    assert_int_equal(coded->block_count, (102 + FRONT_CODING_BLOCK_WORDS - 1) / FRONT_CODING_BLOCK_WORDS);
+    unsigned frequency = 0;
+    assert_true(front_coding_find(coded, L"ajj", &frequency));
+    assert_int_equal(frequency, 7);
+    assert_true(front_coding_find(coded, L"a", NULL));
+    assert_true(front_coding_find(coded, L"aaa", NULL));
+    assert_true(front_coding_find(coded, L"żółw", NULL));
+    assert_false(front_coding_find(coded, L"aa", NULL));
+    assert_false(front_coding_find(coded, L"ajja", NULL));
+    assert_false(front_coding_find(coded, L"", NULL));
+    assert_false(front_coding_find(coded, L"żółwie", NULL));
+    front_coding_close(coded);
+
+    Dictionary* loaded = dictionary_load_packed(file);
+    assert_non_null(loaded);
+    assert_int_equal(dictionary_word_count(loaded), 102);
+    assert_int_equal(dictionary_frequency(loaded, L"ajj"), 7);
+    assert_true(dictionary_hash(loaded) == dictionary_hash(dict));
+    assert_true(dictionary_find(loaded, L"żółw"));
+    dictionary_done(loaded);
+    fclose(file);
+
+    file = tmpfile();
+    fputs("FCW1 broken", file);
+    assert_null(front_coding_open(file));
+    assert_null(dictionary_load_packed(file));
+    fclose(file);
+    TEST_END;
+}
+
 //IO TESTS
 extern char* get_io_buffer(void);
 extern void reset_io_buffer(void);
+extern wchar_t testing_fputwc(wchar_t sign, FILE* stream);
 #define io_buffer (get_io_buffer()) ///<Shortening macro
 
+///Tests saving of the hash and of a delta between dictionaries.
+static void test_io_delta(void** state)
+{
+    reset_io_buffer();
+    TEST_EMPTY_BEGIN;
+    wchar_t* words[] = {L"kot", L"kotek", L"pies", L"ala"};
+    for(int i = 0; i < 4; i++)
+        assert_true(dictionary_insert(dict, words[i]));
+    uint64_t hash = dictionary_hash(dict);
+    dictionary_save(dict, (FILE*) 42);
+    dictionary_done(dict);
+    dict = dictionary_load((FILE*) 42);
+    assert_true(dict->trie_root->hash == hash);
+    *state = dict;
+
+    Dictionary* changed = dictionary_merge(dict, dict, DICTIONARY_UNION);
+    assert_true(dictionary_hash(changed) == hash);
+    assert_true(dictionary_delete(changed, L"kot"));
+    assert_true(dictionary_insert(changed, L"żółw"));
+    assert_true(dictionary_set_frequency(changed, L"pies", 12));
+    assert_true(dictionary_hash(changed) != hash);
+
+    reset_io_buffer();
+    assert_int_equal(dictionary_save_delta(dict, changed, (FILE*) 42), 3);
+    assert_int_equal(dictionary_apply_delta(dict, (FILE*) 42), 3);
+    assert_true(dictionary_hash(dict) == dictionary_hash(changed));
+    assert_false(dictionary_find(dict, L"kot"));
+    assert_true(dictionary_find(dict, L"żółw"));
+    assert_int_equal(dictionary_frequency(dict, L"pies"), 12);
+
+    reset_io_buffer();
+    dictionary_save_delta(dict, dict, (FILE*) 42);
+    assert_true(dictionary_delete(dict, L"ala"));
+    assert_int_equal(dictionary_apply_delta(dict, (FILE*) 42), DICTIONARY_DELTA_INVALID);
+
+    reset_io_buffer();
+    assert_int_equal(dictionary_save_delta(dict, changed, (FILE*) 42), 1);
+    wchar_t* signs = (wchar_t*) io_buffer;
+    while(*signs != L'.') //the stop sign
+        signs++;
+    *signs = WEOF;
+    hash = dictionary_hash(dict);
+    assert_int_equal(dictionary_apply_delta(dict, (FILE*) 42), DICTIONARY_DELTA_INVALID);
+    assert_false(dictionary_find(dict, L"ala"));
+    assert_true(dictionary_hash(dict) == hash);
+    reset_io_buffer();
+    dictionary_save_delta(dict, changed, (FILE*) 42);
+    assert_int_equal(dictionary_apply_delta(dict, (FILE*) 42), 1);
+    assert_true(dictionary_find(dict, L"ala"));
+    dictionary_done(changed);
+    TEST_END;
+}
+
+///Tests whether file exists.
+static bool exists(const char* path)
+{
+    FILE* file = fopen(path, "r");
+    if(file != NULL)
+        fclose(file);
+    return file != NULL;
+}
+
+///Tests appending changes to the journal, its replay and compaction.
+static void test_io_journal(void** state)
+{
+    //files are created, but their contents go to the io buffer one after another
+    const char* path = "journal_test.dict";
+    const char* journal_path = "journal_test.dict" DICTIONARY_JOURNAL_SUFFIX;
+    remove(journal_path);
+    reset_io_buffer();
+    TEST_EMPTY_BEGIN;
+    wchar_t* words[] = {L"kot", L"pies", L"ala"};
+    for(int i = 0; i < 3; i++)
+        assert_true(dictionary_insert(dict, words[i]));
+    dictionary_journal_enable(dict, 3);
+    assert_int_equal(dictionary_save_file(dict, path), DICTIONARY_SAVE_SUCCESS);
+    assert_false(exists(journal_path));
+    testing_fputwc(L'\n', (FILE*) 42); //read by loading after the last section
+
+    assert_true(dictionary_insert(dict, L"kotek"));
+    assert_true(dictionary_delete(dict, L"kot"));
+    assert_true(dictionary_set_frequency(dict, L"ala", 5));
+    assert_int_equal(dictionary_save_file(dict, path), DICTIONARY_SAVE_SUCCESS);
+    assert_true(exists(journal_path));
+    assert_int_equal(dict->journal->line_count, 3);
+
+    Dictionary* loaded = dictionary_load_file(path);
+    assert_non_null(loaded);
+    assert_true(dictionary_find(loaded, L"kotek"));
+    assert_false(dictionary_find(loaded, L"kot"));
+    assert_int_equal(dictionary_frequency(loaded, L"ala"), 5);
+    assert_true(dictionary_hash(loaded) == dictionary_hash(dict));
+    assert_int_equal(loaded->journal->line_count, 3);
+    assert_false(loaded->journal->broken);
+    dictionary_done(loaded);
+
+    reset_io_buffer();
+    assert_true(dictionary_insert(dict, L"żółw")); //past the threshold
+    assert_int_equal(dictionary_save_file(dict, path), DICTIONARY_SAVE_SUCCESS);
+    assert_false(exists(journal_path));
+    assert_int_equal(dict->journal->line_count, 0);
+    loaded = dictionary_load_file(path);
+    assert_non_null(loaded);
+    assert_true(dictionary_find(loaded, L"żółw"));
+    assert_true(dictionary_hash(loaded) == dictionary_hash(dict));
+    assert_int_equal(loaded->journal->line_count, 0);
+    dictionary_done(loaded);
+    remove(path);
+    TEST_END;
+}
+
 ///Simple test checking mainly correctness of the written alphabet.
 static void test_io_dictionary(void** state)
 {
@@ -308,9 +1362,17 @@ static void test_io_dictionary(void** state)
     for(int i = 0; i < hints_len; i++)
         assert_true(dictionary_insert(dict, hints[i]));
 
+    assert_true(dictionary_set_frequency(dict, L"qb", 3));
+    dictionary_filter_enable(dict, 0.01, COUNTING_FILTER_BLOCK_BYTES);
+
     dictionary_save(dict, (FILE*) 42);
     dictionary_done(dict);
     dict = dictionary_load((FILE*) 42);
+    assert_int_equal(dictionary_frequency(dict, L"qb"), 3);
+    assert_int_equal(dictionary_frequency(dict, L"qc"), 0);
+    assert_non_null(dict->filter);
+    assert_int_equal(dict->filter->word_count, hints_len + 1);
+    assert_true(dictionary_find(dict, L"qp"));
 
     Word_List* hlist = word_list_new();
     dictionary_hints(dict, hintee, hlist);
@@ -346,9 +1408,35 @@ int main(int argc, char** argv)
 
         //cmocka_unit_test(test_hints_replace),
         cmocka_unit_test(test_hints_add),
+        cmocka_unit_test(test_hints_spelling),
         cmocka_unit_test(test_hints_replace),
         cmocka_unit_test(test_hints_delete),
-        cmocka_unit_test(test_io_dictionary)
+        cmocka_unit_test(test_hints_limits),
+        cmocka_unit_test(test_hints_long_word),
+        cmocka_unit_test(test_hints_batch),
+        cmocka_unit_test(test_hints_cache),
+        cmocka_unit_test(test_hints_top),
+        cmocka_unit_test(test_hints_weighted),
+        cmocka_unit_test(test_load_costs),
+        cmocka_unit_test(test_sounds_like),
+        cmocka_unit_test(test_filter),
+        cmocka_unit_test(test_word_hash),
+        cmocka_unit_test(test_find_cache),
+        cmocka_unit_test(test_find_batch),
+        cmocka_unit_test(test_cursor),
+        cmocka_unit_test(test_complete),
+        cmocka_unit_test(test_match),
+        cmocka_unit_test(test_match_regex),
+        cmocka_unit_test(test_anagrams),
+        cmocka_unit_test(test_suffix_trie),
+        cmocka_unit_test(test_order_statistics),
+        cmocka_unit_test(test_word_ids),
+        cmocka_unit_test(test_iterator),
+        cmocka_unit_test(test_merge),
+        cmocka_unit_test(test_packed),
+        cmocka_unit_test(test_io_dictionary),
+        cmocka_unit_test(test_io_delta),
+        cmocka_unit_test(test_io_journal)
     };
     cmocka_run_group_tests_name("Dict-tests", multi_tests, NULL, NULL);
 }
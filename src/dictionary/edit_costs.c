@@ -0,0 +1,158 @@
+/** @file
+    Implementation of edit costs table.
+    @ingroup edit_costs
+    @author agent
+    @date 2026-10
+  */
+
+#include <stdlib.h>
+#include <wchar.h>
+#include <wctype.h>
+#include <string.h>
+#include <assert.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "edit_costs.h"
+#include "error_handling.h"
+
+#ifdef EDIT_COSTS_UNIT_TESTING
+#include <stdarg.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#ifdef malloc
+#undef malloc
+#endif // malloc
+#define malloc(size) _test_malloc(size, __FILE__, __LINE__)
+
+#ifdef realloc
+#undef realloc
+#endif // realloc
+#define realloc(ptr, size) _test_realloc(ptr, size, __FILE__, __LINE__)
+
+#ifdef free
+#undef free
+#endif // free
+#define free(ptr) _test_free(ptr, __FILE__, __LINE__)
+
+#ifdef assert
+#undef assert
+#define assert(expression) mock_assert((int)(expression), #expression, __FILE__, __LINE__);
+#endif
+#endif // EDIT_COSTS_UNIT_TESTING
+
+Edit_Costs* edit_costs_new(void)
+{
+    Edit_Costs* ret = malloc(sizeof(Edit_Costs));
+    if(ret == NULL) report_error(MEMORY);
+    ret->insert_cost = EDIT_COSTS_UNIT;
+    ret->delete_cost = EDIT_COSTS_UNIT;
+    ret->replace_cost = EDIT_COSTS_UNIT;
+    ret->pairs = NULL;
+    ret->pair_count = 0;
+    ret->array_size = 0;
+    return ret;
+}
+
+void edit_costs_free(Edit_Costs* costs)
+{
+    assert(costs != NULL);
+    free(costs->pairs);
+    free(costs);
+}
+
+///Comparison function of pairs, by from letter, then by to letter.
+static int cmp_pair(const void* a, const void* b)
+{
+    const Edit_Cost_Pair* x = a;
+    const Edit_Cost_Pair* y = b;
+    if(x->from != y->from)
+        return x->from < y->from ? -1 : 1;
+    if(x->to != y->to)
+        return x->to < y->to ? -1 : 1;
+    return 0;
+}
+
+/**
+ * @brief set_pair Sets cost of replacing from with to, keeping pairs sorted.
+ * @param costs The table.
+ * @param from Letter of the word.
+ * @param to Letter of the hint.
+ * @param cost The cost.
+ */
+static void set_pair(Edit_Costs* costs, wchar_t from, wchar_t to, int cost)
+{
+    Edit_Cost_Pair pair = {.from = from, .to = to, .cost = cost};
+    Edit_Cost_Pair* found = bsearch(&pair, costs->pairs, costs->pair_count, sizeof(Edit_Cost_Pair), cmp_pair);
+    if(found != NULL)
+    {
+        found->cost = cost;
+        return;
+    }
+    if(costs->pair_count == costs->array_size)
+    {
+        costs->array_size = costs->array_size == 0 ? 8 : costs->array_size * 2;
+        costs->pairs = realloc(costs->pairs, sizeof(Edit_Cost_Pair) * costs->array_size);
+        if(costs->pairs == NULL) report_error(MEMORY);
+    }
+    size_t position = costs->pair_count;
+    while(position > 0 && cmp_pair(&costs->pairs[position-1], &pair) > 0)
+    {
+        costs->pairs[position] = costs->pairs[position-1];
+        position--;
+    }
+    costs->pairs[position] = pair;
+    costs->pair_count++;
+}
+
+void edit_costs_set(Edit_Costs* costs, wchar_t a, wchar_t b, int cost)
+{
+    assert(costs != NULL);
+    assert(a != b);
+    assert(cost >= 0);
+    set_pair(costs, a, b, cost);
+    set_pair(costs, b, a, cost);
+}
+
+int edit_costs_replace(const Edit_Costs* costs, wchar_t from, wchar_t to)
+{
+    if(from == to)
+        return 0;
+    if(costs->pair_count == 0)
+        return costs->replace_cost;
+    Edit_Cost_Pair pair = {.from = from, .to = to};
+    const Edit_Cost_Pair* found = bsearch(&pair, costs->pairs, costs->pair_count, sizeof(Edit_Cost_Pair), cmp_pair);
+    return found == NULL ? costs->replace_cost : found->cost;
+}
+
+Edit_Costs* edit_costs_load(FILE* file)
+{
+    assert(file != NULL);
+
+    Edit_Costs* ret = edit_costs_new();
+    wchar_t line[EDIT_COSTS_MAX_LINE];
+    while(fgetws(line, EDIT_COSTS_MAX_LINE, file) != NULL)
+    {
+        wchar_t a, b;
+        int cost;
+        wchar_t* start = line;
+        while(iswspace(*start))
+            start++;
+        if(*start == L'\0' || *start == L'#')
+            continue;
+        if(swscanf(start, L"default %d", &cost) == 1 && cost > 0)
+        {
+            ret->insert_cost = cost;
+            ret->delete_cost = cost;
+            ret->replace_cost = cost;
+        }
+        else if(swscanf(start, L"%lc %lc %d", &a, &b, &cost) == 3 && a != b && cost >= 0)
+            edit_costs_set(ret, towlower(a), towlower(b), cost);
+        else
+        {
+            edit_costs_free(ret);
+            return NULL;
+        }
+    }
+    return ret;
+}
@@ -0,0 +1,85 @@
+#ifndef EDIT_COSTS_H_INCLUDED
+#define EDIT_COSTS_H_INCLUDED
+
+/** @defgroup edit_costs Module edit_costs
+ * Costs of single edits, used to rank hints of typical mistakes first.
+ */
+/**
+ * @file edit_costs.h Header file of module edit_costs.
+ * @ingroup edit_costs
+ * @author agent <agent@local>
+ * @date 2026-10
+ */
+
+#include <stdio.h>
+#include <stddef.h>
+#include <wchar.h>
+
+#define EDIT_COSTS_UNIT 10 ///<Default cost of an insertion, deletion or replacement, cost of one edit of Hints_Options::max_edits.
+#define EDIT_COSTS_MAX_LINE 256 ///<Maximal length of a line of a cost table file.
+
+/**
+ * Cost of replacing one letter with another.
+ */
+typedef struct
+{
+    wchar_t from; ///<Letter of the word.
+    wchar_t to; ///<Letter of the hint.
+    int cost; ///<Cost of the replacement.
+} Edit_Cost_Pair;
+
+/**
+ * Table of edit costs.
+ * <p>
+ * A cost table file contains lines "a ą 2", meaning that replacing a with ą
+ * and ą with a costs 2 instead of replace_cost. A line "default 10" sets cost of every
+ * insertion, deletion and other replacement. Empty lines and lines starting with # are skipped.
+ */
+typedef struct
+{
+    int insert_cost; ///<Cost of a letter missing in the word, must be positive.
+    int delete_cost; ///<Cost of a superfluous letter in the word.
+    int replace_cost; ///<Cost of replacing a letter not mentioned in pairs.
+    Edit_Cost_Pair* pairs; ///<Costs of replacements, sorted by from, then to.
+    size_t pair_count; ///<Number of pairs.
+    size_t array_size; ///<Size of pairs array.
+} Edit_Costs;
+
+/**
+ * @brief edit_costs_new Creates a table with every edit costing EDIT_COSTS_UNIT.
+ * @return Pointer to the new table.
+ */
+Edit_Costs* edit_costs_new(void);
+
+/**
+ * @brief edit_costs_free Deallocates the table.
+ * @param costs The table.
+ */
+void edit_costs_free(Edit_Costs* costs);
+
+/**
+ * @brief edit_costs_set Sets cost of replacing a with b and b with a.
+ * @param costs The table.
+ * @param a First letter.
+ * @param b Second letter, different from a.
+ * @param cost Non-negative cost.
+ */
+void edit_costs_set(Edit_Costs* costs, wchar_t a, wchar_t b, int cost);
+
+/**
+ * @brief edit_costs_replace Returns cost of replacing a letter of the word with a letter of the hint.
+ * @param costs The table.
+ * @param from Letter of the word.
+ * @param to Letter of the hint.
+ * @return 0 if letters are equal, cost from the table otherwise.
+ */
+int edit_costs_replace(const Edit_Costs* costs, wchar_t from, wchar_t to);
+
+/**
+ * @brief edit_costs_load Reads a cost table file.
+ * @param file File to read from.
+ * @return Pointer to the new table or NULL, if the file is malformed.
+ */
+Edit_Costs* edit_costs_load(FILE* file);
+
+#endif // EDIT_COSTS_H_INCLUDED
@@ -0,0 +1,269 @@
+/** @file
+    Implementation of bit-parallel edit distance.
+    @ingroup edit_distance
+    @author agent
+    @date 2026-10
+  */
+
+#include <stdlib.h>
+#include <wchar.h>
+#include <string.h>
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "edit_distance.h"
+#include "error_handling.h"
+
+#ifdef EDIT_DISTANCE_UNIT_TESTING
+#include <stdarg.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#ifdef malloc
+#undef malloc
+#endif // malloc
+#define malloc(size) _test_malloc(size, __FILE__, __LINE__)
+
+#ifdef calloc
+#undef calloc
+#endif // calloc
+#define calloc(num, size) _test_calloc(num, size, __FILE__, __LINE__)
+
+#ifdef free
+#undef free
+#endif // free
+#define free(ptr) _test_free(ptr, __FILE__, __LINE__)
+
+#ifdef assert
+#undef assert
+#define assert(expression) mock_assert((int)(expression), #expression, __FILE__, __LINE__);
+#endif
+#endif // EDIT_DISTANCE_UNIT_TESTING
+
+///Comparison function to sort letters of the pattern.
+static int cmp_letter(const void* a, const void* b)
+{
+    wchar_t x = *(const wchar_t*) a;
+    wchar_t y = *(const wchar_t*) b;
+    if(x < y) return -1;
+    if(x > y) return 1;
+    return 0;
+}
+
+/**
+ * @brief letter_index Finds position of the letter among distinct letters of the pattern.
+ * @param pattern The pattern.
+ * @param letter The letter.
+ * @return Index of the letter or -1 if the pattern does not contain it.
+ */
+static int letter_index(const Edit_Pattern* pattern, wchar_t letter)
+{
+    if(letter >= 0 && letter < EDIT_DISTANCE_DIRECT_LETTERS)
+        return (int) pattern->direct[letter] - 1;
+    wchar_t* found = bsearch(&letter, pattern->letters, pattern->letter_count, sizeof(wchar_t), cmp_letter);
+    return found == NULL ? -1 : (int) (found - pattern->letters);
+}
+
+Edit_Pattern* edit_pattern_new(const wchar_t* pattern)
+{
+    assert(pattern != NULL);
+
+    Edit_Pattern* ret = malloc(sizeof(Edit_Pattern));
+    if(ret == NULL) report_error(MEMORY);
+    memset(ret, 0, sizeof(Edit_Pattern));
+    ret->len = wcslen(pattern);
+    ret->blocks = (ret->len + EDIT_DISTANCE_BLOCK_BITS - 1) / EDIT_DISTANCE_BLOCK_BITS;
+
+    ret->letters = malloc(sizeof(wchar_t) * (ret->len + 1));
+    if(ret->letters == NULL) report_error(MEMORY);
+    memcpy(ret->letters, pattern, sizeof(wchar_t) * ret->len);
+    qsort(ret->letters, ret->len, sizeof(wchar_t), cmp_letter);
+    for(int i = 0; i < ret->len; i++)
+        if(ret->letter_count == 0 || ret->letters[ret->letter_count - 1] != ret->letters[i])
+            ret->letters[ret->letter_count++] = ret->letters[i];
+    for(int i = 0; i < ret->letter_count; i++)
+        if(ret->letters[i] >= 0 && ret->letters[i] < EDIT_DISTANCE_DIRECT_LETTERS)
+            ret->direct[ret->letters[i]] = i + 1; //small letters come first, so index fits
+
+    ret->masks = calloc((size_t) ret->letter_count * ret->blocks + 1, sizeof(uint64_t));
+    if(ret->masks == NULL) report_error(MEMORY);
+    for(int i = 0; i < ret->len; i++)
+    {
+        uint64_t* masks = ret->masks + (size_t) letter_index(ret, pattern[i]) * ret->blocks;
+        masks[i / EDIT_DISTANCE_BLOCK_BITS] |= (uint64_t) 1 << (i % EDIT_DISTANCE_BLOCK_BITS);
+    }
+    return ret;
+}
+
+void edit_pattern_free(Edit_Pattern* pattern)
+{
+    assert(pattern != NULL);
+    free(pattern->letters);
+    free(pattern->masks);
+    free(pattern);
+}
+
+/**
+ * @brief distance_single Computes the distance for pattern of at most one block.
+ * @param pattern The pattern, 0 < pattern->len <= EDIT_DISTANCE_BLOCK_BITS.
+ * @param text The text.
+ * @param transpositions True for Damerau distance.
+ * @return The distance.
+ * Bit i of vp (vn) tells that the distance of prefix i+1 of the pattern is greater (smaller) by one
+ * than the distance of prefix i, in the current column of the dynamic programming matrix.
+ */
+static int distance_single(const Edit_Pattern* pattern, const wchar_t* text, bool transpositions)
+{
+    const uint64_t last = (uint64_t) 1 << (pattern->len - 1);
+    uint64_t vp = ~(uint64_t) 0;
+    uint64_t vn = 0;
+    uint64_t d0 = 0;
+    uint64_t pm_prev = 0;
+    int score = pattern->len;
+
+    for(int j = 0; text[j] != L'\0'; j++)
+    {
+        int index = letter_index(pattern, text[j]);
+        uint64_t pm = index < 0 ? 0 : pattern->masks[index];
+        uint64_t tr = transpositions ? (((~d0) & pm) << 1) & pm_prev : 0;
+        d0 = (((pm & vp) + vp) ^ vp) | pm | vn | tr;
+        uint64_t hp = vn | ~(d0 | vp);
+        uint64_t hn = d0 & vp;
+        if(hp & last)
+            score++;
+        else if(hn & last)
+            score--;
+        hp = (hp << 1) | 1;
+        hn <<= 1;
+        vp = hn | ~(d0 | hp);
+        vn = d0 & hp;
+        pm_prev = pm;
+    }
+    return score;
+}
+
+/**
+ * @brief distance_blocks Computes the distance for pattern longer than one block.
+ * @param pattern The pattern.
+ * @param text The text.
+ * @param transpositions True for Damerau distance.
+ * @return The distance.
+ * Works as distance_single() on vectors of pattern->blocks words, carrying the addition and shifts
+ * from lower blocks to higher ones.
+ */
+static int distance_blocks(const Edit_Pattern* pattern, const wchar_t* text, bool transpositions)
+{
+    const int blocks = pattern->blocks;
+    const uint64_t last = (uint64_t) 1 << ((pattern->len - 1) % EDIT_DISTANCE_BLOCK_BITS);
+    const uint64_t top = (uint64_t) 1 << (EDIT_DISTANCE_BLOCK_BITS - 1);
+
+    uint64_t* vectors = malloc(sizeof(uint64_t) * 3 * blocks);
+    if(vectors == NULL) report_error(MEMORY);
+    uint64_t* vp = vectors;
+    uint64_t* vn = vectors + blocks;
+    uint64_t* d0 = vectors + 2 * blocks;
+    for(int b = 0; b < blocks; b++)
+    {
+        vp[b] = ~(uint64_t) 0;
+        vn[b] = 0;
+        d0[b] = 0;
+    }
+    const uint64_t* pm_prev = NULL;
+    int score = pattern->len;
+
+    for(int j = 0; text[j] != L'\0'; j++)
+    {
+        int index = letter_index(pattern, text[j]);
+        const uint64_t* pm = index < 0 ? NULL : pattern->masks + (size_t) index * blocks;
+        uint64_t add_carry = 0;
+        uint64_t hp_carry = 1;
+        uint64_t hn_carry = 0;
+        uint64_t tr_carry = 0;
+
+        for(int b = 0; b < blocks; b++)
+        {
+            uint64_t eq = pm == NULL ? 0 : pm[b];
+            uint64_t tr = 0;
+            if(transpositions)
+            {
+                uint64_t swapped = (~d0[b]) & eq;
+                tr = ((swapped << 1) | tr_carry) & (pm_prev == NULL ? 0 : pm_prev[b]);
+                tr_carry = (swapped & top) != 0;
+            }
+
+            uint64_t matched = eq & vp[b];
+            uint64_t sum = matched + vp[b];
+            uint64_t carry = sum < matched;
+            sum += add_carry;
+            carry |= sum < add_carry;
+            add_carry = carry;
+
+            d0[b] = (sum ^ vp[b]) | eq | vn[b] | tr;
+            uint64_t hp = vn[b] | ~(d0[b] | vp[b]);
+            uint64_t hn = d0[b] & vp[b];
+            if(b == blocks - 1)
+            {
+                if(hp & last)
+                    score++;
+                else if(hn & last)
+                    score--;
+            }
+            uint64_t hp_shifted = (hp << 1) | hp_carry;
+            uint64_t hn_shifted = (hn << 1) | hn_carry;
+            hp_carry = (hp & top) != 0;
+            hn_carry = (hn & top) != 0;
+            vp[b] = hn_shifted | ~(d0[b] | hp_shifted);
+            vn[b] = d0[b] & hp_shifted;
+        }
+        pm_prev = pm;
+    }
+
+    free(vectors);
+    return score;
+}
+
+int edit_pattern_distance(const Edit_Pattern* pattern, const wchar_t* text, bool transpositions)
+{
+    assert(pattern != NULL);
+    assert(text != NULL);
+
+    if(pattern->len == 0)
+        return wcslen(text);
+    if(pattern->blocks == 1)
+        return distance_single(pattern, text, transpositions);
+    return distance_blocks(pattern, text, transpositions);
+}
+
+/**
+ * @brief distance Computes distance of two words, using the shorter one as the pattern.
+ * @param a First word.
+ * @param b Second word.
+ * @param transpositions True for Damerau distance.
+ * @return The distance.
+ */
+static int distance(const wchar_t* a, const wchar_t* b, bool transpositions)
+{
+    assert(a != NULL);
+    assert(b != NULL);
+
+    if(wcslen(a) > wcslen(b))
+    {
+        const wchar_t* tmp = a;
+        a = b;
+        b = tmp;
+    }
+    Edit_Pattern* pattern = edit_pattern_new(a);
+    int ret = edit_pattern_distance(pattern, b, transpositions);
+    edit_pattern_free(pattern);
+    return ret;
+}
+
+int edit_distance(const wchar_t* a, const wchar_t* b)
+{
+    return distance(a, b, false);
+}
+
+int edit_distance_damerau(const wchar_t* a, const wchar_t* b)
+{
+    return distance(a, b, true);
+}
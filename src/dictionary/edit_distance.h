@@ -0,0 +1,79 @@
+#ifndef EDIT_DISTANCE_H_INCLUDED
+#define EDIT_DISTANCE_H_INCLUDED
+
+/** @defgroup edit_distance Module edit_distance
+ * Bit-parallel computation of edit distance between words.
+ */
+/**
+ * @file edit_distance.h Header file of module edit_distance.
+ * @ingroup edit_distance
+ * @author agent <agent@local>
+ * @date 2026-10
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <wchar.h>
+
+#define EDIT_DISTANCE_BLOCK_BITS 64 ///<Number of letters of the pattern handled by one machine word.
+#define EDIT_DISTANCE_DIRECT_LETTERS 128 ///<Letters below this value are looked up in a table, others by binary search.
+
+/**
+ * Word preprocessed to be compared with many other words.
+ * <p>
+ * Every letter of the pattern has a bit mask of its positions, one machine word per
+ * EDIT_DISTANCE_BLOCK_BITS letters of the pattern. Patterns longer than one block
+ * are handled by the multi-word variant of the algorithm.
+ */
+typedef struct
+{
+    int len; ///<Length of the pattern.
+    int blocks; ///<Number of machine words per mask.
+    int letter_count; ///<Number of distinct letters of the pattern.
+    wchar_t* letters; ///<Distinct letters of the pattern, sorted.
+    uint64_t* masks; ///<Masks of positions, blocks words per letter, in order of letters.
+    unsigned char direct[EDIT_DISTANCE_DIRECT_LETTERS]; ///<Index+1 of small letters in letters, 0 if absent.
+} Edit_Pattern;
+
+/**
+ * @brief edit_pattern_new Preprocesses the pattern.
+ * @param pattern The word.
+ * @return Pointer to the new pattern, disposed by edit_pattern_free().
+ */
+Edit_Pattern* edit_pattern_new(const wchar_t* pattern);
+
+/**
+ * @brief edit_pattern_free Deallocates the pattern.
+ * @param pattern The pattern.
+ */
+void edit_pattern_free(Edit_Pattern* pattern);
+
+/**
+ * @brief edit_pattern_distance Computes edit distance between the pattern and the text.
+ * @param pattern Preprocessed pattern.
+ * @param text The other word.
+ * @param transpositions If true, swap of two adjacent letters costs one edit (Damerau distance,
+ * every substring edited at most once), otherwise only insertions, deletions and replacements are counted (Levenshtein distance).
+ * @return The distance.
+ * Runs in O(n * ceil(m / EDIT_DISTANCE_BLOCK_BITS)), where n - length of the text, m - length of the pattern.
+ */
+int edit_pattern_distance(const Edit_Pattern* pattern, const wchar_t* text, bool transpositions);
+
+/**
+ * @brief edit_distance Computes Levenshtein distance of two words.
+ * @param a First word.
+ * @param b Second word.
+ * @return Minimal number of insertions, deletions and replacements turning a into b.
+ */
+int edit_distance(const wchar_t* a, const wchar_t* b);
+
+/**
+ * @brief edit_distance_damerau Computes Damerau distance of two words.
+ * @param a First word.
+ * @param b Second word.
+ * @return Minimal number of insertions, deletions, replacements and swaps of adjacent letters
+ * turning a into b, where no substring is edited twice.
+ */
+int edit_distance_damerau(const wchar_t* a, const wchar_t* b);
+
+#endif // EDIT_DISTANCE_H_INCLUDED
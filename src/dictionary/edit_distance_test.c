@@ -0,0 +1,118 @@
+/** @file
+  Tests of bit-parallel edit distance.
+  @ingroup edit_distance
+  @author agent <agent@local>
+  @date 2026-10
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <cmocka.h>
+#include <wchar.h>
+#include "edit_distance.h"
+
+#define MAX_WORD_LENGTH 200 ///<Max length of random word, spans a few blocks.
+
+///Generates random word over a small alphabet with some non-ascii letters.
+static void random_word(wchar_t* word, int max_len)
+{
+    int len = rand() % (max_len + 1);
+    for(int i = 0; i < len; i++)
+        word[i] = rand() % 4 == 0 ? L'ą' + rand() % 3 : L'a' + rand() % 3;
+    word[len] = L'\0';
+}
+
+///Quadratic dynamic programming used as a reference.
+static int naive_distance(const wchar_t* a, const wchar_t* b, bool transpositions)
+{
+    int n = wcslen(a);
+    int m = wcslen(b);
+    int* d = malloc(sizeof(int) * (n + 1) * (m + 1));
+    for(int i = 0; i <= n; i++)
+        for(int j = 0; j <= m; j++)
+        {
+            int* cell = &d[i * (m + 1) + j];
+            if(i == 0 || j == 0)
+            {
+                *cell = i + j;
+                continue;
+            }
+            *cell = d[(i - 1) * (m + 1) + j - 1] + (a[i-1] != b[j-1]);
+            if(d[(i - 1) * (m + 1) + j] + 1 < *cell)
+                *cell = d[(i - 1) * (m + 1) + j] + 1;
+            if(d[i * (m + 1) + j - 1] + 1 < *cell)
+                *cell = d[i * (m + 1) + j - 1] + 1;
+            if(transpositions && i > 1 && j > 1 && a[i-1] == b[j-2] && a[i-2] == b[j-1]
+                    && d[(i - 2) * (m + 1) + j - 2] + 1 < *cell)
+                *cell = d[(i - 2) * (m + 1) + j - 2] + 1;
+        }
+    int ret = d[n * (m + 1) + m];
+    free(d);
+    return ret;
+}
+
+///Few distances known by hand.
+static void test_known_distances(void** state)
+{
+    assert_int_equal(edit_distance(L"kitten", L"sitting"), 3);
+    assert_int_equal(edit_distance(L"", L"abc"), 3);
+    assert_int_equal(edit_distance(L"abc", L""), 3);
+    assert_int_equal(edit_distance(L"", L""), 0);
+    assert_int_equal(edit_distance(L"żółw", L"zolw"), 3);
+    assert_int_equal(edit_distance(L"kot", L"kto"), 2);
+    assert_int_equal(edit_distance_damerau(L"kot", L"kto"), 1);
+    assert_int_equal(edit_distance_damerau(L"ca", L"abc"), 3); //no substring edited twice
+    assert_int_equal(edit_distance_damerau(L"abcd", L"badc"), 2);
+}
+
+///Patterns longer than one block, where the multi-word variant is used.
+static void test_long_words(void** state)
+{
+    wchar_t a[MAX_WORD_LENGTH + 1];
+    wchar_t b[MAX_WORD_LENGTH + 1];
+    for(int i = 0; i < 150; i++)
+        a[i] = L'a' + i % 7;
+    a[150] = L'\0';
+    wcscpy(b, a);
+    b[0] = L'z';
+    b[70] = L'z';
+    b[149] = L'z';
+    assert_int_equal(edit_distance(a, b), 3);
+    wchar_t tmp = b[100];
+    b[100] = b[101];
+    b[101] = tmp;
+    assert_int_equal(edit_distance_damerau(a, b), 4);
+    assert_int_equal(edit_distance(a, b), 5);
+}
+
+///Random words compared with quadratic reference.
+static void test_random_words(void** state)
+{
+    wchar_t a[MAX_WORD_LENGTH + 1];
+    wchar_t b[MAX_WORD_LENGTH + 1];
+    for(int i = 0; i < 2000; i++)
+    {
+        int max_len = i % 4 == 0 ? MAX_WORD_LENGTH : 40;
+        random_word(a, max_len);
+        random_word(b, max_len);
+        Edit_Pattern* pattern = edit_pattern_new(a);
+        assert_int_equal(edit_pattern_distance(pattern, b, false), naive_distance(a, b, false));
+        assert_int_equal(edit_pattern_distance(pattern, b, true), naive_distance(a, b, true));
+        edit_pattern_free(pattern);
+    }
+}
+
+///Just to document this function.
+int main(void)
+{
+    const struct CMUnitTest tests[] =
+    {
+        cmocka_unit_test(test_known_distances),
+        cmocka_unit_test(test_long_words),
+        cmocka_unit_test(test_random_words)
+    };
+    return cmocka_run_group_tests_name("Edit distance tests", tests, NULL, NULL);
+}
@@ -0,0 +1,133 @@
+/** @file
+    Implementation of cache of membership queries.
+    @ingroup find_cache
+    @author agent
+    @date 2026-10
+  */
+
+#include <stdlib.h>
+#include <string.h>
+#include <wchar.h>
+#include <assert.h>
+
+#include "find_cache.h"
+#include "error_handling.h"
+#include "fnv_hash.h"
+
+#ifdef FIND_CACHE_UNIT_TESTING
+#include <stdarg.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#ifdef malloc
+#undef malloc
+#endif // malloc
+#define malloc(size) _test_malloc(size, __FILE__, __LINE__)
+
+#ifdef free
+#undef free
+#endif // free
+#define free(ptr) _test_free(ptr, __FILE__, __LINE__)
+
+#ifdef assert
+#undef assert
+#define assert(expression) mock_assert((int)(expression), #expression, __FILE__, __LINE__);
+#endif
+#endif // FIND_CACHE_UNIT_TESTING
+
+/**
+ * @brief hash_word Computes hash of the word, if it is short enough to be cached.
+ * @param word The word.
+ * @param hash Place for the hash.
+ * @return False if the word is too long.
+ */
+static bool hash_word(const wchar_t* word, uint64_t* hash)
+{
+    for(int i = 0; word[i] != L'\0'; i++)
+        if(i == FIND_CACHE_MAX_WORD_LENGTH)
+            return false;
+    *hash = fnv_hash_word(word);
+    return true;
+}
+
+///Drops all entries.
+static void clear(Find_Cache* cache)
+{
+    for(size_t i = 0; i < cache->entry_count; i++)
+        cache->entries[i].word[0] = L'\0';
+}
+
+Find_Cache* find_cache_new(size_t entry_count)
+{
+    Find_Cache* ret = malloc(sizeof(Find_Cache));
+    if(ret == NULL) report_error(MEMORY);
+    ret->entry_count = 1;
+    while(ret->entry_count < entry_count)
+        ret->entry_count *= 2;
+    //malloc aligns to 16 bytes only, so the entries start at the first line boundary
+    ret->memory = malloc(sizeof(Find_Cache_Entry) * ret->entry_count + FIND_CACHE_LINE_BYTES - 1);
+    if(ret->memory == NULL) report_error(MEMORY);
+    uintptr_t start = ((uintptr_t) ret->memory + FIND_CACHE_LINE_BYTES - 1) & ~(uintptr_t) (FIND_CACHE_LINE_BYTES - 1);
+    ret->entries = (Find_Cache_Entry*) start;
+    clear(ret);
+    ret->generation = 0;
+    pthread_mutex_init(&ret->lock, NULL);
+    ret->hits = 0;
+    ret->misses = 0;
+    return ret;
+}
+
+void find_cache_free(Find_Cache* cache)
+{
+    assert(cache != NULL);
+    pthread_mutex_destroy(&cache->lock);
+    free(cache->memory);
+    free(cache);
+}
+
+int find_cache_get(Find_Cache* cache, const wchar_t* word, unsigned long generation)
+{
+    assert(cache != NULL);
+    assert(word != NULL);
+
+    int ret = FIND_CACHE_MISS;
+    uint64_t hash;
+    if(hash_word(word, &hash) && pthread_mutex_trylock(&cache->lock) == 0)
+    {
+        if(generation != cache->generation)
+        {
+            clear(cache);
+            cache->generation = generation;
+        }
+        const Find_Cache_Entry* entry = &cache->entries[hash & (cache->entry_count - 1)];
+        if(entry->hash == hash && entry->word[0] != L'\0' && wcscmp(entry->word, word) == 0)
+            ret = entry->found;
+        pthread_mutex_unlock(&cache->lock);
+    }
+    __atomic_fetch_add(ret == FIND_CACHE_MISS ? &cache->misses : &cache->hits, 1, __ATOMIC_RELAXED);
+    return ret;
+}
+
+void find_cache_put(Find_Cache* cache, const wchar_t* word, unsigned long generation, bool found)
+{
+    assert(cache != NULL);
+    assert(word != NULL);
+
+    uint64_t hash;
+    if(!hash_word(word, &hash) || pthread_mutex_trylock(&cache->lock) != 0)
+        return;
+    if(generation == cache->generation)
+    {
+        Find_Cache_Entry* entry = &cache->entries[hash & (cache->entry_count - 1)];
+        entry->hash = hash;
+        entry->found = found;
+        wcscpy(entry->word, word);
+    }
+    pthread_mutex_unlock(&cache->lock);
+}
+
+void find_cache_stats(const Find_Cache* cache, size_t* hits, size_t* misses)
+{
+    assert(cache != NULL);
+    *hits = __atomic_load_n(&cache->hits, __ATOMIC_RELAXED);
+    *misses = __atomic_load_n(&cache->misses, __ATOMIC_RELAXED);
+}
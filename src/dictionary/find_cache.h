@@ -0,0 +1,94 @@
+#ifndef FIND_CACHE_H_INCLUDED
+#define FIND_CACHE_H_INCLUDED
+
+/** @defgroup find_cache Module find_cache
+ * Small cache of results of membership queries of frequent words.
+ */
+/**
+ * @file find_cache.h Header file of module find_cache.
+ * @ingroup find_cache
+ * @author agent <agent@local>
+ * @date 2026-10
+ */
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <wchar.h>
+
+#define FIND_CACHE_DEFAULT_ENTRIES 512 ///<Default number of entries, a power of two.
+#define FIND_CACHE_MAX_WORD_LENGTH 12 ///<Longer words are not cached, so an entry fits in 64 bytes.
+#define FIND_CACHE_LINE_BYTES 64 ///<Size of a cache line, to which entries are aligned.
+
+#define FIND_CACHE_MISS (-1) ///<Value returned by find_cache_get() for words not in cache.
+
+/**
+ * Cached result of a query.
+ */
+typedef struct
+{
+    uint64_t hash; ///<Hash of the word.
+    uint32_t found; ///<Result of the query.
+    wchar_t word[FIND_CACHE_MAX_WORD_LENGTH + 1]; ///<The word, empty if entry is unused.
+} Find_Cache_Entry;
+
+/**
+ * Direct-mapped cache: every word has one entry, chosen by its hash, and replaces
+ * the word kept there before. Frequent words of a text stay in cache, as they
+ * are looked up again before being replaced.
+ * All entries are valid for one generation of the dictionary only.
+ * Lookups of concurrent queries do not wait for each other: an entry used by another
+ * thread is treated as a miss.
+ */
+typedef struct
+{
+    void* memory; ///<Allocated memory containing the entries.
+    Find_Cache_Entry* entries; ///<The entries, aligned to FIND_CACHE_LINE_BYTES, so each lies in one cache line.
+    size_t entry_count; ///<Number of entries, a power of two.
+    unsigned long generation; ///<Generation of the dictionary of cached entries.
+    pthread_mutex_t lock; ///<Guards entries and generation.
+    size_t hits; ///<Number of successful lookups, updated atomically.
+    size_t misses; ///<Number of failed lookups, updated atomically.
+} Find_Cache;
+
+/**
+ * @brief find_cache_new Creates an empty cache.
+ * @param entry_count Number of entries, rounded up to a power of two.
+ * @return Pointer to the new cache.
+ */
+Find_Cache* find_cache_new(size_t entry_count);
+
+/**
+ * @brief find_cache_free Deallocates the cache.
+ * @param cache The cache.
+ */
+void find_cache_free(Find_Cache* cache);
+
+/**
+ * @brief find_cache_get Looks the word up.
+ * @param cache The cache.
+ * @param word The word.
+ * @param generation Current generation of the dictionary, older entries are dropped.
+ * @return Cached result, 0 or 1, or FIND_CACHE_MISS.
+ */
+int find_cache_get(Find_Cache* cache, const wchar_t* word, unsigned long generation);
+
+/**
+ * @brief find_cache_put Remembers result of the query.
+ * @param cache The cache.
+ * @param word The word, ignored if longer than FIND_CACHE_MAX_WORD_LENGTH.
+ * @param generation Generation of the dictionary used to answer the query.
+ * @param found The result.
+ */
+void find_cache_put(Find_Cache* cache, const wchar_t* word, unsigned long generation, bool found);
+
+/**
+ * @brief find_cache_stats Reads counters of lookups.
+ * @param cache The cache.
+ * @param hits Pointer to store the number of successful lookups.
+ * @param misses Pointer to store the number of failed lookups.
+ */
+void find_cache_stats(const Find_Cache* cache, size_t* hits, size_t* misses);
+
+#endif // FIND_CACHE_H_INCLUDED
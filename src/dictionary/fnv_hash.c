@@ -0,0 +1,28 @@
+/** @file
+    Implementation of hash of words.
+    @ingroup fnv_hash
+    @author agent
+    @date 2026-10
+  */
+
+#include "fnv_hash.h"
+
+#define FNV_OFFSET_BASIS 14695981039346656037ULL ///<Initial value of 64-bit FNV-1a hash.
+#define FNV_PRIME 1099511628211ULL ///<Multiplier of 64-bit FNV-1a hash.
+
+uint64_t fnv_hash_word(const wchar_t* word)
+{
+    uint64_t ret = FNV_OFFSET_BASIS;
+    for(; *word != L'\0'; word++)
+    {
+        ret ^= (uint64_t) *word;
+        ret *= FNV_PRIME;
+    }
+    //finalizer of MurmurHash3
+    ret ^= ret >> 33;
+    ret *= 0xff51afd7ed558ccdULL;
+    ret ^= ret >> 33;
+    ret *= 0xc4ceb9fe1a85ec53ULL;
+    ret ^= ret >> 33;
+    return ret;
+}
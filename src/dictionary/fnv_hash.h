@@ -0,0 +1,26 @@
+#ifndef FNV_HASH_H_INCLUDED
+#define FNV_HASH_H_INCLUDED
+
+/** @defgroup fnv_hash Module fnv_hash
+ * Hash of words shared by hash tables, caches and filters of words.
+ */
+/**
+ * @file fnv_hash.h Header file of module fnv_hash.
+ * @ingroup fnv_hash
+ * @author agent <agent@local>
+ * @date 2026-10
+ */
+
+#include <stdint.h>
+#include <wchar.h>
+
+/**
+ * @brief fnv_hash_word Computes hash of the word.
+ * @param word The word.
+ * @return FNV-1a hash of the letters, finished by a mixing function, so all bits of the
+ * result depend on every letter and any of them may be used to choose a bucket.
+ * Saved filters depend on this function, so it must not change.
+ */
+uint64_t fnv_hash_word(const wchar_t* word);
+
+#endif // FNV_HASH_H_INCLUDED
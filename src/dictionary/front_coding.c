@@ -0,0 +1,530 @@
+/** @file
+    Implementation of front coded files of words.
+    @ingroup front_coding
+    @author agent
+    @date 2026-10
+  */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <wchar.h>
+#include <assert.h>
+
+#include "front_coding.h"
+#include "error_handling.h"
+
+#ifdef FRONT_CODING_UNIT_TESTING
+#include <stdarg.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#ifdef malloc
+#undef malloc
+#endif // malloc
+#define malloc(size) _test_malloc(size, __FILE__, __LINE__)
+
+#ifdef calloc
+#undef calloc
+#endif // calloc
+#define calloc(num, size) _test_calloc(num, size, __FILE__, __LINE__)
+
+#ifdef realloc
+#undef realloc
+#endif // realloc
+#define realloc(ptr, size) _test_realloc(ptr, size, __FILE__, __LINE__)
+
+#ifdef free
+#undef free
+#endif // free
+#define free(ptr) _test_free(ptr, __FILE__, __LINE__)
+
+#ifdef assert
+#undef assert
+#define assert(expression) mock_assert((int)(expression), #expression, __FILE__, __LINE__);
+#endif
+#endif // FRONT_CODING_UNIT_TESTING
+
+#define TRAILER_LENGTH 8 ///<Length of the offset of the index, written at the end of the file.
+#define FREQUENCY_ESCAPE 0 ///<Header of no word, as words differ, used before frequency of a word.
+
+/**
+  * Output of front_coding_save().
+  */
+typedef struct
+{
+    FILE* file; ///<The file.
+    long written; ///<Number of written bytes.
+    bool failed; ///<True if some byte was not written.
+} Writer;
+
+///Writes one byte.
+static void write_byte(Writer* writer, unsigned char byte)
+{
+    if(fputc(byte, writer->file) == EOF)
+        writer->failed = true;
+    writer->written++;
+}
+
+///Writes number as varint, seven bits per byte, the lowest first.
+static void write_varint(Writer* writer, uint64_t value)
+{
+    while(value >= 0x80)
+    {
+        write_byte(writer, (unsigned char) (value | 0x80));
+        value >>= 7;
+    }
+    write_byte(writer, (unsigned char) value);
+}
+
+/**
+  * Input decoded from a buffer.
+  */
+typedef struct
+{
+    const unsigned char* position; ///<Next byte.
+    const unsigned char* end; ///<End of the buffer.
+    bool failed; ///<True if the buffer ended too early or contains wrong data.
+} Reader;
+
+///Reads one byte.
+static unsigned char read_byte(Reader* reader)
+{
+    if(reader->position == reader->end)
+    {
+        reader->failed = true;
+        return 0;
+    }
+    return *reader->position++;
+}
+
+///Reads number written by write_varint().
+static uint64_t read_varint(Reader* reader)
+{
+    uint64_t ret = 0;
+    for(int shift = 0; shift < 64; shift += 7)
+    {
+        unsigned char byte = read_byte(reader);
+        ret |= (uint64_t) (byte & 0x7f) << shift;
+        if((byte & 0x80) == 0)
+            return ret;
+    }
+    reader->failed = true;
+    return 0;
+}
+
+/**
+  * Letter of the saved trie with its code.
+  */
+typedef struct
+{
+    wchar_t letter; ///<The letter.
+    size_t count; ///<Number of nodes with the letter.
+    uint64_t code; ///<Code of the letter, frequent letters get small ones.
+} Letter_Code;
+
+/**
+  * Letters of the saved trie.
+  */
+typedef struct
+{
+    Letter_Code* codes; ///<Letters sorted by value.
+    size_t count; ///<Number of letters.
+    size_t size; ///<Size of codes array.
+} Letter_Codes;
+
+///Finds position of the letter in sorted letters, or the position where it belongs.
+static size_t find_letter(const Letter_Codes* codes, wchar_t letter)
+{
+    size_t low = 0, high = codes->count;
+    while(low < high)
+    {
+        size_t middle = low + (high - low) / 2;
+        if(codes->codes[middle].letter < letter)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    return low;
+}
+
+///Counts letters of nodes of the subtree.
+static void count_letters(const Node* node, Letter_Codes* codes)
+{
+    for(int i = 0; i < node->children->element_count; i++)
+    {
+        const Node* child = node->children->storage[i];
+        size_t position = find_letter(codes, child->value);
+        if(position == codes->count || codes->codes[position].letter != child->value)
+        {
+            if(codes->count == codes->size)
+            {
+                codes->size *= 2;
+                codes->codes = realloc(codes->codes, sizeof(Letter_Code) * codes->size);
+                if(codes->codes == NULL) report_error(MEMORY);
+            }
+            memmove(codes->codes + position + 1, codes->codes + position,
+                    sizeof(Letter_Code) * (codes->count - position));
+            codes->codes[position].letter = child->value;
+            codes->codes[position].count = 0;
+            codes->count++;
+        }
+        codes->codes[position].count++;
+        count_letters(child, codes);
+    }
+}
+
+///Compares letters by number of nodes, descending, then by value.
+static int cmp_letter_count(const void* a, const void* b)
+{
+    const Letter_Code* x = a;
+    const Letter_Code* y = b;
+    if(x->count != y->count)
+        return x->count > y->count ? -1 : 1;
+    return (x->letter > y->letter) - (x->letter < y->letter);
+}
+
+///Compares letters by value.
+static int cmp_letter_value(const void* a, const void* b)
+{
+    const Letter_Code* x = a;
+    const Letter_Code* y = b;
+    return (x->letter > y->letter) - (x->letter < y->letter);
+}
+
+///Writes letters of the word as their codes.
+static void write_letters(Writer* writer, const Letter_Codes* codes, const wchar_t* letters, size_t length)
+{
+    for(size_t i = 0; i < length; i++)
+        write_varint(writer, codes->codes[find_letter(codes, letters[i])].code);
+}
+
+int front_coding_save(const Node* root, size_t block_words, FILE* file)
+{
+    assert(root != NULL);
+    assert(block_words > 0);
+    assert(file != NULL);
+
+    Writer writer = {file, 0, false};
+    for(int i = 0; i < FRONT_CODING_MAGIC_LENGTH; i++)
+        write_byte(&writer, FRONT_CODING_MAGIC[i]);
+
+    Letter_Codes codes;
+    codes.count = 0;
+    codes.size = TRIE_WORD_BUFFER_START_SIZE;
+    codes.codes = malloc(sizeof(Letter_Code) * codes.size);
+    if(codes.codes == NULL) report_error(MEMORY);
+    count_letters(root, &codes);
+    qsort(codes.codes, codes.count, sizeof(Letter_Code), cmp_letter_count);
+    for(size_t i = 0; i < codes.count; i++)
+        codes.codes[i].code = i;
+    qsort(codes.codes, codes.count, sizeof(Letter_Code), cmp_letter_value);
+
+    size_t block_count = (root->word_count + block_words - 1) / block_words;
+    long* offsets = malloc(sizeof(long) * (block_count + 1));
+    wchar_t** first_words = malloc(sizeof(wchar_t*) * (block_count + 1));
+    if(offsets == NULL || first_words == NULL) report_error(MEMORY);
+
+    Trie_Iterator iterator;
+    trie_iterator_init(&iterator, root);
+    size_t previous_size = TRIE_WORD_BUFFER_START_SIZE;
+    wchar_t* previous = malloc(sizeof(wchar_t) * previous_size);
+    if(previous == NULL) report_error(MEMORY);
+    size_t previous_length = 0;
+    const wchar_t* word;
+    for(size_t i = 0; (word = trie_iterator_next(&iterator)) != NULL; i++)
+    {
+        size_t shared = 0;
+        size_t length = iterator.depth;
+        unsigned char frequency = iterator.nodes[length]->frequency;
+        if(i % block_words == 0)
+        {
+            offsets[i / block_words] = writer.written;
+            first_words[i / block_words] = trie_node_word(iterator.nodes[length]);
+            previous_length = 0;
+        }
+        else
+            while(previous[shared] == word[shared])
+                shared++;
+        //one byte for most words: numbers of letters dropped from the previous word and added ones
+        size_t suffix = length - shared;
+        size_t short_suffix = suffix < FRONT_CODING_LONG_SUFFIX ? suffix : FRONT_CODING_LONG_SUFFIX;
+        if(frequency > 0)
+        {
+            write_varint(&writer, FREQUENCY_ESCAPE);
+            write_byte(&writer, frequency);
+        }
+        write_varint(&writer, (uint64_t) (previous_length - shared) << 4 | short_suffix);
+        if(short_suffix == FRONT_CODING_LONG_SUFFIX)
+            write_varint(&writer, suffix - FRONT_CODING_LONG_SUFFIX);
+        write_letters(&writer, &codes, word + shared, suffix);
+        if(length + 1 > previous_size)
+        {
+            previous_size = 2 * (length + 1);
+            previous = realloc(previous, sizeof(wchar_t) * previous_size);
+            if(previous == NULL) report_error(MEMORY);
+        }
+        wmemcpy(previous, word, length + 1);
+        previous_length = length;
+    }
+    trie_iterator_done(&iterator);
+    free(previous);
+
+    //the index: counts, letters by code, then offset from the previous block and the first word of every block
+    long index_offset = writer.written;
+    write_varint(&writer, root->word_count);
+    write_varint(&writer, block_count);
+    write_varint(&writer, codes.count);
+    qsort(codes.codes, codes.count, sizeof(Letter_Code), cmp_letter_count);
+    for(size_t i = 0; i < codes.count; i++)
+        write_varint(&writer, (uint32_t) codes.codes[i].letter);
+    qsort(codes.codes, codes.count, sizeof(Letter_Code), cmp_letter_value);
+    long previous_offset = FRONT_CODING_MAGIC_LENGTH;
+    for(size_t i = 0; i < block_count; i++)
+    {
+        write_varint(&writer, offsets[i] - previous_offset);
+        previous_offset = offsets[i];
+        size_t length = wcslen(first_words[i]);
+        write_varint(&writer, length);
+        write_letters(&writer, &codes, first_words[i], length);
+        free(first_words[i]);
+    }
+    for(int i = 0; i < TRAILER_LENGTH; i++)
+        write_byte(&writer, (unsigned char) ((uint64_t) index_offset >> (8 * i)));
+    free(offsets);
+    free(first_words);
+    free(codes.codes);
+    return writer.failed ? FRONT_CODING_SAVE_FAILURE : FRONT_CODING_SAVE_SUCCESS;
+}
+
+///Ensures that the word buffer has place for length letters and L'\0'.
+static void reserve_word(Front_Coded* coded, size_t length)
+{
+    if(length + 1 <= coded->word_size)
+        return;
+    coded->word_size = 2 * (length + 1);
+    coded->word = realloc(coded->word, sizeof(wchar_t) * coded->word_size);
+    if(coded->word == NULL) report_error(MEMORY);
+}
+
+///Reads length codes of letters to the word buffer from position shift.
+static void read_letters(Front_Coded* coded, Reader* reader, size_t shift, size_t length)
+{
+    reserve_word(coded, shift + length);
+    for(size_t i = shift; i < shift + length && !reader->failed; i++)
+    {
+        uint64_t code = read_varint(reader);
+        if(code >= coded->letter_count)
+            reader->failed = true;
+        else
+            coded->word[i] = coded->letters[code];
+    }
+    coded->word[shift + length] = L'\0';
+}
+
+Front_Coded* front_coding_open(FILE* file)
+{
+    assert(file != NULL);
+
+    char magic[FRONT_CODING_MAGIC_LENGTH];
+    unsigned char trailer[TRAILER_LENGTH];
+    if(fseek(file, 0, SEEK_SET) != 0 || fread(magic, 1, FRONT_CODING_MAGIC_LENGTH, file) != FRONT_CODING_MAGIC_LENGTH
+       || memcmp(magic, FRONT_CODING_MAGIC, FRONT_CODING_MAGIC_LENGTH) != 0
+       || fseek(file, -TRAILER_LENGTH, SEEK_END) != 0 || fread(trailer, 1, TRAILER_LENGTH, file) != TRAILER_LENGTH)
+        return NULL;
+    long end = ftell(file) - TRAILER_LENGTH;
+    uint64_t index_offset = 0;
+    for(int i = TRAILER_LENGTH - 1; i >= 0; i--)
+        index_offset = index_offset << 8 | trailer[i];
+    if(index_offset < FRONT_CODING_MAGIC_LENGTH || index_offset > (uint64_t) end)
+        return NULL;
+
+    size_t index_size = end - index_offset;
+    unsigned char* index = malloc(index_size + 1);
+    if(index == NULL) report_error(MEMORY);
+    if(fseek(file, index_offset, SEEK_SET) != 0 || fread(index, 1, index_size, file) != index_size)
+    {
+        free(index);
+        return NULL;
+    }
+
+    Front_Coded* ret = malloc(sizeof(Front_Coded));
+    if(ret == NULL) report_error(MEMORY);
+    Reader reader = {index, index + index_size, false};
+    ret->file = file;
+    ret->word_count = read_varint(&reader);
+    ret->block_count = read_varint(&reader);
+    ret->letter_count = read_varint(&reader);
+    if(ret->block_count > index_size || ret->letter_count > index_size) //all take some bytes of the index
+    {
+        ret->block_count = 0;
+        ret->letter_count = 0;
+        reader.failed = true;
+    }
+    ret->letters = malloc(sizeof(wchar_t) * (ret->letter_count + 1));
+    if(ret->letters == NULL) report_error(MEMORY);
+    for(size_t i = 0; i < ret->letter_count; i++)
+    {
+        uint64_t letter = read_varint(&reader);
+        if(letter == 0 || letter > WCHAR_MAX)
+            reader.failed = true;
+        ret->letters[i] = (wchar_t) letter;
+    }
+    ret->first_words = calloc(ret->block_count + 1, sizeof(wchar_t*));
+    ret->offsets = malloc(sizeof(long) * (ret->block_count + 1));
+    ret->block_size = 0;
+    ret->block = NULL;
+    ret->word_size = TRIE_WORD_BUFFER_START_SIZE;
+    ret->word = malloc(sizeof(wchar_t) * ret->word_size);
+    if(ret->first_words == NULL || ret->offsets == NULL || ret->word == NULL) report_error(MEMORY);
+    long previous_offset = FRONT_CODING_MAGIC_LENGTH;
+    for(size_t i = 0; i < ret->block_count && !reader.failed; i++)
+    {
+        ret->offsets[i] = previous_offset + read_varint(&reader);
+        if(ret->offsets[i] < previous_offset || ret->offsets[i] >= (long) index_offset)
+            reader.failed = true;
+        previous_offset = ret->offsets[i];
+        size_t length = read_varint(&reader);
+        if(reader.failed || length > index_size)
+        {
+            reader.failed = true;
+            break;
+        }
+        read_letters(ret, &reader, 0, length);
+        ret->first_words[i] = malloc(sizeof(wchar_t) * (length + 1));
+        if(ret->first_words[i] == NULL) report_error(MEMORY);
+        wmemcpy(ret->first_words[i], ret->word, length + 1);
+    }
+    ret->offsets[ret->block_count] = index_offset;
+    free(index);
+    if(reader.failed || reader.position != reader.end)
+    {
+        front_coding_close(ret);
+        return NULL;
+    }
+    return ret;
+}
+
+void front_coding_close(Front_Coded* coded)
+{
+    assert(coded != NULL);
+
+    for(size_t i = 0; i < coded->block_count; i++)
+        free(coded->first_words[i]);
+    free(coded->first_words);
+    free(coded->letters);
+    free(coded->offsets);
+    free(coded->block);
+    free(coded->word);
+    free(coded);
+}
+
+/**
+ * @brief read_block Reads the block to the buffer.
+ * @param coded The opened file.
+ * @param block Number of the block.
+ * @param reader Reader of the block to be initialized.
+ * @return True on success.
+ */
+static bool read_block(Front_Coded* coded, size_t block, Reader* reader)
+{
+    size_t size = coded->offsets[block + 1] - coded->offsets[block];
+    if(size > coded->block_size)
+    {
+        coded->block_size = 2 * size;
+        coded->block = realloc(coded->block, coded->block_size);
+        if(coded->block == NULL) report_error(MEMORY);
+    }
+    if(fseek(coded->file, coded->offsets[block], SEEK_SET) != 0 || fread(coded->block, 1, size, coded->file) != size)
+        return false;
+    reader->position = coded->block;
+    reader->end = coded->block + size;
+    reader->failed = false;
+    return true;
+}
+
+/**
+ * @brief decode_word Decodes the next word of the block to the word buffer.
+ * @param coded The opened file.
+ * @param reader Reader of the block.
+ * @param length Pointer to length of the previous word, replaced by length of the decoded one.
+ * @param frequency Pointer to store frequency of the word.
+ * @return True on success.
+ */
+static bool decode_word(Front_Coded* coded, Reader* reader, size_t* length, unsigned* frequency)
+{
+    uint64_t header = read_varint(reader);
+    *frequency = 0;
+    if(header == FREQUENCY_ESCAPE)
+    {
+        *frequency = read_byte(reader);
+        header = read_varint(reader);
+    }
+    uint64_t suffix = header & 15;
+    uint64_t dropped = header >> 4;
+    if(suffix == FRONT_CODING_LONG_SUFFIX)
+        suffix += read_varint(reader);
+    if(reader->failed || header == FREQUENCY_ESCAPE || dropped > *length
+       || suffix > (uint64_t) (reader->end - reader->position))
+        return false;
+    size_t shared = *length - dropped;
+    read_letters(coded, reader, shared, suffix);
+    *length = shared + suffix;
+    return !reader->failed;
+}
+
+bool front_coding_find(Front_Coded* coded, const wchar_t* word, unsigned* frequency)
+{
+    assert(coded != NULL);
+    assert(word != NULL);
+
+    //the last block with the first word not greater than the word
+    size_t low = 0, high = coded->block_count;
+    while(low < high)
+    {
+        size_t middle = low + (high - low) / 2;
+        if(wcscmp(coded->first_words[middle], word) <= 0)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    if(low == 0)
+        return false;
+    Reader reader;
+    if(!read_block(coded, low - 1, &reader))
+        return false;
+    size_t length = 0;
+    unsigned word_frequency;
+    while(reader.position != reader.end && decode_word(coded, &reader, &length, &word_frequency))
+    {
+        int cmp = wcscmp(coded->word, word);
+        if(cmp == 0 && frequency != NULL)
+            *frequency = word_frequency;
+        if(cmp >= 0)
+            return cmp == 0;
+    }
+    return false;
+}
+
+long front_coding_for_each_word(Front_Coded* coded, Front_Coding_Callback callback, void* data)
+{
+    assert(coded != NULL);
+    assert(callback != NULL);
+
+    long ret = 0;
+    for(size_t i = 0; i < coded->block_count; i++)
+    {
+        Reader reader;
+        if(!read_block(coded, i, &reader))
+            return -1;
+        size_t length = 0;
+        unsigned frequency;
+        while(reader.position != reader.end)
+        {
+            if(!decode_word(coded, &reader, &length, &frequency))
+                return -1;
+            callback(coded->word, frequency, data);
+            ret++;
+        }
+    }
+    return ret;
+}
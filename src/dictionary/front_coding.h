@@ -0,0 +1,100 @@
+#ifndef FRONT_CODING_H_INCLUDED
+#define FRONT_CODING_H_INCLUDED
+
+/** @defgroup front_coding Module front_coding
+ * Compact file of sorted words, searched without loading.
+ */
+/**
+ * @file front_coding.h Header file of module front_coding.
+ * @ingroup front_coding
+ * @author agent <agent@local>
+ * @date 2026-10
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <wchar.h>
+#include "trie.h"
+
+#define FRONT_CODING_MAGIC "FCW1" ///<First bytes of a front coded file.
+#define FRONT_CODING_MAGIC_LENGTH 4 ///<Length of FRONT_CODING_MAGIC.
+#define FRONT_CODING_BLOCK_WORDS 32 ///<Default number of words in a block.
+#define FRONT_CODING_LONG_SUFFIX 15 ///<Number of added letters from which it is written apart from the header of a word.
+#define FRONT_CODING_SAVE_SUCCESS 0 ///<Return value
+#define FRONT_CODING_SAVE_FAILURE -1 ///<Return value
+
+/**
+  * Opened front coded file.
+  * <p>
+  * Words are sorted and stored in blocks. Every word keeps only the number of letters dropped from
+  * the previous one and its remaining letters, both numbers packed to one varint, mostly one byte.
+  * Nonzero frequencies are preceded by a header which cannot describe a word.
+  * Letters are written as varint codes, frequent letters have one byte codes.
+  * The first word of every block is complete, so blocks are decoded independently.
+  * The sparse index of first words and offsets of blocks is kept at the end of the file
+  * and only the index is read by front_coding_open().
+  */
+typedef struct
+{
+    FILE* file; ///<The file.
+    size_t word_count; ///<Number of words.
+    size_t block_count; ///<Number of blocks.
+    wchar_t* letters; ///<Letters by their codes.
+    size_t letter_count; ///<Number of letters.
+    wchar_t** first_words; ///<First word of every block.
+    long* offsets; ///<Offset of every block and of the index after the last one.
+    unsigned char* block; ///<Buffer of the read block.
+    size_t block_size; ///<Size of the block buffer.
+    wchar_t* word; ///<Buffer of the decoded word.
+    size_t word_size; ///<Size of the word buffer.
+} Front_Coded;
+
+/**
+  * Receives words read by front_coding_for_each_word().
+  * Arguments are the word, valid only during the call, its frequency and user data.
+  */
+typedef void (*Front_Coding_Callback)(const wchar_t* word, unsigned frequency, void* data);
+
+/**
+ * @brief front_coding_save Writes words of the trie to the file.
+ * @param root Root of the trie.
+ * @param block_words Number of words in a block, more give smaller files and slower searches.
+ * @param file File opened in binary mode.
+ * @return FRONT_CODING_SAVE_SUCCESS or FRONT_CODING_SAVE_FAILURE if writing failed.
+ */
+int front_coding_save(const Node* root, size_t block_words, FILE* file);
+
+/**
+ * @brief front_coding_open Reads the index of the file.
+ * @param file File written by front_coding_save(), must stay open while the result is used.
+ * @return Pointer to the opened file or NULL if the file is not front coded or is broken.
+ */
+Front_Coded* front_coding_open(FILE* file);
+
+/**
+ * @brief front_coding_close Deallocates the opened file, but does not close the FILE.
+ * @param coded The opened file.
+ */
+void front_coding_close(Front_Coded* coded);
+
+/**
+ * @brief front_coding_find Searches the word without loading the file.
+ * @param coded The opened file.
+ * @param word The word.
+ * @param frequency Pointer to store frequency of the found word or NULL.
+ * @return True if the file contains the word.
+ * The block is found by binary search in the index, then only this block is read and decoded.
+ */
+bool front_coding_find(Front_Coded* coded, const wchar_t* word, unsigned* frequency);
+
+/**
+ * @brief front_coding_for_each_word Reads all words in order.
+ * @param coded The opened file.
+ * @param callback Called for every word.
+ * @param data Passed to callback.
+ * @return Number of read words or -1 if the file is broken.
+ */
+long front_coding_for_each_word(Front_Coded* coded, Front_Coding_Callback callback, void* data);
+
+#endif // FRONT_CODING_H_INCLUDED
@@ -0,0 +1,120 @@
+/** @file
+    Implementation of binary heap.
+    @ingroup heap
+    @author agent
+    @date 2026-10
+  */
+
+#include <stdlib.h>
+#include <assert.h>
+#include <stdbool.h>
+
+#include "heap.h"
+#include "error_handling.h"
+
+#ifdef HEAP_UNIT_TESTING
+#include <stdarg.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#ifdef malloc
+#undef malloc
+#endif // malloc
+#define malloc(size) _test_malloc(size, __FILE__, __LINE__)
+
+#ifdef realloc
+#undef realloc
+#endif // realloc
+#define realloc(ptr, size) _test_realloc(ptr, size, __FILE__, __LINE__)
+
+#ifdef free
+#undef free
+#endif // free
+#define free(ptr) _test_free(ptr, __FILE__, __LINE__)
+
+#ifdef assert
+#undef assert
+#define assert(expression) mock_assert((int)(expression), #expression, __FILE__, __LINE__);
+#endif
+#endif // HEAP_UNIT_TESTING
+
+Heap* heap_new(int (*cmp)(void*, void*))
+{
+    assert(cmp != NULL);
+    Heap* ret = malloc(sizeof(Heap));
+    if(ret == NULL) report_error(MEMORY);
+    ret->array_size = HEAP_START_SIZE;
+    ret->element_count = 0;
+    ret->cmp = cmp;
+    ret->storage = malloc(sizeof(void*) * ret->array_size);
+    if(ret->storage == NULL) report_error(MEMORY);
+    return ret;
+}
+
+void heap_free(Heap* heap)
+{
+    assert(heap != NULL);
+    free(heap->storage);
+    free(heap);
+}
+
+///Swaps two elements of the storage.
+static void swap(Heap* heap, size_t a, size_t b)
+{
+    void* tmp = heap->storage[a];
+    heap->storage[a] = heap->storage[b];
+    heap->storage[b] = tmp;
+}
+
+void heap_push(Heap* heap, void* element)
+{
+    assert(heap != NULL);
+    if(heap->element_count == heap->array_size)
+    {
+        heap->array_size *= 2;
+        heap->storage = realloc(heap->storage, sizeof(void*) * heap->array_size);
+        if(heap->storage == NULL) report_error(MEMORY);
+    }
+    size_t i = heap->element_count++;
+    heap->storage[i] = element;
+    while(i > 0 && heap->cmp(heap->storage[i], heap->storage[(i - 1) / 2]) < 0)
+    {
+        swap(heap, i, (i - 1) / 2);
+        i = (i - 1) / 2;
+    }
+}
+
+void* heap_top(const Heap* heap)
+{
+    assert(heap != NULL);
+    return heap->element_count == 0 ? NULL : heap->storage[0];
+}
+
+void* heap_pop(Heap* heap)
+{
+    assert(heap != NULL);
+    if(heap->element_count == 0)
+        return NULL;
+    void* ret = heap->storage[0];
+    heap->storage[0] = heap->storage[--heap->element_count];
+    size_t i = 0;
+    while(true)
+    {
+        size_t smallest = i;
+        size_t left = 2 * i + 1;
+        size_t right = left + 1;
+        if(left < heap->element_count && heap->cmp(heap->storage[left], heap->storage[smallest]) < 0)
+            smallest = left;
+        if(right < heap->element_count && heap->cmp(heap->storage[right], heap->storage[smallest]) < 0)
+            smallest = right;
+        if(smallest == i)
+            return ret;
+        swap(heap, i, smallest);
+        i = smallest;
+    }
+}
+
+size_t heap_size(const Heap* heap)
+{
+    assert(heap != NULL);
+    return heap->element_count;
+}
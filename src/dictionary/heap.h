@@ -0,0 +1,70 @@
+#ifndef HEAP_H_INCLUDED
+#define HEAP_H_INCLUDED
+
+/** @defgroup heap Module heap
+ * Binary heap of pointers, used as priority queue.
+ */
+/**
+ * @file heap.h Header file of module heap.
+ * @ingroup heap
+ * @author agent <agent@local>
+ * @date 2026-10
+ */
+
+#include <stddef.h>
+
+#define HEAP_START_SIZE 16 ///<Start size of the heap's storage array. Must be positive.
+
+/**
+  * Binary heap with the smallest element, according to cmp, on top.
+  */
+typedef struct
+{
+    size_t array_size; ///<Current storage array size.
+    size_t element_count; ///<Number of stored elements.
+    int (*cmp)(void*, void*); ///<Function used to compare elements. Must provide linear ordering.
+    void** storage; ///<Storage array.
+} Heap;
+
+/**
+ * @brief heap_new Creates an empty heap.
+ * @param cmp Function comparing elements.
+ * @return Pointer to the new heap.
+ */
+Heap* heap_new(int (*cmp)(void*, void*));
+
+/**
+ * @brief heap_free Deallocates the heap, but not its elements.
+ * @param heap The heap.
+ */
+void heap_free(Heap* heap);
+
+/**
+ * @brief heap_push Adds element to the heap.
+ * @param heap The heap.
+ * @param element The element.
+ */
+void heap_push(Heap* heap, void* element);
+
+/**
+ * @brief heap_top Returns the smallest element.
+ * @param heap The heap.
+ * @return The smallest element or NULL if heap is empty.
+ */
+void* heap_top(const Heap* heap);
+
+/**
+ * @brief heap_pop Removes the smallest element.
+ * @param heap The heap.
+ * @return The removed element or NULL if heap was empty.
+ */
+void* heap_pop(Heap* heap);
+
+/**
+ * @brief heap_size Returns number of elements.
+ * @param heap The heap.
+ * @return Number of elements.
+ */
+size_t heap_size(const Heap* heap);
+
+#endif // HEAP_H_INCLUDED
@@ -0,0 +1,1188 @@
+/** @file
+    Implementation of hints generation.
+    @ingroup hints
+    @author agent
+    @date 2026-10
+  */
+
+#include <stdlib.h>
+#include <wchar.h>
+#include <string.h>
+#include <assert.h>
+#include <stdbool.h>
+#include <time.h>
+#include <pthread.h>
+
+#include "hints.h"
+#include "trie.h"
+#include "word_list.h"
+#include "edit_distance.h"
+#include "edit_costs.h"
+#include "heap.h"
+#include "error_handling.h"
+
+#ifdef HINTS_UNIT_TESTING
+#include <stdarg.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#ifdef malloc
+#undef malloc
+#endif // malloc
+#define malloc(size) _test_malloc(size, __FILE__, __LINE__)
+
+#ifdef calloc
+#undef calloc
+#endif // calloc
+#define calloc(num, size) _test_calloc(num, size, __FILE__, __LINE__)
+
+#ifdef realloc
+#undef realloc
+#endif // realloc
+#define realloc(ptr, size) _test_realloc(ptr, size, __FILE__, __LINE__)
+
+#ifdef free
+#undef free
+#endif // free
+#define free(ptr) _test_free(ptr, __FILE__, __LINE__)
+
+#ifdef assert
+#undef assert
+#define assert(expression) mock_assert((int)(expression), #expression, __FILE__, __LINE__);
+#endif
+#endif // HINTS_UNIT_TESTING
+
+#define HINTS_CLOCK_CHECK_PERIOD 64 ///<Number of visited nodes between two checks of the clock and shared counters.
+
+/**
+  * State shared by all workers of a single hints generation.
+  */
+typedef struct
+{
+    const wchar_t* word; ///<Word to give hints of.
+    int len; ///<Length of the word.
+    int max_edits; ///<Maximal edit distance of a hint.
+    const Hints_Options* options; ///<Limits of the generation.
+    struct timespec deadline; ///<Moment after which generation stops, valid if time budget is set.
+    const Node* root; ///<Root of the trie.
+    Word_List* task_lists; ///<Hints of every task (first-branch subtree), merged in task order.
+    int task_count; ///<Number of tasks.
+    volatile int next_task; ///<Index of the first task not taken by any worker.
+    volatile int cutoff_task; ///<Lowest task which hit max_results, later tasks are not needed.
+    volatile size_t visited; ///<Number of visited nodes, flushed periodically by workers.
+    volatile int stopped; ///<Nonzero if node or time budget was exhausted.
+} Hints_Shared;
+
+/**
+  * State of a single worker of hints generation.
+  * <p>
+  * Edit distances between the word and the prefix spelled by the current path are kept
+  * in rows, one row per depth. Only a band of 2*max_edits+1 cells around the diagonal
+  * is stored, cell j of row d corresponds to the prefix of the word of length d-max_edits+j.
+  */
+typedef struct
+{
+    Hints_Shared* shared; ///<State shared with other workers.
+    int width; ///<Width of the band, 2*max_edits+1.
+    int* rows; ///<Band rows, one per depth, (len+max_edits+1)*width cells.
+    wchar_t* prefix; ///<Letters on the path from the root to the current node.
+    int task; ///<Index of the task being processed.
+    Word_List* list; ///<List where hints of the current task are appended.
+    size_t found; ///<Number of hints found in the current task.
+    size_t visited; ///<Number of nodes visited since the last flush to the shared counter.
+    size_t visited_before; ///<Value of the shared counter after the last flush.
+    bool task_full; ///<True if the current task hit max_results.
+} Hints_Search;
+
+void hints_default_options(Hints_Options* options)
+{
+    assert(options != NULL);
+    options->max_edits = HINTS_DEFAULT_MAX_EDITS;
+    options->max_results = HINTS_UNLIMITED;
+    options->max_visited_nodes = HINTS_UNLIMITED;
+    options->time_budget_us = HINTS_UNLIMITED;
+    options->threads = 1;
+}
+
+///Returns pointer to the band row for given depth.
+static int* band_row(Hints_Search* search, int depth)
+{
+    return search->rows + (size_t) depth * search->width;
+}
+
+/**
+ * @brief set_deadline Sets deadline to now plus given budget.
+ * @param deadline Deadline to set.
+ * @param budget_us Budget in microseconds.
+ */
+static void set_deadline(struct timespec* deadline, long budget_us)
+{
+    clock_gettime(CLOCK_MONOTONIC, deadline);
+    deadline->tv_sec += budget_us / 1000000;
+    deadline->tv_nsec += (budget_us % 1000000) * 1000;
+    if(deadline->tv_nsec >= 1000000000)
+    {
+        deadline->tv_sec++;
+        deadline->tv_nsec -= 1000000000;
+    }
+}
+
+///Returns true if the clock passed the deadline.
+static bool deadline_passed(const struct timespec* deadline)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    if(now.tv_sec != deadline->tv_sec)
+        return now.tv_sec > deadline->tv_sec;
+    return now.tv_nsec >= deadline->tv_nsec;
+}
+
+/**
+ * @brief budget_exhausted Counts a visit of a node and checks node and time budgets.
+ * @param search The worker.
+ * @return True if the generation should stop.
+ */
+static bool budget_exhausted(Hints_Search* search)
+{
+    Hints_Shared* shared = search->shared;
+    const Hints_Options* options = shared->options;
+    if(__atomic_load_n(&shared->stopped, __ATOMIC_RELAXED))
+        return true;
+    if(options->max_visited_nodes != HINTS_UNLIMITED
+            && search->visited_before + search->visited >= options->max_visited_nodes)
+        return true;
+    search->visited++;
+    if(search->visited == HINTS_CLOCK_CHECK_PERIOD)
+    {
+        search->visited_before = __sync_add_and_fetch(&shared->visited, search->visited);
+        search->visited = 0;
+        if(options->time_budget_us != HINTS_UNLIMITED)
+            return deadline_passed(&shared->deadline);
+    }
+    return false;
+}
+
+/**
+ * @brief band_root_row Fills band row of the empty prefix.
+ * @param row Row to fill, 2*max_edits+1 cells.
+ * @param len Length of the word.
+ * @param max_edits Maximal edit distance, greater values are stored as max_edits+1.
+ */
+static void band_root_row(int* row, int len, int max_edits)
+{
+    for(int j = 0; j < 2 * max_edits + 1; j++)
+    {
+        int i = j - max_edits;
+        row[j] = (0 <= i && i <= len && i <= max_edits) ? i : max_edits + 1;
+    }
+}
+
+/**
+ * @brief band_child_row Computes band row of a child from the band row of its parent.
+ * @param word The word.
+ * @param len Length of the word.
+ * @param max_edits Maximal edit distance, greater values are stored as max_edits+1.
+ * @param parent Row of the parent.
+ * @param child Row of the child to fill.
+ * @param depth Depth of the parent.
+ * @param letter Letter of the child.
+ * @return Minimum of the computed row.
+ */
+static int band_child_row(const wchar_t* word, int len, int max_edits,
+                          const int* parent, int* child, int depth, wchar_t letter)
+{
+    const int inf = max_edits + 1;
+    const int width = 2 * max_edits + 1;
+    int row_min = inf;
+
+    for(int j = 0; j < width; j++)
+    {
+        int i = depth + 1 - max_edits + j; //length of the prefix of the word
+        int best = inf;
+        if(i < 0 || i > len)
+        {
+            child[j] = inf;
+            continue;
+        }
+        if(j + 1 < width && parent[j+1] + 1 < best) //letter inserted
+            best = parent[j+1] + 1;
+        if(j > 0 && child[j-1] + 1 < best) //letter of the word removed
+            best = child[j-1] + 1;
+        if(i > 0 && parent[j] + (word[i-1] != letter) < best) //letter matched or replaced
+            best = parent[j] + (word[i-1] != letter);
+        child[j] = best;
+        if(best < row_min)
+            row_min = best;
+    }
+    return row_min;
+}
+
+/**
+ * @brief band_accepts Tests whether the prefix of given band row is within max_edits from the whole word.
+ * @param row Band row of the prefix.
+ * @param len Length of the word.
+ * @param max_edits Maximal edit distance.
+ * @param depth Length of the prefix.
+ * @return True if the prefix is close enough to the word.
+ */
+static bool band_accepts(const int* row, int len, int max_edits, int depth)
+{
+    int word_cell = len - depth + max_edits;
+    return 0 <= word_cell && word_cell < 2 * max_edits + 1 && row[word_cell] <= max_edits;
+}
+
+///Computes band row of a child for the worker, see band_child_row().
+static int fill_child_row(Hints_Search* search, int depth, wchar_t letter)
+{
+    const Hints_Shared* shared = search->shared;
+    return band_child_row(shared->word, shared->len, shared->max_edits,
+                          band_row(search, depth), band_row(search, depth + 1), depth, letter);
+}
+
+/**
+ * @brief add_hint Adds the current prefix as a hint of the current task, unless max_results is hit.
+ * @param search The worker.
+ * @param depth Length of the current prefix.
+ * Tasks are merged in order, so when a task hits max_results, no later task can contribute.
+ */
+static void add_hint(Hints_Search* search, int depth)
+{
+    Hints_Shared* shared = search->shared;
+    if(shared->options->max_results != HINTS_UNLIMITED && search->found >= shared->options->max_results)
+    {
+        search->task_full = true;
+        int cutoff = __atomic_load_n(&shared->cutoff_task, __ATOMIC_RELAXED);
+        while(search->task < cutoff)
+            cutoff = __sync_val_compare_and_swap(&shared->cutoff_task, cutoff, search->task);
+        return;
+    }
+    search->prefix[depth] = L'\0';
+    word_list_add(search->list, search->prefix);
+    search->found++;
+}
+
+///Returns true if the worker should not visit any more nodes of the current task.
+static bool task_finished(const Hints_Search* search)
+{
+    const Hints_Shared* shared = search->shared;
+    return search->task_full || __atomic_load_n(&shared->stopped, __ATOMIC_RELAXED)
+            || search->task > __atomic_load_n(&shared->cutoff_task, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief visit Visits node and recursively its children which may lead to hints.
+ * @param search The worker.
+ * @param node Visited node, its band row must be already computed.
+ * @param depth Depth of the node.
+ */
+static void visit(Hints_Search* search, const Node* node, int depth)
+{
+    Hints_Shared* shared = search->shared;
+    if(task_finished(search))
+        return;
+    if(budget_exhausted(search))
+    {
+        __atomic_store_n(&shared->stopped, 1, __ATOMIC_RELAXED);
+        return;
+    }
+
+    if(node->is_word && band_accepts(band_row(search, depth), shared->len, shared->max_edits, depth))
+        add_hint(search, depth);
+
+    if(depth == shared->len + shared->max_edits) //every longer prefix is too far
+        return;
+
+    for(int i = 0; i < node->children->element_count && !task_finished(search); i++)
+    {
+        const Node* child = node->children->storage[i];
+        if(fill_child_row(search, depth, child->value) > shared->max_edits)
+            continue;
+        search->prefix[depth] = child->value;
+        visit(search, child, depth + 1);
+    }
+}
+
+/**
+ * @brief init_search Allocates buffers of a worker.
+ * @param search The worker.
+ * @param shared State shared with other workers.
+ */
+static void init_search(Hints_Search* search, Hints_Shared* shared)
+{
+    memset(search, 0, sizeof(Hints_Search));
+    search->shared = shared;
+    search->width = 2 * shared->max_edits + 1;
+
+    int max_depth = shared->len + shared->max_edits;
+    search->rows = malloc(sizeof(int) * (size_t) (max_depth + 1) * search->width);
+    if(search->rows == NULL) report_error(MEMORY);
+    search->prefix = malloc(sizeof(wchar_t) * (max_depth + 1));
+    if(search->prefix == NULL) report_error(MEMORY);
+    band_root_row(band_row(search, 0), shared->len, shared->max_edits);
+}
+
+///Deallocates buffers of a worker and flushes its visit counter.
+static void done_search(Hints_Search* search)
+{
+    __sync_add_and_fetch(&search->shared->visited, search->visited);
+    free(search->rows);
+    free(search->prefix);
+}
+
+/**
+ * @brief run_worker Takes first-branch subtrees of the root one by one and searches them.
+ * @param data Pointer to Hints_Shared.
+ * @return NULL.
+ */
+static void* run_worker(void* data)
+{
+    Hints_Shared* shared = data;
+    Hints_Search search;
+    init_search(&search, shared);
+
+    int task;
+    while((task = __sync_fetch_and_add(&shared->next_task, 1)) < shared->task_count)
+    {
+        const Node* child = shared->root->children->storage[task];
+        search.task = task;
+        search.list = &shared->task_lists[task];
+        search.found = 0;
+        search.task_full = false;
+        if(fill_child_row(&search, 0, child->value) > shared->max_edits)
+            continue;
+        search.prefix[0] = child->value;
+        visit(&search, child, 1);
+    }
+
+    done_search(&search);
+    return NULL;
+}
+
+/**
+ * @brief use_threads Decides how many threads should generate hints.
+ * @param shared The generation.
+ * @return Number of threads, 1 means the calling thread only.
+ * Fan-out pays off only for long words or large first level of the trie.
+ */
+static int use_threads(const Hints_Shared* shared)
+{
+    int threads = shared->options->threads;
+    if(threads <= 1)
+        return 1;
+    if(shared->len < HINTS_PARALLEL_MIN_LENGTH
+            && shared->root->children->element_count < HINTS_PARALLEL_MIN_FANOUT)
+        return 1;
+    if(threads > shared->root->children->element_count)
+        threads = shared->root->children->element_count;
+    return threads > 1 ? threads : 1;
+}
+
+/**
+ * @brief generate_parallel Runs workers on first-branch subtrees and merges their hints in trie order.
+ * @param shared The generation.
+ * @param threads Number of threads, including the calling one.
+ * @param list List where hints are appended.
+ */
+static void generate_parallel(Hints_Shared* shared, int threads, Word_List* list)
+{
+    shared->task_count = shared->root->children->element_count;
+    shared->cutoff_task = shared->task_count;
+    shared->task_lists = malloc(sizeof(Word_List) * shared->task_count);
+    if(shared->task_lists == NULL) report_error(MEMORY);
+    for(int i = 0; i < shared->task_count; i++)
+        word_list_init(&shared->task_lists[i]);
+
+    pthread_t* helpers = malloc(sizeof(pthread_t) * threads);
+    if(helpers == NULL) report_error(MEMORY);
+    int started = 0;
+    for(int i = 1; i < threads; i++)
+        if(pthread_create(&helpers[started], NULL, run_worker, shared) == 0)
+            started++; //if a thread cannot be started, the others take its share
+    run_worker(shared);
+    for(int i = 0; i < started; i++)
+        pthread_join(helpers[i], NULL);
+    free(helpers);
+
+    size_t max_results = shared->options->max_results;
+    size_t merged = 0;
+    for(int i = 0; i < shared->task_count; i++)
+    {
+        for(struct word_node* node = shared->task_lists[i].first; node != NULL; node = node->next)
+        {
+            if(max_results != HINTS_UNLIMITED && merged >= max_results)
+            {
+                shared->stopped = 1;
+                break;
+            }
+            word_list_add(list, node->word);
+            merged++;
+        }
+        word_list_done(&shared->task_lists[i]);
+    }
+    free(shared->task_lists);
+}
+
+/**
+ * @brief init_shared Prepares state of a single hints generation and starts its clock.
+ * @param shared State to fill.
+ * @param root Root of the trie.
+ * @param word The word.
+ * @param options Limits of the generation.
+ */
+static void init_shared(Hints_Shared* shared, const Node* root, const wchar_t* word, const Hints_Options* options)
+{
+    memset(shared, 0, sizeof(Hints_Shared));
+    shared->word = word;
+    shared->len = wcslen(word);
+    shared->max_edits = options->max_edits > 0 ? options->max_edits : 0;
+    shared->options = options;
+    shared->root = root;
+
+    if(options->time_budget_us != HINTS_UNLIMITED)
+        set_deadline(&shared->deadline, options->time_budget_us);
+}
+
+/**
+ * @brief generate_shared Runs prepared hints generation by one or many threads.
+ * @param shared The generation, prepared by init_shared().
+ * @param list List where hints are appended.
+ * @return HINTS_COMPLETE or HINTS_PARTIAL, if any of the limits was hit.
+ */
+static int generate_shared(Hints_Shared* shared, Word_List* list)
+{
+    int threads = use_threads(shared);
+    if(threads > 1)
+    {
+        generate_parallel(shared, threads, list);
+        return shared->stopped || shared->cutoff_task < shared->task_count ? HINTS_PARTIAL : HINTS_COMPLETE;
+    }
+
+    Hints_Search search;
+    shared->cutoff_task = 1;
+    init_search(&search, shared);
+    search.list = list;
+    visit(&search, shared->root, 0);
+    done_search(&search);
+    return shared->stopped || search.task_full ? HINTS_PARTIAL : HINTS_COMPLETE;
+}
+
+int hints_generate(const Node* root, const wchar_t* word, const Hints_Options* options, Word_List* list)
+{
+    assert(root != NULL);
+    assert(word != NULL);
+    assert(options != NULL);
+    assert(list != NULL);
+
+    Hints_Shared shared;
+    init_shared(&shared, root, word, options);
+    return generate_shared(&shared, list);
+}
+
+/**
+  * Candidate for one of the best hints.
+  */
+typedef struct
+{
+    const Node* node; ///<Node of the hint.
+    int depth; ///<Length of the hint.
+    int distance; ///<Edit distance of the hint from the word.
+    size_t order; ///<Position of the node in trie order among candidates.
+} Ranked_Hint;
+
+/**
+  * State of a search for the best hints.
+  * <p>
+  * The best candidates found so far are kept in a heap with the worst one on top,
+  * so a better candidate replaces it in logarithmic time.
+  */
+typedef struct
+{
+    Hints_Search search; ///<Band rows and budgets, see Hints_Search.
+    Ranked_Hint* heap; ///<Best candidates found so far.
+    size_t count; ///<Number of candidates in the heap.
+    size_t k; ///<Number of wanted hints.
+    size_t next_order; ///<Position of the next candidate in trie order.
+} Top_Search;
+
+///Returns true if hint a is ranked lower than hint b.
+static bool ranked_lower(const Ranked_Hint* a, const Ranked_Hint* b)
+{
+    if(a->node->frequency != b->node->frequency)
+        return a->node->frequency < b->node->frequency;
+    if(a->distance != b->distance)
+        return a->distance > b->distance;
+    return a->order > b->order;
+}
+
+///Comparison function to sort ranked hints from the best one.
+static int cmp_ranked(const void* a, const void* b)
+{
+    if(ranked_lower(a, b)) return 1;
+    if(ranked_lower(b, a)) return -1;
+    return 0;
+}
+
+///Restores heap order after the top candidate was replaced.
+static void heap_sift_down(Top_Search* top)
+{
+    size_t i = 0;
+    while(true)
+    {
+        size_t lowest = i;
+        size_t left = 2 * i + 1;
+        size_t right = left + 1;
+        if(left < top->count && ranked_lower(&top->heap[left], &top->heap[lowest]))
+            lowest = left;
+        if(right < top->count && ranked_lower(&top->heap[right], &top->heap[lowest]))
+            lowest = right;
+        if(lowest == i)
+            return;
+        Ranked_Hint tmp = top->heap[i];
+        top->heap[i] = top->heap[lowest];
+        top->heap[lowest] = tmp;
+        i = lowest;
+    }
+}
+
+///Restores heap order after a candidate was appended.
+static void heap_sift_up(Top_Search* top)
+{
+    size_t i = top->count - 1;
+    while(i > 0 && ranked_lower(&top->heap[i], &top->heap[(i - 1) / 2]))
+    {
+        Ranked_Hint tmp = top->heap[i];
+        top->heap[i] = top->heap[(i - 1) / 2];
+        top->heap[(i - 1) / 2] = tmp;
+        i = (i - 1) / 2;
+    }
+}
+
+///Offers node as a candidate, keeping the k best ones.
+static void offer_hint(Top_Search* top, const Node* node, int depth, int distance)
+{
+    Ranked_Hint hint = {.node = node, .depth = depth, .distance = distance, .order = top->next_order++};
+    if(top->count < top->k)
+    {
+        top->heap[top->count++] = hint;
+        heap_sift_up(top);
+    }
+    else if(ranked_lower(&top->heap[0], &hint))
+    {
+        top->heap[0] = hint;
+        heap_sift_down(top);
+    }
+}
+
+/**
+ * @brief may_improve Tests whether the subtree of node may contain a hint better than the worst kept one.
+ * @param top The search.
+ * @param node Root of the subtree.
+ * @return False if the subtree can be skipped.
+ * Later nodes come later in trie order, so with equal frequency they have to be closer to the word.
+ */
+static bool may_improve(const Top_Search* top, const Node* node)
+{
+    if(top->count < top->k)
+        return true;
+    const Ranked_Hint* worst = &top->heap[0];
+    if(node->max_frequency != worst->node->frequency)
+        return node->max_frequency > worst->node->frequency;
+    return worst->distance > 0;
+}
+
+/**
+ * @brief visit_top Visits node and recursively its children which may lead to the best hints.
+ * @param top The search.
+ * @param node Visited node, its band row must be already computed.
+ * @param depth Depth of the node.
+ */
+static void visit_top(Top_Search* top, const Node* node, int depth)
+{
+    Hints_Search* search = &top->search;
+    Hints_Shared* shared = search->shared;
+    if(shared->stopped)
+        return;
+    if(budget_exhausted(search))
+    {
+        shared->stopped = 1;
+        return;
+    }
+
+    const int* row = band_row(search, depth);
+    if(node->is_word && band_accepts(row, shared->len, shared->max_edits, depth))
+        offer_hint(top, node, depth, row[shared->len - depth + shared->max_edits]);
+
+    if(depth == shared->len + shared->max_edits) //every longer prefix is too far
+        return;
+
+    for(int i = 0; i < node->children->element_count && !shared->stopped; i++)
+    {
+        const Node* child = node->children->storage[i];
+        if(!may_improve(top, child))
+            continue;
+        if(fill_child_row(search, depth, child->value) > shared->max_edits)
+            continue;
+        visit_top(top, child, depth + 1);
+    }
+}
+
+int hints_generate_top(const Node* root, const wchar_t* word, const Hints_Options* options,
+                       size_t k, Word_List* list)
+{
+    assert(root != NULL);
+    assert(word != NULL);
+    assert(options != NULL);
+    assert(list != NULL);
+
+    if(k == 0)
+        return HINTS_COMPLETE;
+
+    Hints_Shared shared;
+    init_shared(&shared, root, word, options);
+
+    Top_Search top;
+    init_search(&top.search, &shared);
+    top.heap = malloc(sizeof(Ranked_Hint) * k);
+    if(top.heap == NULL) report_error(MEMORY);
+    top.count = 0;
+    top.k = k;
+    top.next_order = 0;
+    visit_top(&top, root, 0);
+
+    qsort(top.heap, top.count, sizeof(Ranked_Hint), cmp_ranked);
+    wchar_t* hint = top.search.prefix; //long enough for every hint
+    for(size_t i = 0; i < top.count; i++)
+    {
+        const Node* node = top.heap[i].node;
+        hint[top.heap[i].depth] = L'\0';
+        for(int d = top.heap[i].depth - 1; d >= 0; d--, node = node->parent)
+            hint[d] = node->value;
+        word_list_add(list, hint);
+    }
+
+    free(top.heap);
+    done_search(&top.search);
+    return shared.stopped ? HINTS_PARTIAL : HINTS_COMPLETE;
+}
+
+/**
+  * Entry of the frontier of weighted search: a node to expand or a hint to report.
+  */
+typedef struct
+{
+    const Node* node; ///<The node.
+    int depth; ///<Depth of the node.
+    int cost; ///<Lower bound of cost of hints in the subtree of the node, or cost of the hint.
+    bool hint; ///<True if the entry is a hint to report.
+    size_t order; ///<Number of entries created before this one, breaks ties.
+    int* row; ///<Costs of turning prefixes of the word into the prefix of the node, NULL for hints.
+} Weighted_Entry;
+
+/**
+ * Hint found by weighted search.
+ */
+typedef struct
+{
+    wchar_t* word; ///<The hint.
+    int cost; ///<Cost of the hint.
+    unsigned char frequency; ///<Frequency of the hint.
+} Weighted_Hint;
+
+///Comparison function of the frontier, cheaper first, hints before nodes of the same cost.
+static int cmp_weighted_entry(void* a, void* b)
+{
+    const Weighted_Entry* x = a;
+    const Weighted_Entry* y = b;
+    if(x->cost != y->cost)
+        return x->cost < y->cost ? -1 : 1;
+    if(x->hint != y->hint)
+        return x->hint ? -1 : 1;
+    if(x->order != y->order)
+        return x->order < y->order ? -1 : 1;
+    return 0;
+}
+
+///Comparison function to sort found hints, cheaper first, then more frequent, then alphabetically.
+static int cmp_weighted_hint(const void* a, const void* b)
+{
+    const Weighted_Hint* x = a;
+    const Weighted_Hint* y = b;
+    if(x->cost != y->cost)
+        return x->cost < y->cost ? -1 : 1;
+    if(x->frequency != y->frequency)
+        return x->frequency > y->frequency ? -1 : 1;
+    return wcscmp(x->word, y->word);
+}
+
+/**
+ * @brief weighted_child_row Computes costs of turning prefixes of the word into the prefix of a child.
+ * @param word The word.
+ * @param len Length of the word.
+ * @param costs Costs of edits.
+ * @param parent Row of the parent, len+1 cells.
+ * @param child Row of the child to fill, len+1 cells.
+ * @param letter Letter of the child.
+ * @return Minimum of the computed row.
+ */
+static int weighted_child_row(const wchar_t* word, int len, const Edit_Costs* costs,
+                              const int* parent, int* child, wchar_t letter)
+{
+    child[0] = parent[0] + costs->insert_cost;
+    int row_min = child[0];
+    for(int i = 1; i <= len; i++)
+    {
+        int best = parent[i-1] + edit_costs_replace(costs, word[i-1], letter);
+        if(parent[i] + costs->insert_cost < best)
+            best = parent[i] + costs->insert_cost;
+        if(child[i-1] + costs->delete_cost < best)
+            best = child[i-1] + costs->delete_cost;
+        child[i] = best;
+        if(best < row_min)
+            row_min = best;
+    }
+    return row_min;
+}
+
+///Creates entry of the frontier of weighted search.
+static Weighted_Entry* new_weighted_entry(const Node* node, int depth, int cost, bool hint, size_t* order)
+{
+    Weighted_Entry* ret = malloc(sizeof(Weighted_Entry));
+    if(ret == NULL) report_error(MEMORY);
+    ret->node = node;
+    ret->depth = depth;
+    ret->cost = cost;
+    ret->hint = hint;
+    ret->order = (*order)++;
+    ret->row = NULL;
+    return ret;
+}
+
+///Deallocates entry of the frontier of weighted search.
+static void free_weighted_entry(Weighted_Entry* entry)
+{
+    free(entry->row);
+    free(entry);
+}
+
+///Copies word spelled by the path from the root to node of given depth.
+static wchar_t* path_word(const Node* node, int depth)
+{
+    wchar_t* ret = malloc(sizeof(wchar_t) * (depth + 1));
+    if(ret == NULL) report_error(MEMORY);
+    ret[depth] = L'\0';
+    for(int d = depth - 1; d >= 0; d--, node = node->parent)
+        ret[d] = node->value;
+    return ret;
+}
+
+int hints_generate_weighted(const Node* root, const wchar_t* word, const Hints_Options* options,
+                            const Edit_Costs* costs, size_t k, Word_List* list)
+{
+    assert(root != NULL);
+    assert(word != NULL);
+    assert(options != NULL);
+    assert(costs != NULL);
+    assert(costs->insert_cost > 0);
+    assert(list != NULL);
+
+    if(k == 0)
+        return HINTS_COMPLETE;
+
+    Hints_Shared shared;
+    init_shared(&shared, root, word, options);
+    Hints_Search search; //counts visited nodes only
+    init_search(&search, &shared);
+    const int len = shared.len;
+    const int max_cost = shared.max_edits * EDIT_COSTS_UNIT;
+
+    size_t order = 0;
+    Heap* frontier = heap_new(cmp_weighted_entry);
+    Weighted_Entry* entry = new_weighted_entry(root, 0, 0, false, &order);
+    entry->row = malloc(sizeof(int) * (len + 1));
+    if(entry->row == NULL) report_error(MEMORY);
+    for(int i = 0; i <= len; i++)
+        entry->row[i] = i * costs->delete_cost;
+    heap_push(frontier, entry);
+
+    Weighted_Hint* found = malloc(sizeof(Weighted_Hint) * k);
+    if(found == NULL) report_error(MEMORY);
+    size_t found_count = 0;
+    size_t found_size = k;
+    int kth_cost = max_cost;
+
+    while((entry = heap_pop(frontier)) != NULL)
+    {
+        if(entry->cost > kth_cost) //nothing cheaper left
+        {
+            free_weighted_entry(entry);
+            break;
+        }
+        if(entry->hint)
+        {
+            if(found_count == found_size)
+            {
+                found_size *= 2;
+                found = realloc(found, sizeof(Weighted_Hint) * found_size);
+                if(found == NULL) report_error(MEMORY);
+            }
+            found[found_count].word = path_word(entry->node, entry->depth);
+            found[found_count].cost = entry->cost;
+            found[found_count].frequency = entry->node->frequency;
+            if(++found_count == k)
+                kth_cost = entry->cost; //hints of equal cost are still collected to rank them
+            free_weighted_entry(entry);
+            continue;
+        }
+        if(budget_exhausted(&search))
+        {
+            shared.stopped = 1;
+            free_weighted_entry(entry);
+            break;
+        }
+
+        const Node* node = entry->node;
+        if(node->is_word && entry->row[len] <= kth_cost)
+            heap_push(frontier, new_weighted_entry(node, entry->depth, entry->row[len], true, &order));
+        for(int i = 0; i < node->children->element_count; i++)
+        {
+            const Node* child = node->children->storage[i];
+            int* row = malloc(sizeof(int) * (len + 1));
+            if(row == NULL) report_error(MEMORY);
+            int row_min = weighted_child_row(word, len, costs, entry->row, row, child->value);
+            if(row_min > kth_cost)
+            {
+                free(row);
+                continue;
+            }
+            Weighted_Entry* child_entry = new_weighted_entry(child, entry->depth + 1, row_min, false, &order);
+            child_entry->row = row;
+            heap_push(frontier, child_entry);
+        }
+        free_weighted_entry(entry);
+    }
+    while((entry = heap_pop(frontier)) != NULL)
+        free_weighted_entry(entry);
+    heap_free(frontier);
+    done_search(&search);
+
+    qsort(found, found_count, sizeof(Weighted_Hint), cmp_weighted_hint);
+    for(size_t i = 0; i < found_count; i++)
+    {
+        if(i < k)
+            word_list_add(list, found[i].word);
+        free(found[i].word);
+    }
+    free(found);
+    return shared.stopped ? HINTS_PARTIAL : HINTS_COMPLETE;
+}
+
+/**
+  * Hint with its distance from the word, used to order hints.
+  */
+typedef struct
+{
+    struct word_node* node; ///<Node of the list with the hint.
+    int distance; ///<Damerau distance of the hint from the word.
+    size_t position; ///<Position of the hint in the list before ordering.
+} Scored_Hint;
+
+///Comparison function to sort hints by distance, keeping order of hints at equal distance.
+static int cmp_scored(const void* a, const void* b)
+{
+    const Scored_Hint* x = a;
+    const Scored_Hint* y = b;
+    if(x->distance != y->distance)
+        return x->distance < y->distance ? -1 : 1;
+    if(x->position != y->position)
+        return x->position < y->position ? -1 : 1;
+    return 0;
+}
+
+void hints_order_by_distance(const wchar_t* word, Word_List* list)
+{
+    assert(word != NULL);
+    assert(list != NULL);
+
+    size_t count = word_list_size(list);
+    if(count < 2)
+        return;
+
+    Scored_Hint* scored = malloc(sizeof(Scored_Hint) * count);
+    if(scored == NULL) report_error(MEMORY);
+    Edit_Pattern* pattern = edit_pattern_new(word);
+    size_t i = 0;
+    for(struct word_node* node = list->first; node != NULL; node = node->next, i++)
+    {
+        scored[i].node = node;
+        scored[i].distance = edit_pattern_distance(pattern, node->word, true);
+        scored[i].position = i;
+    }
+    edit_pattern_free(pattern);
+
+    qsort(scored, count, sizeof(Scored_Hint), cmp_scored);
+    list->first = scored[0].node;
+    for(i = 0; i + 1 < count; i++)
+        scored[i].node->next = scored[i+1].node;
+    scored[count-1].node->next = NULL;
+    list->last = scored[count-1].node;
+    free(scored);
+}
+
+/**
+  * Single query of a batch hints generation.
+  */
+typedef struct
+{
+    const wchar_t* word; ///<Word to give hints of.
+    int len; ///<Length of the word.
+    int* rows; ///<Band rows of the query, one per depth, see Hints_Search.
+    Word_List* list; ///<List where hints are appended.
+    size_t found; ///<Number of hints found so far.
+    bool full; ///<True if the query hit max_results.
+    bool alone; ///<True if the query is long enough to be generated alone by many threads.
+} Batch_Query;
+
+/**
+  * State of a batch hints generation.
+  * <p>
+  * All queries walk the trie together. Every visited node keeps the list of queries for
+  * which it may still lead to a hint, lists of nodes on the current path form a stack.
+  */
+typedef struct
+{
+    Batch_Query* queries; ///<Distinct queries, sorted by word.
+    int max_edits; ///<Maximal edit distance of a hint.
+    int width; ///<Width of the band, 2*max_edits+1.
+    const Hints_Options* options; ///<Limits of the generation.
+    wchar_t* prefix; ///<Letters on the path from the root to the current node.
+    int* active; ///<Stack of lists of active queries.
+    size_t active_size; ///<Number of used cells of the stack.
+    size_t active_capacity; ///<Number of allocated cells of the stack.
+    size_t visited; ///<Number of trie nodes visited so far.
+    struct timespec deadline; ///<Moment after which generation stops, valid if time budget is set.
+    bool stopped; ///<True if node or time budget was exhausted.
+} Batch_Search;
+
+///Returns pointer to the band row of the query for given depth.
+static int* query_row(const Batch_Search* search, const Batch_Query* query, int depth)
+{
+    return query->rows + (size_t) depth * search->width;
+}
+
+///Counts a visit of a node in a batch and checks node and time budgets.
+static bool batch_budget_exhausted(Batch_Search* search)
+{
+    const Hints_Options* options = search->options;
+    if(options->max_visited_nodes != HINTS_UNLIMITED && search->visited >= options->max_visited_nodes)
+        return true;
+    search->visited++;
+    if(options->time_budget_us != HINTS_UNLIMITED && search->visited % HINTS_CLOCK_CHECK_PERIOD == 0)
+        return deadline_passed(&search->deadline);
+    return false;
+}
+
+///Ensures that the stack of active queries may grow by count cells.
+static void reserve_active(Batch_Search* search, size_t count)
+{
+    if(search->active_size + count <= search->active_capacity)
+        return;
+    while(search->active_size + count > search->active_capacity)
+        search->active_capacity *= 2;
+    int* grown = malloc(sizeof(int) * search->active_capacity);
+    if(grown == NULL) report_error(MEMORY);
+    memcpy(grown, search->active, sizeof(int) * search->active_size);
+    free(search->active);
+    search->active = grown;
+}
+
+/**
+ * @brief batch_visit Visits node for all queries from the top list of the stack.
+ * @param search The batch.
+ * @param node Visited node, band rows of active queries must be already computed.
+ * @param depth Depth of the node.
+ * @param first Position on the stack of the first active query.
+ * @param count Number of active queries.
+ */
+static void batch_visit(Batch_Search* search, const Node* node, int depth, size_t first, size_t count)
+{
+    if(search->stopped)
+        return;
+    if(batch_budget_exhausted(search))
+    {
+        search->stopped = true;
+        return;
+    }
+
+    size_t max_results = search->options->max_results;
+    for(size_t q = 0; q < count && node->is_word; q++)
+    {
+        Batch_Query* query = &search->queries[search->active[first + q]];
+        if(query->full || !band_accepts(query_row(search, query, depth), query->len, search->max_edits, depth))
+            continue;
+        if(max_results != HINTS_UNLIMITED && query->found >= max_results)
+        {
+            query->full = true;
+            continue;
+        }
+        search->prefix[depth] = L'\0';
+        word_list_add(query->list, search->prefix);
+        query->found++;
+    }
+
+    for(int i = 0; i < node->children->element_count && !search->stopped; i++)
+    {
+        const Node* child = node->children->storage[i];
+        reserve_active(search, count);
+        size_t child_first = search->active_size;
+        size_t child_count = 0;
+        for(size_t q = 0; q < count; q++)
+        {
+            int index = search->active[first + q];
+            Batch_Query* query = &search->queries[index];
+            if(query->full || depth == query->len + search->max_edits)
+                continue;
+            if(band_child_row(query->word, query->len, search->max_edits, query_row(search, query, depth),
+                              query_row(search, query, depth + 1), depth, child->value) > search->max_edits)
+                continue;
+            search->active[child_first + child_count++] = index;
+        }
+        if(child_count == 0)
+            continue;
+        search->active_size += child_count;
+        search->prefix[depth] = child->value;
+        batch_visit(search, child, depth + 1, child_first, child_count);
+        search->active_size -= child_count;
+    }
+}
+
+/**
+ * @brief generate_alone Generates hints of a long query by many threads, within budgets left by the batch.
+ * @param search The batch, its visit counter grows by nodes visited for the query.
+ * @param root Root of the trie.
+ * @param query The query.
+ * @return HINTS_COMPLETE or HINTS_PARTIAL, if any of the limits was hit.
+ */
+static int generate_alone(Batch_Search* search, const Node* root, Batch_Query* query)
+{
+    const Hints_Options* options = search->options;
+    Hints_Options left = *options;
+    if(options->max_visited_nodes != HINTS_UNLIMITED)
+        left.max_visited_nodes = options->max_visited_nodes - search->visited;
+
+    Hints_Shared shared;
+    init_shared(&shared, root, query->word, &left);
+    shared.deadline = search->deadline; //the clock of the batch keeps running
+    int ret = generate_shared(&shared, query->list);
+    search->visited += shared.visited;
+    return ret;
+}
+
+///Returns true if node or time budget of the batch is exhausted.
+static bool batch_budget_spent(const Batch_Search* search)
+{
+    const Hints_Options* options = search->options;
+    if(options->max_visited_nodes != HINTS_UNLIMITED && search->visited >= options->max_visited_nodes)
+        return true;
+    return options->time_budget_us != HINTS_UNLIMITED && deadline_passed(&search->deadline);
+}
+
+///Comparison of pointers to words, used to sort queries.
+static int cmp_word_ptr(const void* a, const void* b)
+{
+    return wcscmp(*(const wchar_t* const*) a, *(const wchar_t* const*) b);
+}
+
+int hints_generate_batch(const Node* root, const wchar_t* const* words, size_t count,
+                         const Hints_Options* options, Word_List* lists)
+{
+    assert(root != NULL);
+    assert(words != NULL || count == 0);
+    assert(options != NULL);
+    assert(lists != NULL || count == 0);
+
+    if(count == 0)
+        return HINTS_COMPLETE;
+
+    //sorting puts words with common prefixes next to each other and duplicates together
+    const wchar_t** sorted = malloc(sizeof(wchar_t*) * count);
+    if(sorted == NULL) report_error(MEMORY);
+    memcpy(sorted, words, sizeof(wchar_t*) * count);
+    qsort(sorted, count, sizeof(wchar_t*), cmp_word_ptr);
+
+    Batch_Search search;
+    memset(&search, 0, sizeof(Batch_Search));
+    search.max_edits = options->max_edits > 0 ? options->max_edits : 0;
+    search.width = 2 * search.max_edits + 1;
+    search.options = options;
+    search.queries = malloc(sizeof(Batch_Query) * count);
+    if(search.queries == NULL) report_error(MEMORY);
+
+    int distinct = 0;
+    int max_len = 0;
+    for(size_t i = 0; i < count; i++)
+    {
+        if(distinct > 0 && wcscmp(search.queries[distinct-1].word, sorted[i]) == 0)
+            continue;
+        Batch_Query* query = &search.queries[distinct++];
+        memset(query, 0, sizeof(Batch_Query));
+        query->word = sorted[i];
+        query->len = wcslen(sorted[i]);
+        query->list = word_list_new();
+        query->rows = malloc(sizeof(int) * (size_t) (query->len + search.max_edits + 1) * search.width);
+        if(query->rows == NULL) report_error(MEMORY);
+        band_root_row(query->rows, query->len, search.max_edits);
+        query->alone = options->threads > 1 && query->len >= HINTS_PARALLEL_MIN_LENGTH;
+        if(query->len > max_len)
+            max_len = query->len;
+    }
+    free(sorted);
+
+    search.prefix = malloc(sizeof(wchar_t) * (max_len + search.max_edits + 1));
+    if(search.prefix == NULL) report_error(MEMORY);
+    search.active_capacity = distinct;
+    search.active = malloc(sizeof(int) * search.active_capacity);
+    if(search.active == NULL) report_error(MEMORY);
+    for(int i = 0; i < distinct; i++)
+        if(!search.queries[i].alone)
+            search.active[search.active_size++] = i;
+    if(options->time_budget_us != HINTS_UNLIMITED)
+        set_deadline(&search.deadline, options->time_budget_us);
+
+    if(search.active_size > 0)
+        batch_visit(&search, root, 0, 0, search.active_size);
+
+    //long queries get only what is left of the budgets, none once the batch stopped
+    bool partial = false;
+    for(int i = 0; i < distinct && !search.stopped; i++)
+    {
+        if(!search.queries[i].alone)
+            continue;
+        if(batch_budget_spent(&search))
+            search.stopped = true;
+        else if(generate_alone(&search, root, &search.queries[i]) == HINTS_PARTIAL)
+            partial = true;
+    }
+    partial = partial || search.stopped;
+    for(size_t i = 0; i < count; i++)
+    {
+        //queries are sorted and distinct, so binary search finds the one for words[i]
+        int l = 0, r = distinct - 1;
+        while(l < r)
+        {
+            int m = (l + r) / 2;
+            if(wcscmp(search.queries[m].word, words[i]) < 0) l = m + 1;
+            else r = m;
+        }
+        for(struct word_node* node = search.queries[l].list->first; node != NULL; node = node->next)
+            word_list_add(&lists[i], node->word);
+    }
+    for(int i = 0; i < distinct; i++)
+    {
+        partial = partial || search.queries[i].full;
+        word_list_free(search.queries[i].list);
+        free(search.queries[i].rows);
+    }
+    free(search.queries);
+    free(search.prefix);
+    free(search.active);
+    return partial ? HINTS_PARTIAL : HINTS_COMPLETE;
+}
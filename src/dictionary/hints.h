@@ -0,0 +1,119 @@
+#ifndef HINTS_H_INCLUDED
+#define HINTS_H_INCLUDED
+
+/** @defgroup hints Module hints
+ * Generation of hints by a bounded edit-distance walk over the trie.
+ */
+/**
+ * @file hints.h Header file of module hints.
+ * @ingroup hints
+ * @author agent <agent@local>
+ * @date 2026-10
+ */
+
+#include <stddef.h>
+#include <wchar.h>
+#include "trie.h"
+#include "word_list.h"
+#include "edit_costs.h"
+
+#define HINTS_UNLIMITED 0 ///<Value of a limit in Hints_Options which switches the limit off.
+#define HINTS_DEFAULT_MAX_EDITS 1 ///<Default maximal edit distance of a hint from the word.
+
+#define HINTS_PARALLEL_MIN_LENGTH 24 ///<Minimal length of a word for which hints are generated by many threads.
+#define HINTS_PARALLEL_MIN_FANOUT 64 ///<Minimal number of first letters in trie for which hints are generated by many threads.
+
+#define HINTS_COMPLETE 0 ///<Value returned when every hint was generated.
+#define HINTS_PARTIAL 1 ///<Value returned when a limit was hit and generation stopped early.
+
+/**
+ * Limits of a single hints generation.
+ */
+typedef struct
+{
+    int max_edits; ///<Maximal number of edits (insert, remove, replace) between the word and a hint.
+    size_t max_results; ///<Maximal number of generated hints or HINTS_UNLIMITED.
+    size_t max_visited_nodes; ///<Maximal number of visited trie nodes or HINTS_UNLIMITED.
+    long time_budget_us; ///<Wall-clock time budget in microseconds or HINTS_UNLIMITED.
+    int threads; ///<Maximal number of threads generating hints, 1 for the calling thread only.
+} Hints_Options;
+
+/**
+ * @brief hints_default_options Fills options with defaults: one edit, no other limits, single thread.
+ * @param options Options to fill.
+ */
+void hints_default_options(Hints_Options* options);
+
+/**
+ * @brief hints_generate Adds to list every word of the trie within options->max_edits edits from word.
+ * @param root Root of the trie.
+ * @param word Lower-case, non-empty word.
+ * @param options Limits of the generation.
+ * @param list Initialized list, hints are appended to it.
+ * @return HINTS_COMPLETE or HINTS_PARTIAL, if any of the limits was hit.
+ * Hints are appended in trie order. Every hint appears at most once.
+ * <p>
+ * If options->threads > 1 and the word is long or the first level of the trie is wide,
+ * subtrees of the root are searched by many threads. The trie must not be modified meanwhile.
+ * Result does not depend on the number of threads, unless node or time budget is hit.
+ */
+int hints_generate(const Node* root, const wchar_t* word, const Hints_Options* options, Word_List* list);
+
+/**
+ * @brief hints_generate_top Adds to list at most k best hints of the word, the best first.
+ * @param root Root of the trie.
+ * @param word Lower-case, non-empty word.
+ * @param options Limits of the generation, max_results and threads are ignored.
+ * @param k Number of wanted hints.
+ * @param list Initialized list, hints are appended to it.
+ * @return HINTS_COMPLETE or HINTS_PARTIAL, if node or time budget was hit.
+ * Hints are ranked by frequency (descending), then by edit distance, then in trie order.
+ * Subtrees whose greatest frequency cannot beat the k-th best hint found so far are skipped.
+ */
+int hints_generate_top(const Node* root, const wchar_t* word, const Hints_Options* options,
+                       size_t k, Word_List* list);
+
+/**
+ * @brief hints_generate_weighted Adds to list at most k cheapest hints of the word, the cheapest first.
+ * @param root Root of the trie.
+ * @param word Lower-case, non-empty word.
+ * @param options Limits of the generation, max_results and threads are ignored.
+ * Cost of a hint is at most options->max_edits * EDIT_COSTS_UNIT.
+ * @param costs Costs of edits.
+ * @param k Number of wanted hints.
+ * @param list Initialized list, hints are appended to it.
+ * @return HINTS_COMPLETE or HINTS_PARTIAL, if node or time budget was hit.
+ * Nodes are expanded best-first, from the smallest lower bound of cost of hints in their subtrees,
+ * and the search stops as soon as this bound exceeds the cost of the k-th hint.
+ * Hints of equal cost are ranked by frequency (descending), then alphabetically.
+ */
+int hints_generate_weighted(const Node* root, const wchar_t* word, const Hints_Options* options,
+                            const Edit_Costs* costs, size_t k, Word_List* list);
+
+/**
+ * @brief hints_order_by_distance Orders words of the list from the closest to the word.
+ * @param word Lower-case word.
+ * @param list List of hints.
+ * Words are compared by Damerau distance, so a swap of two adjacent letters counts as one edit.
+ * Words at equal distance keep their order.
+ */
+void hints_order_by_distance(const wchar_t* word, Word_List* list);
+
+/**
+ * @brief hints_generate_batch Generates hints for many words in one walk over the trie.
+ * @param root Root of the trie.
+ * @param words Array of lower-case, non-empty words.
+ * @param count Number of words.
+ * @param options Limits of the generation. Node and time budgets are shared by the whole batch.
+ * @param lists Array of count initialized lists, hints of words[i] are appended to lists[i].
+ * @return HINTS_COMPLETE or HINTS_PARTIAL, if any of the limits was hit.
+ * Upper levels of the trie are visited once for all words instead of once per word.
+ * If options->threads > 1, words long enough for many threads are generated one by one
+ * by many threads, after the common walk and within the budgets it left. Once a budget is
+ * exhausted, remaining words get no hints. Unless a budget is hit, hints of every word are
+ * the same as from hints_generate().
+ */
+int hints_generate_batch(const Node* root, const wchar_t* const* words, size_t count,
+                         const Hints_Options* options, Word_List* lists);
+
+#endif // HINTS_H_INCLUDED
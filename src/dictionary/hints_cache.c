@@ -0,0 +1,246 @@
+/** @file
+    Implementation of hints cache.
+    @ingroup hints_cache
+    @author agent
+    @date 2026-10
+  */
+
+#include <stdlib.h>
+#include <wchar.h>
+#include <string.h>
+#include <assert.h>
+#include <stdbool.h>
+
+#include "hints_cache.h"
+#include "word_list.h"
+#include "error_handling.h"
+#include "fnv_hash.h"
+
+#ifdef HINTS_CACHE_UNIT_TESTING
+#include <stdarg.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#ifdef malloc
+#undef malloc
+#endif // malloc
+#define malloc(size) _test_malloc(size, __FILE__, __LINE__)
+
+#ifdef calloc
+#undef calloc
+#endif // calloc
+#define calloc(num, size) _test_calloc(num, size, __FILE__, __LINE__)
+
+#ifdef free
+#undef free
+#endif // free
+#define free(ptr) _test_free(ptr, __FILE__, __LINE__)
+
+#ifdef assert
+#undef assert
+#define assert(expression) mock_assert((int)(expression), #expression, __FILE__, __LINE__);
+#endif
+#endif // HINTS_CACHE_UNIT_TESTING
+
+Hints_Cache* hints_cache_new(size_t max_entries, size_t max_bytes)
+{
+    assert(max_entries > 0);
+
+    Hints_Cache* ret = malloc(sizeof(Hints_Cache));
+    if(ret == NULL) report_error(MEMORY);
+    memset(ret, 0, sizeof(Hints_Cache));
+    ret->max_entries = max_entries;
+    ret->max_bytes = max_bytes;
+    ret->bucket_count = 1;
+    while(ret->bucket_count < max_entries)
+        ret->bucket_count *= 2;
+    ret->buckets = calloc(ret->bucket_count, sizeof(Cache_Entry*));
+    if(ret->buckets == NULL) report_error(MEMORY);
+    pthread_mutex_init(&ret->lock, NULL);
+    return ret;
+}
+
+///Deallocates single entry.
+static void free_entry(Cache_Entry* entry)
+{
+    free(entry->word);
+    free(entry->hints);
+    free(entry);
+}
+
+///Removes all entries, the cache is locked.
+static void clear_entries(Hints_Cache* cache)
+{
+    Cache_Entry* entry = cache->newest;
+    while(entry != NULL)
+    {
+        Cache_Entry* older = entry->older;
+        free_entry(entry);
+        entry = older;
+    }
+    memset(cache->buckets, 0, sizeof(Cache_Entry*) * cache->bucket_count);
+    cache->newest = NULL;
+    cache->oldest = NULL;
+    cache->entry_count = 0;
+    cache->bytes = 0;
+}
+
+void hints_cache_clear(Hints_Cache* cache)
+{
+    assert(cache != NULL);
+    pthread_mutex_lock(&cache->lock);
+    clear_entries(cache);
+    pthread_mutex_unlock(&cache->lock);
+}
+
+void hints_cache_free(Hints_Cache* cache)
+{
+    assert(cache != NULL);
+    clear_entries(cache);
+    pthread_mutex_destroy(&cache->lock);
+    free(cache->buckets);
+    free(cache);
+}
+
+///Removes entry from the recently-used list.
+static void unlink_recent(Hints_Cache* cache, Cache_Entry* entry)
+{
+    if(entry->newer != NULL) entry->newer->older = entry->older;
+    else cache->newest = entry->older;
+    if(entry->older != NULL) entry->older->newer = entry->newer;
+    else cache->oldest = entry->newer;
+}
+
+///Puts entry at the front of the recently-used list.
+static void link_newest(Hints_Cache* cache, Cache_Entry* entry)
+{
+    entry->newer = NULL;
+    entry->older = cache->newest;
+    if(cache->newest != NULL) cache->newest->newer = entry;
+    cache->newest = entry;
+    if(cache->oldest == NULL) cache->oldest = entry;
+}
+
+///Removes and deallocates entry.
+static void remove_entry(Hints_Cache* cache, Cache_Entry* entry)
+{
+    Cache_Entry** link = &cache->buckets[entry->hash & (cache->bucket_count - 1)];
+    while(*link != entry)
+        link = &(*link)->bucket_next;
+    *link = entry->bucket_next;
+    unlink_recent(cache, entry);
+    cache->entry_count--;
+    cache->bytes -= entry->bytes;
+    free_entry(entry);
+}
+
+///Drops all entries if they come from another generation of the dictionary.
+static void check_generation(Hints_Cache* cache, unsigned long generation)
+{
+    if(cache->generation == generation)
+        return;
+    clear_entries(cache);
+    cache->generation = generation;
+}
+
+///Finds entry of the word or returns NULL.
+static Cache_Entry* find_entry(Hints_Cache* cache, const wchar_t* word, unsigned long hash)
+{
+    Cache_Entry* entry = cache->buckets[hash & (cache->bucket_count - 1)];
+    while(entry != NULL && (entry->hash != hash || wcscmp(entry->word, word) != 0))
+        entry = entry->bucket_next;
+    return entry;
+}
+
+bool hints_cache_get(Hints_Cache* cache, const wchar_t* word, int max_edits, size_t max_results,
+                     int kind, unsigned long generation, Word_List* list)
+{
+    assert(cache != NULL);
+    assert(word != NULL);
+    assert(list != NULL);
+
+    pthread_mutex_lock(&cache->lock);
+    check_generation(cache, generation);
+    Cache_Entry* entry = find_entry(cache, word, fnv_hash_word(word));
+    if(entry == NULL || entry->max_edits != max_edits || entry->max_results != max_results
+       || entry->kind != kind)
+    {
+        cache->misses++;
+        pthread_mutex_unlock(&cache->lock);
+        return false;
+    }
+
+    cache->hits++;
+    unlink_recent(cache, entry);
+    link_newest(cache, entry);
+    const wchar_t* hint = entry->hints;
+    for(size_t i = 0; i < entry->hint_count; i++)
+    {
+        word_list_add(list, hint);
+        hint += wcslen(hint) + 1;
+    }
+    pthread_mutex_unlock(&cache->lock);
+    return true;
+}
+
+void hints_cache_put(Hints_Cache* cache, const wchar_t* word, int max_edits, size_t max_results,
+                     int kind, unsigned long generation, const Word_List* hints)
+{
+    assert(cache != NULL);
+    assert(word != NULL);
+    assert(hints != NULL);
+
+    size_t word_len = wcslen(word) + 1;
+    size_t hints_len = 0;
+    for(struct word_node* node = hints->first; node != NULL; node = node->next)
+        hints_len += wcslen(node->word) + 1;
+    size_t bytes = sizeof(Cache_Entry) + sizeof(wchar_t) * (word_len + hints_len);
+    if(bytes > cache->max_bytes)
+        return; //would evict everything and still not fit
+
+    pthread_mutex_lock(&cache->lock);
+    check_generation(cache, generation);
+    unsigned long hash = fnv_hash_word(word);
+    Cache_Entry* old = find_entry(cache, word, hash);
+    if(old != NULL)
+        remove_entry(cache, old);
+    while(cache->entry_count >= cache->max_entries || cache->bytes + bytes > cache->max_bytes)
+        remove_entry(cache, cache->oldest);
+
+    Cache_Entry* entry = malloc(sizeof(Cache_Entry));
+    if(entry == NULL) report_error(MEMORY);
+    entry->word = malloc(sizeof(wchar_t) * word_len);
+    if(entry->word == NULL) report_error(MEMORY);
+    memcpy(entry->word, word, sizeof(wchar_t) * word_len);
+    entry->hints = malloc(sizeof(wchar_t) * (hints_len > 0 ? hints_len : 1));
+    if(entry->hints == NULL) report_error(MEMORY);
+    wchar_t* position = entry->hints;
+    for(struct word_node* node = hints->first; node != NULL; node = node->next)
+    {
+        size_t len = wcslen(node->word) + 1;
+        memcpy(position, node->word, sizeof(wchar_t) * len);
+        position += len;
+    }
+    entry->hint_count = word_list_size(hints);
+    entry->max_edits = max_edits;
+    entry->max_results = max_results;
+    entry->kind = kind;
+    entry->bytes = bytes;
+    entry->hash = hash;
+
+    Cache_Entry** bucket = &cache->buckets[hash & (cache->bucket_count - 1)];
+    entry->bucket_next = *bucket;
+    *bucket = entry;
+    link_newest(cache, entry);
+    cache->entry_count++;
+    cache->bytes += bytes;
+    pthread_mutex_unlock(&cache->lock);
+}
+
+void hints_cache_stats(Hints_Cache* cache, size_t* hits, size_t* misses)
+{
+    assert(cache != NULL);
+    pthread_mutex_lock(&cache->lock);
+    *hits = cache->hits;
+    *misses = cache->misses;
+    pthread_mutex_unlock(&cache->lock);
+}
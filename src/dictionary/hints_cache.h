@@ -0,0 +1,121 @@
+#ifndef HINTS_CACHE_H_INCLUDED
+#define HINTS_CACHE_H_INCLUDED
+
+/** @defgroup hints_cache Module hints_cache
+ * Bounded cache of generated hints.
+ */
+/**
+ * @file hints_cache.h Header file of module hints_cache.
+ * @ingroup hints_cache
+ * @author agent <agent@local>
+ * @date 2026-10
+ */
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <wchar.h>
+#include "word_list.h"
+
+#define HINTS_CACHE_DEFAULT_ENTRIES 1024 ///<Default maximal number of words with cached hints.
+#define HINTS_CACHE_DEFAULT_BYTES (1 << 20) ///<Default maximal memory used by cached hints.
+
+#define HINTS_CACHE_PLAIN 0 ///<Kind of cached hints: every hint, see hints_generate().
+#define HINTS_CACHE_TOP 1 ///<Kind of cached hints: the most frequent hints, see hints_generate_top().
+#define HINTS_CACHE_WEIGHTED 2 ///<Kind of cached hints: the cheapest hints, see hints_generate_weighted().
+
+/**
+ * Single cached result of hints generation.
+ */
+typedef struct Cache_Entry
+{
+    wchar_t* word; ///<Word for which hints were generated.
+    int max_edits; ///<Hints_Options::max_edits used to generate hints.
+    size_t max_results; ///<Hints_Options::max_results used to generate hints, or k of the best hints.
+    int kind; ///<Kind of hints, HINTS_CACHE_PLAIN, HINTS_CACHE_TOP or HINTS_CACHE_WEIGHTED.
+    wchar_t* hints; ///<Hints separated and ended by L'\0'.
+    size_t hint_count; ///<Number of hints.
+    size_t bytes; ///<Memory used by the entry.
+    unsigned long hash; ///<Hash of the word.
+    struct Cache_Entry* bucket_next; ///<Next entry in the same bucket.
+    struct Cache_Entry* newer; ///<Entry used more recently, NULL for the most recent one.
+    struct Cache_Entry* older; ///<Entry used less recently, NULL for the least recent one.
+} Cache_Entry;
+
+/**
+ * Hash table of cached hints with least-recently-used eviction.
+ * All entries are valid for one generation of the dictionary only.
+ * Every function locks the cache, so concurrent queries of a dictionary may share it.
+ */
+typedef struct
+{
+    Cache_Entry** buckets; ///<Buckets of the hash table.
+    size_t bucket_count; ///<Number of buckets, power of two.
+    Cache_Entry* newest; ///<Most recently used entry.
+    Cache_Entry* oldest; ///<Least recently used entry.
+    size_t entry_count; ///<Number of cached entries.
+    size_t max_entries; ///<Maximal number of cached entries.
+    size_t bytes; ///<Memory used by cached entries.
+    size_t max_bytes; ///<Maximal memory used by cached entries.
+    unsigned long generation; ///<Generation of the dictionary of cached entries.
+    size_t hits; ///<Number of successful lookups.
+    size_t misses; ///<Number of failed lookups.
+    pthread_mutex_t lock; ///<Guards all other fields and the entries.
+} Hints_Cache;
+
+/**
+ * @brief hints_cache_new Creates an empty cache.
+ * @param max_entries Maximal number of cached words, must be positive.
+ * @param max_bytes Maximal memory used by cached hints.
+ * @return Pointer to the new cache.
+ */
+Hints_Cache* hints_cache_new(size_t max_entries, size_t max_bytes);
+
+/**
+ * @brief hints_cache_free Deallocates the cache with all entries.
+ * @param cache The cache.
+ */
+void hints_cache_free(Hints_Cache* cache);
+
+/**
+ * @brief hints_cache_clear Removes all entries, counters are kept.
+ * @param cache The cache.
+ */
+void hints_cache_clear(Hints_Cache* cache);
+
+/**
+ * @brief hints_cache_get Looks for cached hints and appends them to list.
+ * @param cache The cache.
+ * @param word Lower-case word.
+ * @param max_edits Hints_Options::max_edits of the lookup.
+ * @param max_results Hints_Options::max_results of the lookup, or k of the best hints.
+ * @param kind Kind of hints looked for, HINTS_CACHE_PLAIN, HINTS_CACHE_TOP or HINTS_CACHE_WEIGHTED.
+ * @param generation Current generation of the dictionary. Older entries are dropped.
+ * @param list List where cached hints are appended.
+ * @return True if hints were found in cache.
+ */
+bool hints_cache_get(Hints_Cache* cache, const wchar_t* word, int max_edits, size_t max_results,
+                     int kind, unsigned long generation, Word_List* list);
+
+/**
+ * @brief hints_cache_put Stores hints of the word, evicting least recently used entries if needed.
+ * @param cache The cache.
+ * @param word Lower-case word.
+ * @param max_edits Hints_Options::max_edits used to generate hints.
+ * @param max_results Hints_Options::max_results used to generate hints, or k of the best hints.
+ * @param kind Kind of hints, HINTS_CACHE_PLAIN, HINTS_CACHE_TOP or HINTS_CACHE_WEIGHTED.
+ * @param generation Generation of the dictionary hints were generated from.
+ * @param hints Complete list of hints.
+ */
+void hints_cache_put(Hints_Cache* cache, const wchar_t* word, int max_edits, size_t max_results,
+                     int kind, unsigned long generation, const Word_List* hints);
+
+/**
+ * @brief hints_cache_stats Reads counters of lookups.
+ * @param cache The cache.
+ * @param hits Pointer to store the number of successful lookups.
+ * @param misses Pointer to store the number of failed lookups.
+ */
+void hints_cache_stats(Hints_Cache* cache, size_t* hits, size_t* misses);
+
+#endif // HINTS_CACHE_H_INCLUDED
@@ -0,0 +1,147 @@
+/** @file
+  Tests of hints generated by many threads.
+  Modules are built without cmocka allocator, which is not safe for threads.
+  @ingroup hints
+  @author agent <agent@local>
+  @date 2026-10
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <cmocka.h>
+#include <wchar.h>
+#include "hints.h"
+#include "trie.h"
+#include "word_list.h"
+
+#define LONG_WORD L"konstantynopolitanczykowianeczka" ///<Word long enough for many threads.
+
+///Inserts words to a new trie.
+static Node* new_trie(const wchar_t* const* words, int count)
+{
+    Node* root = trie_new_node();
+    for(int i = 0; i < count; i++)
+        trie_insert_word(root, words[i]);
+    return root;
+}
+
+///Checks that lists hold the same words in the same order.
+static void assert_same_lists(const Word_List* a, const Word_List* b)
+{
+    assert_int_equal(word_list_size(a), word_list_size(b));
+    for(struct word_node *x = a->first, *y = b->first; x != NULL; x = x->next, y = y->next)
+        assert_true(wcscmp(x->word, y->word) == 0);
+}
+
+///Long word is split among threads, hints are the same as from one thread.
+static void test_long_word(void** state)
+{
+    const wchar_t* words[] = {L"konstantynopolitanczykowianeczka", L"konstantynopolitanczykowianeczki",
+                              L"konstantynopolitanczykowianeczek", L"onstantynopolitanczykowianeczka",
+                              L"kkonstantynopolitanczykowianeczka", L"zonstantynopolitanczykowianeczka",
+                              L"konstantynopolitanczykowianeczkaa", L"kot", L"pies"};
+    Node* root = new_trie(words, sizeof(words)/sizeof(wchar_t*));
+
+    Hints_Options options;
+    hints_default_options(&options);
+    Word_List* single = word_list_new();
+    Word_List* multi = word_list_new();
+    assert_int_equal(hints_generate(root, LONG_WORD, &options, single), HINTS_COMPLETE);
+    options.threads = 4;
+    assert_int_equal(hints_generate(root, LONG_WORD, &options, multi), HINTS_COMPLETE);
+    assert_int_equal(word_list_size(single), 6);
+    assert_same_lists(single, multi);
+    word_list_done(multi);
+
+    //the first hints in trie order are kept
+    options.max_results = 3;
+    assert_int_equal(hints_generate(root, LONG_WORD, &options, multi), HINTS_PARTIAL);
+    assert_int_equal(word_list_size(multi), 3);
+    struct word_node* a = single->first;
+    for(struct word_node* b = multi->first; b != NULL; a = a->next, b = b->next)
+        assert_true(wcscmp(a->word, b->word) == 0);
+
+    word_list_free(single);
+    word_list_free(multi);
+    trie_free_node(root);
+}
+
+///Short word in a trie with wide first level is split among threads too.
+static void test_wide_trie(void** state)
+{
+    Node* root = trie_new_node();
+    wchar_t word[] = L"?ot";
+    for(int i = 0; i < 2 * HINTS_PARALLEL_MIN_FANOUT; i++)
+    {
+        word[0] = L'a' + i;
+        trie_insert_word(root, word);
+    }
+
+    Hints_Options options;
+    hints_default_options(&options);
+    Word_List* single = word_list_new();
+    Word_List* multi = word_list_new();
+    assert_int_equal(hints_generate(root, L"kot", &options, single), HINTS_COMPLETE);
+    options.threads = 4;
+    assert_int_equal(hints_generate(root, L"kot", &options, multi), HINTS_COMPLETE);
+    assert_int_equal(word_list_size(single), 2 * HINTS_PARALLEL_MIN_FANOUT);
+    assert_same_lists(single, multi);
+
+    word_list_free(single);
+    word_list_free(multi);
+    trie_free_node(root);
+}
+
+///Long words of a batch are generated alone, within budgets shared by the batch.
+static void test_batch(void** state)
+{
+    const wchar_t* words[] = {L"konstantynopolitanczykowianeczka", L"konstantynopolitanczykowianeczki",
+                              L"onstantynopolitanczykowianeczka", L"kot", L"kat", L"pies"};
+    Node* root = new_trie(words, sizeof(words)/sizeof(wchar_t*));
+    const wchar_t* queries[] = {LONG_WORD, L"kit", L"konstantynopolitanczykowianeczko", L"pies"};
+    int count = sizeof(queries)/sizeof(wchar_t*);
+
+    Hints_Options options;
+    hints_default_options(&options);
+    Word_List lists[count];
+    for(int i = 0; i < count; i++)
+        word_list_init(&lists[i]);
+    options.threads = 4;
+    assert_int_equal(hints_generate_batch(root, queries, count, &options, lists), HINTS_COMPLETE);
+    options.threads = 1;
+    for(int i = 0; i < count; i++)
+    {
+        Word_List* single = word_list_new();
+        assert_int_equal(hints_generate(root, queries[i], &options, single), HINTS_COMPLETE);
+        assert_same_lists(single, &lists[i]);
+        word_list_free(single);
+        word_list_done(&lists[i]);
+    }
+
+    //the first long word spends the budget, the other one is skipped
+    const wchar_t* long_queries[] = {LONG_WORD, L"konstantynopolitanczykowianeczko"};
+    options.threads = 4;
+    options.max_visited_nodes = 1;
+    assert_int_equal(hints_generate_batch(root, long_queries, 2, &options, lists), HINTS_PARTIAL);
+    assert_int_equal(word_list_size(&lists[0]), 0);
+    assert_int_equal(word_list_size(&lists[1]), 0);
+    word_list_done(&lists[0]);
+    word_list_done(&lists[1]);
+
+    trie_free_node(root);
+}
+
+///Just to document this function.
+int main(void)
+{
+    const struct CMUnitTest tests[] =
+    {
+        cmocka_unit_test(test_long_word),
+        cmocka_unit_test(test_wide_trie),
+        cmocka_unit_test(test_batch)
+    };
+    return cmocka_run_group_tests_name("Hints threads tests", tests, NULL, NULL);
+}
@@ -0,0 +1,309 @@
+/** @file
+    Implementation of secondary index of words by key.
+    @ingroup key_index
+    @author agent
+    @date 2026-10
+  */
+
+#include <stdlib.h>
+#include <string.h>
+#include <wchar.h>
+#include <assert.h>
+#include <stdbool.h>
+
+#include "key_index.h"
+#include "error_handling.h"
+
+#ifdef KEY_INDEX_UNIT_TESTING
+#include <stdarg.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#ifdef malloc
+#undef malloc
+#endif // malloc
+#define malloc(size) _test_malloc(size, __FILE__, __LINE__)
+
+#ifdef realloc
+#undef realloc
+#endif // realloc
+#define realloc(ptr, size) _test_realloc(ptr, size, __FILE__, __LINE__)
+
+#ifdef free
+#undef free
+#endif // free
+#define free(ptr) _test_free(ptr, __FILE__, __LINE__)
+
+#ifdef assert
+#undef assert
+#define assert(expression) mock_assert((int)(expression), #expression, __FILE__, __LINE__);
+#endif
+#endif // KEY_INDEX_UNIT_TESTING
+
+///Compares entries by key and then by word.
+static int cmp_entry(const void* a, const void* b)
+{
+    const Key_Entry* x = a;
+    const Key_Entry* y = b;
+    int ret = wcscmp(x->key, y->key);
+    return ret != 0 ? ret : wcscmp(x->word, y->word);
+}
+
+/**
+ * @brief pool_copy Copies the string into the pool of the index.
+ * @param index The index.
+ * @param str The string.
+ * @return Copy of the string, valid until the index is freed.
+ */
+static const wchar_t* pool_copy(Key_Index* index, const wchar_t* str)
+{
+    size_t len = wcslen(str) + 1;
+    if(index->pool == NULL || index->pool->size - index->pool->used < len)
+    {
+        size_t size = len > KEY_INDEX_POOL_BLOCK ? len : KEY_INDEX_POOL_BLOCK;
+        Key_Pool_Block* block = malloc(sizeof(Key_Pool_Block) + sizeof(wchar_t) * size);
+        if(block == NULL) report_error(MEMORY);
+        block->next = index->pool;
+        block->size = size;
+        block->used = 0;
+        index->pool = block;
+    }
+    wchar_t* ret = index->pool->letters + index->pool->used;
+    memcpy(ret, str, sizeof(wchar_t) * len);
+    index->pool->used += len;
+    return ret;
+}
+
+/**
+ * @brief lower_bound Finds the first entry not smaller than the given one.
+ * @param index The index.
+ * @param entry The entry.
+ * @return Position of the entry, entry_count if all are smaller.
+ */
+static size_t lower_bound(const Key_Index* index, const Key_Entry* entry)
+{
+    size_t begin = 0;
+    size_t end = index->entry_count;
+    while(begin < end)
+    {
+        size_t middle = begin + (end - begin) / 2;
+        if(cmp_entry(&index->entries[middle], entry) < 0)
+            begin = middle + 1;
+        else
+            end = middle;
+    }
+    return begin;
+}
+
+/**
+ * @brief append_entry Adds the entry at the end of the array, without keeping it sorted.
+ * @param index The index.
+ * @param key Key of the word.
+ * @param word The word.
+ */
+static void append_entry(Key_Index* index, const wchar_t* key, const wchar_t* word)
+{
+    if(index->entry_count == index->array_size)
+    {
+        index->array_size *= 2;
+        index->entries = realloc(index->entries, sizeof(Key_Entry) * index->array_size);
+        if(index->entries == NULL) report_error(MEMORY);
+    }
+    index->entries[index->entry_count].key = pool_copy(index, key);
+    index->entries[index->entry_count].word = pool_copy(index, word);
+    index->entry_count++;
+}
+
+Key_Index* key_index_new(Key_Function key_function, const void* key_data)
+{
+    assert(key_function != NULL);
+
+    Key_Index* ret = malloc(sizeof(Key_Index));
+    if(ret == NULL) report_error(MEMORY);
+    ret->key_function = key_function;
+    ret->key_data = key_data;
+    ret->entry_count = 0;
+    ret->array_size = KEY_INDEX_START_SIZE;
+    ret->entries = malloc(sizeof(Key_Entry) * ret->array_size);
+    if(ret->entries == NULL) report_error(MEMORY);
+    ret->pool = NULL;
+    return ret;
+}
+
+///Callback of trie_for_each_word() adding the word to the index.
+static void build_visit(const wchar_t* word, const Node* node, void* data)
+{
+    (void) node;
+    Key_Index* index = data;
+    wchar_t* key = index->key_function(word, index->key_data);
+    append_entry(index, key, word);
+    free(key);
+}
+
+Key_Index* key_index_build(const Node* root, Key_Function key_function, const void* key_data)
+{
+    assert(root != NULL);
+
+    Key_Index* ret = key_index_new(key_function, key_data);
+    trie_for_each_word(root, build_visit, ret);
+    qsort(ret->entries, ret->entry_count, sizeof(Key_Entry), cmp_entry);
+    return ret;
+}
+
+void key_index_free(Key_Index* index)
+{
+    assert(index != NULL);
+
+    while(index->pool != NULL)
+    {
+        Key_Pool_Block* next = index->pool->next;
+        free(index->pool);
+        index->pool = next;
+    }
+    free(index->entries);
+    free(index);
+}
+
+int key_index_add(Key_Index* index, const wchar_t* word)
+{
+    assert(index != NULL);
+    assert(word != NULL);
+
+    wchar_t* key = index->key_function(word, index->key_data);
+    Key_Entry entry = {key, word};
+    size_t position = lower_bound(index, &entry);
+    if(position < index->entry_count && cmp_entry(&index->entries[position], &entry) == 0)
+    {
+        free(key);
+        return 0;
+    }
+    append_entry(index, key, word);
+    free(key);
+    entry = index->entries[index->entry_count - 1];
+    memmove(index->entries + position + 1, index->entries + position,
+            sizeof(Key_Entry) * (index->entry_count - 1 - position));
+    index->entries[position] = entry;
+    return 1;
+}
+
+int key_index_remove(Key_Index* index, const wchar_t* word)
+{
+    assert(index != NULL);
+    assert(word != NULL);
+
+    wchar_t* key = index->key_function(word, index->key_data);
+    Key_Entry entry = {key, word};
+    size_t position = lower_bound(index, &entry);
+    int ret = 0;
+    if(position < index->entry_count && cmp_entry(&index->entries[position], &entry) == 0)
+    {
+        index->entry_count--;
+        memmove(index->entries + position, index->entries + position + 1,
+                sizeof(Key_Entry) * (index->entry_count - position));
+        ret = 1;
+    }
+    free(key);
+    return ret;
+}
+
+size_t key_index_find(const Key_Index* index, const wchar_t* key, Word_List* list)
+{
+    assert(index != NULL);
+    assert(key != NULL);
+    assert(list != NULL);
+
+    Key_Entry entry = {key, L""};
+    size_t ret = 0;
+    for(size_t i = lower_bound(index, &entry);
+        i < index->entry_count && wcscmp(index->entries[i].key, key) == 0; i++)
+    {
+        word_list_add(list, index->entries[i].word);
+        ret++;
+    }
+    return ret;
+}
+
+size_t key_index_find_like(const Key_Index* index, const wchar_t* word, Word_List* list)
+{
+    assert(index != NULL);
+    assert(word != NULL);
+
+    wchar_t* key = index->key_function(word, index->key_data);
+    size_t ret = key_index_find(index, key, list);
+    free(key);
+    return ret;
+}
+
+void key_index_save(const Key_Index* index, FILE* file)
+{
+    assert(index != NULL);
+    assert(file != NULL);
+
+    for(size_t i = 0; i < index->entry_count; i++)
+    {
+        fputws(index->entries[i].key, file);
+        fputwc(KEY_INDEX_SEPARATOR, file);
+        fputws(index->entries[i].word, file);
+        fputwc(KEY_INDEX_END_OF_ENTRY, file);
+    }
+}
+
+/**
+ * @brief read_field Reads letters up to the given one.
+ * @param file File to read from.
+ * @param end Letter ending the field, not stored.
+ * @param buffer Pointer to buffer, grown if needed.
+ * @param buffer_size Pointer to size of the buffer.
+ * @return Length of the field or -1 if file ended before the end letter.
+ */
+static long read_field(FILE* file, wchar_t end, wchar_t** buffer, size_t* buffer_size)
+{
+    size_t len = 0;
+    wint_t sign;
+    while((sign = fgetwc(file)) != (wint_t) end)
+    {
+        if(sign == WEOF || sign == KEY_INDEX_SEPARATOR || sign == KEY_INDEX_END_OF_ENTRY)
+            return -1;
+        if(len + 1 >= *buffer_size)
+        {
+            *buffer_size *= 2;
+            *buffer = realloc(*buffer, sizeof(wchar_t) * (*buffer_size));
+            if(*buffer == NULL) report_error(MEMORY);
+        }
+        (*buffer)[len++] = sign;
+    }
+    (*buffer)[len] = L'\0';
+    return len;
+}
+
+Key_Index* key_index_load(FILE* file, Key_Function key_function, const void* key_data)
+{
+    assert(file != NULL);
+
+    Key_Index* ret = key_index_new(key_function, key_data);
+    size_t key_size = KEY_INDEX_START_SIZE;
+    size_t word_size = KEY_INDEX_START_SIZE;
+    wchar_t* key = malloc(sizeof(wchar_t) * key_size);
+    wchar_t* word = malloc(sizeof(wchar_t) * word_size);
+    if(key == NULL || word == NULL) report_error(MEMORY);
+
+    bool correct = true;
+    wint_t sign;
+    while(correct && (sign = fgetwc(file)) != WEOF)
+    {
+        ungetwc(sign, file);
+        correct = read_field(file, KEY_INDEX_SEPARATOR, &key, &key_size) >= 0
+                  && read_field(file, KEY_INDEX_END_OF_ENTRY, &word, &word_size) > 0;
+        if(correct)
+            append_entry(ret, key, word);
+        if(correct && ret->entry_count > 1) //saved index is sorted and has no duplicates
+            correct = cmp_entry(&ret->entries[ret->entry_count - 2], &ret->entries[ret->entry_count - 1]) < 0;
+    }
+    free(key);
+    free(word);
+    if(!correct)
+    {
+        key_index_free(ret);
+        return NULL;
+    }
+    return ret;
+}
@@ -0,0 +1,143 @@
+#ifndef KEY_INDEX_H_INCLUDED
+#define KEY_INDEX_H_INCLUDED
+
+/** @defgroup key_index Module key_index
+ * Secondary index of words of a trie by a key computed from the word.
+ */
+/**
+ * @file key_index.h Header file of module key_index.
+ * @ingroup key_index
+ * @author agent <agent@local>
+ * @date 2026-10
+ */
+
+#include <stdio.h>
+#include <stddef.h>
+#include <wchar.h>
+#include "trie.h"
+#include "word_list.h"
+
+#define KEY_INDEX_START_SIZE 64 ///<Start size of the array of entries. Must be positive.
+#define KEY_INDEX_POOL_BLOCK 16384 ///<Number of letters in a block of the string pool.
+#define KEY_INDEX_SEPARATOR L'\t' ///<Value used to label in file the end of the key of an entry.
+#define KEY_INDEX_END_OF_ENTRY L'\n' ///<Value used to label in file the end of an entry.
+
+/**
+ * Function computing the key of a word.
+ * First parameter is the word, second is the data given to the index.
+ * Returns new string, freed by the index.
+ */
+typedef wchar_t* (*Key_Function)(const wchar_t*, const void*);
+
+/**
+ * Block of memory keeping keys and words of the index.
+ * Blocks are never moved, so entries may point into them.
+ */
+typedef struct Key_Pool_Block
+{
+    struct Key_Pool_Block* next; ///<Previously allocated block.
+    size_t size; ///<Number of letters the block can keep.
+    size_t used; ///<Number of letters already used.
+    wchar_t letters[]; ///<The letters.
+} Key_Pool_Block;
+
+/**
+ * Single word of the index with its key.
+ */
+typedef struct
+{
+    const wchar_t* key; ///<Key of the word, in the pool.
+    const wchar_t* word; ///<The word, in the pool.
+} Key_Entry;
+
+/**
+ * Words sorted by key and then by the word itself.
+ * <p>
+ * All words with given key are found by one binary search. Removed entries leave
+ * their strings in the pool until the index is built again.
+ */
+typedef struct
+{
+    Key_Function key_function; ///<Function computing keys.
+    const void* key_data; ///<Second parameter of key_function.
+    Key_Entry* entries; ///<Sorted entries.
+    size_t entry_count; ///<Number of entries.
+    size_t array_size; ///<Size of the array of entries.
+    Key_Pool_Block* pool; ///<Last allocated block of strings.
+} Key_Index;
+
+/**
+ * @brief key_index_new Creates an empty index.
+ * @param key_function Function computing keys.
+ * @param key_data Passed to key_function, must live as long as the index.
+ * @return Pointer to the new index.
+ */
+Key_Index* key_index_new(Key_Function key_function, const void* key_data);
+
+/**
+ * @brief key_index_build Creates the index of all words of the trie.
+ * @param root Root of the trie.
+ * @param key_function Function computing keys.
+ * @param key_data Passed to key_function, must live as long as the index.
+ * @return Pointer to the new index.
+ */
+Key_Index* key_index_build(const Node* root, Key_Function key_function, const void* key_data);
+
+/**
+ * @brief key_index_free Deallocates the index.
+ * @param index The index.
+ */
+void key_index_free(Key_Index* index);
+
+/**
+ * @brief key_index_add Adds the word to the index.
+ * @param index The index.
+ * @param word The word.
+ * @return 1 if word was added, 0 if it was already present.
+ */
+int key_index_add(Key_Index* index, const wchar_t* word);
+
+/**
+ * @brief key_index_remove Removes the word from the index.
+ * @param index The index.
+ * @param word The word.
+ * @return 1 if word was removed, 0 if it was not present.
+ */
+int key_index_remove(Key_Index* index, const wchar_t* word);
+
+/**
+ * @brief key_index_find Finds words with the key.
+ * @param index The index.
+ * @param key The key.
+ * @param list List where words are added, in alphabetical order.
+ * @return Number of added words.
+ */
+size_t key_index_find(const Key_Index* index, const wchar_t* key, Word_List* list);
+
+/**
+ * @brief key_index_find_like Finds words with the same key as the word.
+ * @param index The index.
+ * @param word The word, not necessarily in the index.
+ * @param list List where words are added, in alphabetical order.
+ * @return Number of added words.
+ */
+size_t key_index_find_like(const Key_Index* index, const wchar_t* word, Word_List* list);
+
+/**
+ * @brief key_index_save Saves the index.
+ * @param index The index.
+ * @param file File to save in.
+ * Every entry is written as the key, KEY_INDEX_SEPARATOR, the word and KEY_INDEX_END_OF_ENTRY.
+ */
+void key_index_save(const Key_Index* index, FILE* file);
+
+/**
+ * @brief key_index_load Loads index saved by key_index_save().
+ * @param file File to load from.
+ * @param key_function Function computing keys, the same as of the saved index.
+ * @param key_data Passed to key_function, must live as long as the index.
+ * @return Pointer to the loaded index or NULL if file is malformed.
+ */
+Key_Index* key_index_load(FILE* file, Key_Function key_function, const void* key_data);
+
+#endif // KEY_INDEX_H_INCLUDED
@@ -0,0 +1,321 @@
+/** @file
+    Implementation of wildcard patterns.
+    @ingroup pattern
+    @author agent
+    @date 2026-10
+  */
+
+#include <stdlib.h>
+#include <string.h>
+#include <wchar.h>
+#include <assert.h>
+#include <stdbool.h>
+
+#include "pattern.h"
+#include "error_handling.h"
+
+#ifdef PATTERN_UNIT_TESTING
+#include <stdarg.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#ifdef malloc
+#undef malloc
+#endif // malloc
+#define malloc(size) _test_malloc(size, __FILE__, __LINE__)
+
+#ifdef calloc
+#undef calloc
+#endif // calloc
+#define calloc(num, size) _test_calloc(num, size, __FILE__, __LINE__)
+
+#ifdef realloc
+#undef realloc
+#endif // realloc
+#define realloc(ptr, size) _test_realloc(ptr, size, __FILE__, __LINE__)
+
+#ifdef free
+#undef free
+#endif // free
+#define free(ptr) _test_free(ptr, __FILE__, __LINE__)
+
+#ifdef assert
+#undef assert
+#define assert(expression) mock_assert((int)(expression), #expression, __FILE__, __LINE__);
+#endif
+#endif // PATTERN_UNIT_TESTING
+
+/**
+ * @brief parse_class Compiles a class of letters.
+ * @param text The pattern, just after PATTERN_CLASS_BEGIN.
+ * @param element Element to fill.
+ * @return Pointer just after PATTERN_CLASS_END or NULL if the class is malformed.
+ * PATTERN_CLASS_END placed first is an ordinary letter of the class.
+ */
+static const wchar_t* parse_class(const wchar_t* text, Pattern_Element* element)
+{
+    element->kind = PATTERN_CLASS;
+    element->negated = (*text == PATTERN_CLASS_NEGATION);
+    if(element->negated)
+        text++;
+    element->ranges = malloc(sizeof(wchar_t) * 2 * (wcslen(text) + 1));
+    if(element->ranges == NULL) report_error(MEMORY);
+    element->range_count = 0;
+
+    for(bool first = true; first || *text != PATTERN_CLASS_END; first = false)
+    {
+        wchar_t low = *text++;
+        if(low == PATTERN_ESCAPE)
+            low = *text++;
+        if(low == L'\0')
+            return NULL;
+        wchar_t high = low;
+        if(text[0] == PATTERN_CLASS_RANGE && text[1] != PATTERN_CLASS_END && text[1] != L'\0')
+        {
+            text++;
+            high = *text++;
+            if(high == PATTERN_ESCAPE)
+                high = *text++;
+            if(high == L'\0' || high < low)
+                return NULL;
+        }
+        element->ranges[2 * element->range_count] = low;
+        element->ranges[2 * element->range_count + 1] = high;
+        element->range_count++;
+    }
+    return text + 1;
+}
+
+Pattern* pattern_new(const wchar_t* text)
+{
+    assert(text != NULL);
+
+    size_t text_len = wcslen(text);
+    Pattern* ret = malloc(sizeof(Pattern));
+    if(ret == NULL) report_error(MEMORY);
+    ret->elements = calloc(text_len + 1, sizeof(Pattern_Element));
+    ret->min_rest = malloc(sizeof(size_t) * (text_len + 1));
+    ret->bounded_rest = malloc(sizeof(bool) * (text_len + 1));
+    if(ret->elements == NULL || ret->min_rest == NULL || ret->bounded_rest == NULL) report_error(MEMORY);
+    ret->length = 0;
+
+    while(*text != L'\0')
+    {
+        Pattern_Element* element = &ret->elements[ret->length++];
+        switch(*text)
+        {
+        case PATTERN_ANY_LETTER:
+            element->kind = PATTERN_ANY;
+            text++;
+            break;
+        case PATTERN_ANY_SEQUENCE:
+            element->kind = PATTERN_STAR;
+            text++;
+            if(ret->length > 1 && element[-1].kind == PATTERN_STAR) //** is the same as *
+                ret->length--;
+            break;
+        case PATTERN_CLASS_BEGIN:
+            text = parse_class(text + 1, element);
+            if(text == NULL)
+            {
+                pattern_free(ret);
+                return NULL;
+            }
+            break;
+        case PATTERN_ESCAPE:
+            text++;
+            if(*text == L'\0')
+            {
+                pattern_free(ret);
+                return NULL;
+            }
+            //fall through
+        default:
+            element->kind = PATTERN_LETTER;
+            element->letter = *text++;
+            break;
+        }
+    }
+
+    ret->min_rest[ret->length] = 0;
+    ret->bounded_rest[ret->length] = true;
+    for(size_t i = ret->length; i > 0; i--)
+    {
+        bool star = (ret->elements[i-1].kind == PATTERN_STAR);
+        ret->min_rest[i-1] = ret->min_rest[i] + (star ? 0 : 1);
+        ret->bounded_rest[i-1] = ret->bounded_rest[i] && !star;
+    }
+    return ret;
+}
+
+void pattern_free(Pattern* pattern)
+{
+    if(pattern == NULL)
+        return;
+    for(size_t i = 0; i <= pattern->length; i++)
+        free(pattern->elements[i].ranges);
+    free(pattern->elements);
+    free(pattern->min_rest);
+    free(pattern->bounded_rest);
+    free(pattern);
+}
+
+///Tests if the element matches the letter.
+static bool element_matches(const Pattern_Element* element, wchar_t letter)
+{
+    switch(element->kind)
+    {
+    case PATTERN_LETTER:
+        return element->letter == letter;
+    case PATTERN_CLASS:
+        for(size_t i = 0; i < element->range_count; i++)
+            if(element->ranges[2*i] <= letter && letter <= element->ranges[2*i + 1])
+                return !element->negated;
+        return element->negated;
+    default:
+        return true;
+    }
+}
+
+/**
+  * State of pattern_match_trie().
+  */
+typedef struct
+{
+    const Pattern* pattern; ///<The pattern.
+    Trie_Word_Callback callback; ///<Called for matching words.
+    void* data; ///<Passed to callback.
+    wchar_t* word; ///<Buffer with the current word.
+    size_t word_size; ///<Size of the buffer.
+    bool* states; ///<Active positions in the pattern, length + 1 for every depth.
+    size_t state_levels; ///<Number of depths the array of states can keep.
+    size_t found; ///<Number of matching words.
+} Pattern_Search;
+
+/**
+ * @brief close_states Adds positions reached by skipping stars, drops positions which cannot match the subtree.
+ * @param pattern The pattern.
+ * @param states Active positions.
+ * @param node Node the positions were reached in.
+ * @return True if any position is left.
+ */
+static bool close_states(const Pattern* pattern, bool* states, const Node* node)
+{
+    const size_t len = pattern->length;
+    for(size_t p = 0; p < len; p++)
+        if(states[p] && pattern->elements[p].kind == PATTERN_STAR)
+            states[p+1] = true;
+
+    bool any = false;
+    for(size_t p = 0; p <= len; p++)
+    {
+        if(!states[p])
+            continue;
+        //lengths of words below the node have to meet lengths matched by the rest of the pattern
+        if(node->max_depth < pattern->min_rest[p]
+           || (pattern->bounded_rest[p] && node->min_depth > pattern->min_rest[p]))
+            states[p] = false;
+        any = any || states[p];
+    }
+    return any;
+}
+
+static void match_node(Pattern_Search* search, const Node* node, size_t depth);
+
+/**
+ * @brief match_child Moves active positions of the node along the letter of the child and visits it.
+ * @param search State of the search.
+ * @param child The child.
+ * @param depth Depth of the parent of the child.
+ */
+static void match_child(Pattern_Search* search, const Node* child, size_t depth)
+{
+    const Pattern* pattern = search->pattern;
+    const size_t len = pattern->length;
+    if(depth + 2 > search->state_levels)
+    {
+        search->state_levels *= 2;
+        search->states = realloc(search->states, sizeof(bool) * (len + 1) * search->state_levels);
+        if(search->states == NULL) report_error(MEMORY);
+    }
+    if(depth + 2 > search->word_size)
+    {
+        search->word_size *= 2;
+        search->word = realloc(search->word, sizeof(wchar_t) * search->word_size);
+        if(search->word == NULL) report_error(MEMORY);
+    }
+
+    const bool* states = search->states + depth * (len + 1);
+    bool* next = search->states + (depth + 1) * (len + 1);
+    memset(next, 0, sizeof(bool) * (len + 1));
+    for(size_t p = 0; p < len; p++)
+    {
+        const Pattern_Element* element = &pattern->elements[p];
+        if(states[p] && element_matches(element, child->value))
+            next[element->kind == PATTERN_STAR ? p : p + 1] = true;
+    }
+    if(close_states(pattern, next, child))
+    {
+        search->word[depth] = child->value;
+        match_node(search, child, depth + 1);
+    }
+}
+
+/**
+ * @brief match_node Visits matching words in the subtree of the node.
+ * @param search State of the search.
+ * @param node The node, its active positions are already computed.
+ * @param depth Length of the word of the node.
+ */
+static void match_node(Pattern_Search* search, const Node* node, size_t depth)
+{
+    const Pattern* pattern = search->pattern;
+    const size_t len = pattern->length;
+    const bool* states = search->states + depth * (len + 1);
+    if(states[len] && node->is_word)
+    {
+        search->word[depth] = L'\0';
+        search->callback(search->word, node, search->data);
+        search->found++;
+    }
+
+    size_t active = 0;
+    const Pattern_Element* letter = NULL;
+    for(size_t p = 0; p < len; p++)
+    {
+        if(!states[p])
+            continue;
+        active++;
+        if(pattern->elements[p].kind == PATTERN_LETTER)
+            letter = &pattern->elements[p];
+    }
+    if(active == 0)
+        return;
+    if(active == 1 && letter != NULL) //only one child can match
+    {
+        const Node* child = trie_child(node, letter->letter);
+        if(child != NULL)
+            match_child(search, child, depth);
+        return;
+    }
+    for(int i = 0; i < node->children->element_count; i++)
+        match_child(search, node->children->storage[i], depth);
+}
+
+size_t pattern_match_trie(const Pattern* pattern, const Node* root, Trie_Word_Callback callback, void* data)
+{
+    assert(pattern != NULL);
+    assert(root != NULL);
+    assert(callback != NULL);
+
+    Pattern_Search search = {pattern, callback, data, NULL, TRIE_WORD_BUFFER_START_SIZE, NULL,
+                             TRIE_WORD_BUFFER_START_SIZE, 0};
+    search.word = malloc(sizeof(wchar_t) * search.word_size);
+    search.states = calloc((pattern->length + 1) * search.state_levels, sizeof(bool));
+    if(search.word == NULL || search.states == NULL) report_error(MEMORY);
+    search.states[0] = true;
+    if(close_states(pattern, search.states, root))
+        match_node(&search, root, 0);
+    free(search.word);
+    free(search.states);
+    return search.found;
+}
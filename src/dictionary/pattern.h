@@ -0,0 +1,82 @@
+#ifndef PATTERN_H_INCLUDED
+#define PATTERN_H_INCLUDED
+
+/** @defgroup pattern Module pattern
+ * Wildcard patterns matched against words of a trie.
+ */
+/**
+ * @file pattern.h Header file of module pattern.
+ * @ingroup pattern
+ * @author agent <agent@local>
+ * @date 2026-10
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <wchar.h>
+#include "trie.h"
+
+#define PATTERN_ANY_LETTER L'?' ///<Matches any single letter.
+#define PATTERN_ANY_SEQUENCE L'*' ///<Matches any sequence of letters, also the empty one.
+#define PATTERN_CLASS_BEGIN L'[' ///<Begins a class of letters, like [a-cz] or [^aeiou].
+#define PATTERN_CLASS_END L']' ///<Ends a class of letters.
+#define PATTERN_CLASS_NEGATION L'^' ///<Placed first in a class, matches letters out of the class.
+#define PATTERN_CLASS_RANGE L'-' ///<Separates ends of a range of letters in a class.
+#define PATTERN_ESCAPE L'\\' ///<Makes the next sign an ordinary letter.
+
+#define PATTERN_LETTER 0 ///<Kind of element: given letter.
+#define PATTERN_ANY 1 ///<Kind of element: any letter.
+#define PATTERN_CLASS 2 ///<Kind of element: letter of a class.
+#define PATTERN_STAR 3 ///<Kind of element: any sequence of letters.
+
+/**
+  * Single element of a pattern.
+  */
+typedef struct
+{
+    int kind; ///<PATTERN_LETTER, PATTERN_ANY, PATTERN_CLASS or PATTERN_STAR.
+    wchar_t letter; ///<The letter of PATTERN_LETTER.
+    wchar_t* ranges; ///<Pairs of first and last letters of ranges of PATTERN_CLASS.
+    size_t range_count; ///<Number of ranges.
+    bool negated; ///<True if the class matches letters out of its ranges.
+} Pattern_Element;
+
+/**
+  * Compiled pattern.
+  * <p>
+  * The pattern is run as a nondeterministic automaton whose states are positions in the pattern.
+  * Lengths of the rest of the pattern are compared with depths of subtrees of the trie,
+  * so subtrees with too short or too long words are not visited.
+  */
+typedef struct
+{
+    Pattern_Element* elements; ///<The elements.
+    size_t length; ///<Number of elements.
+    size_t* min_rest; ///<Least number of letters matched by elements from given position to the end.
+    bool* bounded_rest; ///<False if elements from given position to the end contain PATTERN_STAR.
+} Pattern;
+
+/**
+ * @brief pattern_new Compiles the pattern.
+ * @param text The pattern, see PATTERN_ANY_LETTER and following.
+ * @return Pointer to the compiled pattern or NULL if text is malformed.
+ */
+Pattern* pattern_new(const wchar_t* text);
+
+/**
+ * @brief pattern_free Deallocates the pattern.
+ * @param pattern The pattern.
+ */
+void pattern_free(Pattern* pattern);
+
+/**
+ * @brief pattern_match_trie Visits words of the trie matching the pattern.
+ * @param pattern The pattern.
+ * @param root Root of the trie.
+ * @param callback Called for every matching word, in alphabetical order.
+ * @param data Passed to callback.
+ * @return Number of matching words.
+ */
+size_t pattern_match_trie(const Pattern* pattern, const Node* root, Trie_Word_Callback callback, void* data);
+
+#endif // PATTERN_H_INCLUDED
@@ -0,0 +1,150 @@
+/** @file
+    Implementation of phonetic keys.
+    @ingroup phonetic
+    @author agent
+    @date 2026-10
+  */
+
+#include <stdlib.h>
+#include <string.h>
+#include <wchar.h>
+#include <assert.h>
+
+#include "phonetic.h"
+#include "error_handling.h"
+
+#ifdef PHONETIC_UNIT_TESTING
+#include <stdarg.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#ifdef malloc
+#undef malloc
+#endif // malloc
+#define malloc(size) _test_malloc(size, __FILE__, __LINE__)
+
+#ifdef free
+#undef free
+#endif // free
+#define free(ptr) _test_free(ptr, __FILE__, __LINE__)
+
+#ifdef assert
+#undef assert
+#define assert(expression) mock_assert((int)(expression), #expression, __FILE__, __LINE__);
+#endif
+#endif // PHONETIC_UNIT_TESTING
+
+///Groups of Polish letters sounding the same.
+static const Phonetic_Rule polish_rules[] =
+{
+    {L"rz", L"ż"},
+    {L"ch", L"h"},
+    {L"ó", L"u"},
+    {L"ą", L"on"},
+    {L"ę", L"en"},
+};
+
+///Polish voiced consonants devoiced at the end of a word.
+static const Phonetic_Rule polish_final_rules[] =
+{
+    {L"dż", L"cz"},
+    {L"dź", L"ć"},
+    {L"dz", L"c"},
+    {L"b", L"p"},
+    {L"d", L"t"},
+    {L"g", L"k"},
+    {L"w", L"f"},
+    {L"z", L"s"},
+    {L"ż", L"sz"},
+    {L"ź", L"ś"},
+};
+
+///Known languages, the last one is used for others.
+static const Phonetic_Rules languages[] =
+{
+    {"pl", polish_rules, sizeof(polish_rules) / sizeof(Phonetic_Rule),
+     polish_final_rules, sizeof(polish_final_rules) / sizeof(Phonetic_Rule)},
+    {"", NULL, 0, NULL, 0},
+};
+
+const Phonetic_Rules* phonetic_rules(const char* lang)
+{
+    size_t count = sizeof(languages) / sizeof(Phonetic_Rules);
+    if(lang == NULL)
+        return &languages[count - 1];
+    for(size_t i = 0; i < count - 1; i++)
+        if(strncmp(lang, languages[i].lang_prefix, strlen(languages[i].lang_prefix)) == 0)
+            return &languages[i];
+    return &languages[count - 1];
+}
+
+/**
+ * @brief longest_rule Finds the longest rule matching the text.
+ * @param rules Array of rules.
+ * @param rule_count Size of the array.
+ * @param text The text, rule matches if it is a prefix of the text.
+ * @param text_len Length of the text, if rule has to end with it, or 0 otherwise.
+ * @return The rule or NULL if none matches.
+ */
+static const Phonetic_Rule* longest_rule(const Phonetic_Rule* rules, size_t rule_count,
+                                         const wchar_t* text, size_t text_len)
+{
+    const Phonetic_Rule* ret = NULL;
+    size_t ret_len = 0;
+    for(size_t i = 0; i < rule_count; i++)
+    {
+        size_t len = wcslen(rules[i].from);
+        if(len <= ret_len || (text_len != 0 && len != text_len))
+            continue;
+        if(wcsncmp(text, rules[i].from, len) == 0)
+        {
+            ret = &rules[i];
+            ret_len = len;
+        }
+    }
+    return ret;
+}
+
+wchar_t* phonetic_key(const wchar_t* word, const void* rules)
+{
+    assert(word != NULL);
+    assert(rules != NULL);
+
+    const Phonetic_Rules* language = rules;
+    size_t len = wcslen(word);
+    wchar_t* ret = malloc(sizeof(wchar_t) * (PHONETIC_MAX_EXPANSION * (len + 1) + 1));
+    if(ret == NULL) report_error(MEMORY);
+
+    size_t ret_len = 0;
+    for(size_t i = 0; i < len;)
+    {
+        const Phonetic_Rule* rule = longest_rule(language->rules, language->rule_count, word + i, 0);
+        if(rule == NULL)
+        {
+            ret[ret_len++] = word[i++];
+            continue;
+        }
+        wcscpy(ret + ret_len, rule->to);
+        ret_len += wcslen(rule->to);
+        i += wcslen(rule->from);
+    }
+    ret[ret_len] = L'\0';
+
+    for(size_t suffix = ret_len; suffix > 0; suffix--)
+    {
+        const Phonetic_Rule* rule = longest_rule(language->final_rules, language->final_rule_count,
+                                                 ret + ret_len - suffix, suffix);
+        if(rule != NULL)
+        {
+            wcscpy(ret + ret_len - suffix, rule->to);
+            ret_len += wcslen(rule->to) - suffix;
+            break;
+        }
+    }
+
+    size_t collapsed_len = 0;
+    for(size_t i = 0; i < ret_len; i++)
+        if(collapsed_len == 0 || ret[collapsed_len - 1] != ret[i])
+            ret[collapsed_len++] = ret[i];
+    ret[collapsed_len] = L'\0';
+    return ret;
+}
@@ -0,0 +1,59 @@
+#ifndef PHONETIC_H_INCLUDED
+#define PHONETIC_H_INCLUDED
+
+/** @defgroup phonetic Module phonetic
+ * Phonetic keys of words, equal for words which sound alike.
+ */
+/**
+ * @file phonetic.h Header file of module phonetic.
+ * @ingroup phonetic
+ * @author agent <agent@local>
+ * @date 2026-10
+ */
+
+#include <stddef.h>
+#include <wchar.h>
+
+#define PHONETIC_MAX_EXPANSION 2 ///<Greatest length of the replacement of a single letter by a rule.
+
+/**
+ * Replacement of a group of letters by the letters which sound the same.
+ */
+typedef struct
+{
+    const wchar_t* from; ///<Replaced letters.
+    const wchar_t* to; ///<Replacement, at most PHONETIC_MAX_EXPANSION letters per replaced letter.
+} Phonetic_Rule;
+
+/**
+ * Rules of a language.
+ * <p>
+ * Rules are applied from left to right, the longest matching one first. Final rules are applied
+ * once more to the end of the result, so devoiced last letters get the same key.
+ * At last, repeated letters are collapsed into one.
+ */
+typedef struct
+{
+    const char* lang_prefix; ///<Names of languages using the rules start with it.
+    const Phonetic_Rule* rules; ///<Rules applied to the whole word.
+    size_t rule_count; ///<Number of rules.
+    const Phonetic_Rule* final_rules; ///<Rules applied to the end of the word.
+    size_t final_rule_count; ///<Number of final rules.
+} Phonetic_Rules;
+
+/**
+ * @brief phonetic_rules Finds rules of the language.
+ * @param lang Name of the language, i.e. "pl_PL", or NULL.
+ * @return Rules of the language, rules only collapsing repeated letters if language is unknown.
+ */
+const Phonetic_Rules* phonetic_rules(const char* lang);
+
+/**
+ * @brief phonetic_key Computes phonetic key of the word.
+ * @param word Lower-case word.
+ * @param rules Pointer to Phonetic_Rules, void to fit key functions of module key_index.
+ * @return New string, freed by the caller.
+ */
+wchar_t* phonetic_key(const wchar_t* word, const void* rules);
+
+#endif // PHONETIC_H_INCLUDED
@@ -15,6 +15,12 @@
 
 #include "trie.h"
 #include "array_set.h"
+
+#ifdef __GNUC__
+#define trie_prefetch(address) __builtin_prefetch(address) ///<Hint to load memory to cache, which is read soon.
+#else
+#define trie_prefetch(address) ((void) (address)) ///<No prefetching without compiler support.
+#endif // __GNUC__
 #include "error_handling.h"
 
 #ifdef TRIE_UNIT_TESTING
@@ -31,6 +37,11 @@
 #endif // calloc
 #define calloc(num, size) _test_calloc(num, size, __FILE__, __LINE__)
 
+#ifdef realloc
+#undef realloc
+#endif // realloc
+#define realloc(ptr, size) _test_realloc(ptr, size, __FILE__, __LINE__)
+
 #ifdef free
 #undef free
 #endif // free
@@ -92,6 +103,74 @@ Node* trie_new_node(void)
     return ret;
 }
 
+///Computes greatest frequency in the subtree of node from its own frequency and its children.
+static unsigned char subtree_max_frequency(const Node* node)
+{
+    unsigned char max = node->is_word ? node->frequency : 0;
+    for(int i = 0; i < node->children->element_count; i++)
+    {
+        const Node* child = node->children->storage[i];
+        if(child->max_frequency > max)
+            max = child->max_frequency;
+    }
+    return max;
+}
+
+///Computes lengths of the shortest and the longest word in the subtree of node, counted from node.
+static void subtree_depths(const Node* node, unsigned short* min_depth, unsigned short* max_depth)
+{
+    unsigned min = node->is_word ? 0 : TRIE_MAX_DEPTH;
+    unsigned max = 0;
+    for(int i = 0; i < node->children->element_count; i++)
+    {
+        const Node* child = node->children->storage[i];
+        if(child->min_depth + 1u < min)
+            min = child->min_depth + 1u;
+        if(child->max_depth + 1u > max)
+            max = child->max_depth + 1u;
+    }
+    if(min > max) //no words, only in an empty trie
+        min = max;
+    *min_depth = min;
+    *max_depth = max < TRIE_MAX_DEPTH ? max : TRIE_MAX_DEPTH;
+}
+
+/**
+ * @brief update_bounds Recomputes greatest frequencies and depths of subtrees from node up to the root.
+ * @param node Lowest node whose subtree has changed.
+ * Stops as soon as a node keeps its values, because its ancestors keep theirs too.
+ */
+static void update_bounds(Node* node)
+{
+    for(bool first = true; node != NULL; first = false)
+    {
+        unsigned char max = subtree_max_frequency(node);
+        unsigned short min_depth, max_depth;
+        subtree_depths(node, &min_depth, &max_depth);
+        //a new leaf looks unchanged, but its ancestors are not updated yet
+        if(!first && max == node->max_frequency && min_depth == node->min_depth && max_depth == node->max_depth)
+            return;
+        node->max_frequency = max;
+        node->min_depth = min_depth;
+        node->max_depth = max_depth;
+        node = node->parent;
+    }
+}
+
+///Adds delta to numbers of words in subtrees of the node and its ancestors.
+static void add_word_count(Node* node, int delta)
+{
+    for(; node != NULL; node = node->parent)
+        node->word_count += delta;
+}
+
+///Clears hashes of the node and its ancestors after a change of the subtree.
+static void clear_hashes(Node* node)
+{
+    for(; node != NULL; node = node->parent)
+        node->hash = 0;
+}
+
 int trie_insert_word(Node* root, const wchar_t* word)
 {
     assert(root != NULL);
@@ -130,7 +209,15 @@ int trie_insert_word(Node* root, const wchar_t* word)
         }
 
         if(i == len-1)
+        {
+            if(modified)
+            {
+                add_word_count(current_node, 1);
+                clear_hashes(current_node);
+                update_bounds(current_node);
+            }
             return modified ? TRIE_INSERT_MODIFIED : TRIE_INSERT_NOT_MODIFIED;
+        }
     }
     return 42;
 }
@@ -172,20 +259,467 @@ int trie_find_word(Node* root, const wchar_t* word)
     return jump_to_word_node(root, word) == NULL ? TRIE_WORD_NOT_FOUND : TRIE_WORD_FOUND;
 }
 
+const Node* trie_child(const Node* node, wchar_t letter)
+{
+    assert(node != NULL);
+
+    void** storage = node->children->storage;
+    int begin = 0;
+    int end = node->children->element_count;
+    while(begin < end)
+    {
+        int middle = (begin + end) / 2;
+        const Node* child = storage[middle];
+        if(child->value == letter)
+            return child;
+        if(child->value < letter)
+            begin = middle + 1;
+        else
+            end = middle;
+    }
+    return NULL;
+}
+
+size_t trie_rank(const Node* root, const wchar_t* word)
+{
+    assert(root != NULL);
+    assert(word != NULL);
+
+    size_t ret = 0;
+    const Node* node = root;
+    for(; *word != L'\0'; word++)
+    {
+        if(node->is_word) //prefix of the word
+            ret++;
+        const Node* next = NULL;
+        for(int i = 0; i < node->children->element_count; i++)
+        {
+            const Node* child = node->children->storage[i];
+            if(child->value >= *word)
+            {
+                if(child->value == *word)
+                    next = child;
+                break;
+            }
+            ret += child->word_count;
+        }
+        if(next == NULL)
+            return ret;
+        node = next;
+    }
+    return ret;
+}
+
+const Node* trie_select(const Node* root, size_t rank)
+{
+    assert(root != NULL);
+
+    if(rank >= root->word_count)
+        return NULL;
+    const Node* node = root;
+    while(true)
+    {
+        if(node->is_word)
+        {
+            if(rank == 0)
+                return node;
+            rank--;
+        }
+        for(int i = 0; i < node->children->element_count; i++)
+        {
+            const Node* child = node->children->storage[i];
+            if(rank < child->word_count)
+            {
+                node = child;
+                break;
+            }
+            rank -= child->word_count;
+        }
+    }
+}
+
+wchar_t* trie_node_word(const Node* node)
+{
+    assert(node != NULL);
+
+    size_t depth = 0;
+    for(const Node* current = node; current->parent != NULL; current = current->parent)
+        depth++;
+    wchar_t* ret = malloc(sizeof(wchar_t) * (depth + 1));
+    if(ret == NULL) report_error(MEMORY);
+    ret[depth] = L'\0';
+    for(; depth > 0; depth--, node = node->parent)
+        ret[depth-1] = node->value;
+    return ret;
+}
+
+///Ensures that the path of the iterator can grow by one node.
+static void iterator_reserve(Trie_Iterator* iterator)
+{
+    if(iterator->depth + 2 <= iterator->size)
+        return;
+    iterator->size *= 2;
+    iterator->nodes = realloc(iterator->nodes, sizeof(Node*) * iterator->size);
+    iterator->next_child = realloc(iterator->next_child, sizeof(int) * iterator->size);
+    iterator->word = realloc(iterator->word, sizeof(wchar_t) * iterator->size);
+    if(iterator->nodes == NULL || iterator->next_child == NULL || iterator->word == NULL) report_error(MEMORY);
+}
+
+void trie_iterator_init(Trie_Iterator* iterator, const Node* root)
+{
+    assert(iterator != NULL);
+    assert(root != NULL);
+
+    iterator->size = TRIE_WORD_BUFFER_START_SIZE;
+    iterator->nodes = malloc(sizeof(Node*) * iterator->size);
+    iterator->next_child = malloc(sizeof(int) * iterator->size);
+    iterator->word = malloc(sizeof(wchar_t) * iterator->size);
+    if(iterator->nodes == NULL || iterator->next_child == NULL || iterator->word == NULL) report_error(MEMORY);
+    iterator->nodes[0] = root;
+    iterator->next_child[0] = 0;
+    iterator->depth = 0;
+    iterator->pending = false;
+}
+
+void trie_iterator_done(Trie_Iterator* iterator)
+{
+    assert(iterator != NULL);
+
+    free(iterator->nodes);
+    free(iterator->next_child);
+    free(iterator->word);
+}
+
+void trie_iterator_seek(Trie_Iterator* iterator, const wchar_t* key)
+{
+    assert(iterator != NULL);
+    assert(key != NULL);
+
+    iterator->depth = 0;
+    iterator->pending = false;
+    for(; *key != L'\0'; key++)
+    {
+        const Node* node = iterator->nodes[iterator->depth];
+        int i = 0;
+        while(i < node->children->element_count && ((Node*)node->children->storage[i])->value < *key)
+            i++;
+        iterator->next_child[iterator->depth] = i;
+        if(i == node->children->element_count || ((Node*)node->children->storage[i])->value != *key)
+            return; //words of the next child, if any, are greater than the key
+        iterator->next_child[iterator->depth]++;
+        iterator_reserve(iterator);
+        iterator->word[iterator->depth] = *key;
+        iterator->nodes[++iterator->depth] = node->children->storage[i];
+    }
+    iterator->next_child[iterator->depth] = 0;
+    iterator->pending = iterator->nodes[iterator->depth]->is_word;
+}
+
+const wchar_t* trie_iterator_next(Trie_Iterator* iterator)
+{
+    assert(iterator != NULL);
+
+    while(!iterator->pending)
+    {
+        const Node* node = iterator->nodes[iterator->depth];
+        if(iterator->next_child[iterator->depth] < node->children->element_count)
+        {
+            const Node* child = node->children->storage[iterator->next_child[iterator->depth]++];
+            iterator_reserve(iterator);
+            iterator->word[iterator->depth] = child->value;
+            iterator->nodes[++iterator->depth] = child;
+            iterator->next_child[iterator->depth] = 0;
+            iterator->pending = child->is_word;
+        }
+        else if(iterator->depth == 0)
+            return NULL;
+        else
+            iterator->depth--;
+    }
+    iterator->pending = false;
+    iterator->word[iterator->depth] = L'\0';
+    return iterator->word;
+}
+
+///Computes bounds of the node from its complete children.
+static void complete_node(Node* node)
+{
+    node->max_frequency = subtree_max_frequency(node);
+    subtree_depths(node, &node->min_depth, &node->max_depth);
+    node->word_count = node->is_word;
+    for(int i = 0; i < node->children->element_count; i++)
+        node->word_count += ((Node*)node->children->storage[i])->word_count;
+}
+
+/**
+ * @brief merge_nodes Builds the subtree of trie_merge() for nodes of the same word.
+ * @param a Node of the first trie or NULL.
+ * @param b Node of the second trie or NULL.
+ * @param operation Operation of trie_merge().
+ * @param value Letter of the new node.
+ * @param parent Parent of the new node.
+ * @return The new node or NULL if its subtree would have no words.
+ */
+static Node* merge_nodes(const Node* a, const Node* b, int operation, wchar_t value, Node* parent)
+{
+    bool a_word = a != NULL && a->is_word;
+    bool b_word = b != NULL && b->is_word;
+    Node* ret = trie_new_node();
+    ret->value = value;
+    ret->parent = parent;
+    if(operation == TRIE_MERGE_UNION)
+        ret->is_word = a_word || b_word;
+    else if(operation == TRIE_MERGE_INTERSECTION)
+        ret->is_word = a_word && b_word;
+    else
+        ret->is_word = a_word && !b_word;
+    if(ret->is_word)
+    {
+        unsigned char a_frequency = a_word ? a->frequency : 0;
+        unsigned char b_frequency = b_word && operation != TRIE_MERGE_DIFFERENCE ? b->frequency : 0;
+        ret->frequency = a_frequency > b_frequency ? a_frequency : b_frequency;
+    }
+
+    //children of both nodes are sorted, so they are merged like lists
+    int a_count = a != NULL ? a->children->element_count : 0;
+    int b_count = b != NULL ? b->children->element_count : 0;
+    int i = 0, j = 0;
+    while(i < a_count || j < b_count)
+    {
+        const Node* a_child = i < a_count ? a->children->storage[i] : NULL;
+        const Node* b_child = j < b_count ? b->children->storage[j] : NULL;
+        if(a_child != NULL && b_child != NULL && a_child->value != b_child->value)
+        {
+            if(a_child->value < b_child->value)
+                b_child = NULL;
+            else
+                a_child = NULL;
+        }
+        if(a_child != NULL)
+            i++;
+        if(b_child != NULL)
+            j++;
+        if(operation == TRIE_MERGE_INTERSECTION && (a_child == NULL || b_child == NULL))
+            continue;
+        if(operation == TRIE_MERGE_DIFFERENCE && a_child == NULL)
+            continue;
+        wchar_t child_value = a_child != NULL ? a_child->value : b_child->value;
+        Node* child = merge_nodes(a_child, b_child, operation, child_value, ret);
+        if(child != NULL)
+            set_add(ret->children, child); //added in order, so appended
+    }
+
+    if(parent != NULL && !ret->is_word && ret->children->element_count == 0)
+    {
+        trie_free_node(ret);
+        return NULL;
+    }
+    complete_node(ret);
+    return ret;
+}
+
+Node* trie_merge(const Node* a, const Node* b, int operation)
+{
+    assert(a != NULL);
+    assert(b != NULL);
+    assert(operation == TRIE_MERGE_UNION || operation == TRIE_MERGE_INTERSECTION
+           || operation == TRIE_MERGE_DIFFERENCE);
+
+    return merge_nodes(a, b, operation, L'\0', NULL);
+}
+
+void trie_builder_init(Trie_Builder* builder)
+{
+    assert(builder != NULL);
+
+    builder->size = TRIE_WORD_BUFFER_START_SIZE;
+    builder->path = malloc(sizeof(Node*) * builder->size);
+    if(builder->path == NULL) report_error(MEMORY);
+    builder->path[0] = trie_new_node();
+    builder->depth = 0;
+}
+
+int trie_builder_add(Trie_Builder* builder, const wchar_t* word, unsigned char frequency)
+{
+    assert(builder != NULL);
+    assert(word != NULL);
+
+    size_t shared = 0;
+    while(shared < builder->depth && word[shared] == builder->path[shared + 1]->value)
+        shared++;
+    if(word[shared] == L'\0' || (shared < builder->depth && word[shared] < builder->path[shared + 1]->value))
+        return -1; //not greater than the previous word
+    for(; builder->depth > shared; builder->depth--)
+        complete_node(builder->path[builder->depth]);
+
+    int ret = 0;
+    for(; word[builder->depth] != L'\0'; ret++)
+    {
+        if(builder->depth + 2 > builder->size)
+        {
+            builder->size *= 2;
+            builder->path = realloc(builder->path, sizeof(Node*) * builder->size);
+            if(builder->path == NULL) report_error(MEMORY);
+        }
+        Node* parent = builder->path[builder->depth];
+        Node* child = trie_new_node();
+        child->value = word[builder->depth];
+        child->parent = parent;
+        set_add(parent->children, child); //greater than other children, so appended
+        builder->path[++builder->depth] = child;
+    }
+    Node* node = builder->path[builder->depth];
+    node->is_word = true;
+    node->frequency = frequency;
+    return ret;
+}
+
+Node* trie_builder_finish(Trie_Builder* builder)
+{
+    assert(builder != NULL);
+
+    for(size_t depth = builder->depth + 1; depth > 0; depth--)
+        complete_node(builder->path[depth - 1]);
+    Node* ret = builder->path[0];
+    free(builder->path);
+    return ret;
+}
+
+///Mixes bits of the value, finalizer of splitmix64.
+static uint64_t hash_mix(uint64_t value)
+{
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+    return value ^ (value >> 31);
+}
+
+uint64_t trie_hash(Node* node)
+{
+    assert(node != NULL);
+
+    if(node->hash != 0)
+        return node->hash;
+    //children have different letters, which are part of their hashes, so their sum is enough
+    uint64_t children = 0;
+    for(int i = 0; i < node->children->element_count; i++)
+        children += trie_hash(node->children->storage[i]);
+    uint64_t own = (uint64_t) node->value | (uint64_t) node->is_word << 32;
+    if(node->is_word)
+        own |= (uint64_t) node->frequency << 33;
+    node->hash = hash_mix(hash_mix(own) + children);
+    if(node->hash == 0)
+        node->hash = 1;
+    return node->hash;
+}
+
+/**
+  * State of one of the words searched in lockstep by trie_find_words().
+  */
+typedef struct
+{
+    const Node* node; ///<Node of the read prefix of the word.
+    const wchar_t* rest; ///<Unread letters of the word.
+    size_t index; ///<Position of the word in the batch.
+    int stage; ///<Next step: 0 - fetch children set, 1 - fetch its storage, 2 - go to child.
+    bool active; ///<False if the slot has no word.
+} Batch_Walk;
+
+void trie_find_words(const Node* root, const wchar_t* const* words, size_t count, bool* found)
+{
+    assert(root != NULL);
+    assert(count == 0 || (words != NULL && found != NULL));
+
+    Batch_Walk walks[TRIE_BATCH_GROUP];
+    size_t next = 0;
+    size_t active = 0;
+    for(int i = 0; i < TRIE_BATCH_GROUP; i++)
+        walks[i].active = false;
+
+    while(next < count || active > 0)
+    {
+        for(int i = 0; i < TRIE_BATCH_GROUP; i++)
+        {
+            Batch_Walk* walk = &walks[i];
+            if(!walk->active)
+            {
+                if(next == count)
+                    continue;
+                walk->node = root;
+                walk->rest = words[next];
+                walk->index = next++;
+                walk->stage = 0;
+                walk->active = true;
+                active++;
+            }
+            //every step only prefetches what the next step of the walk reads,
+            //steps of other walks are done in the meantime
+            switch(walk->stage)
+            {
+            case 0:
+                if(*walk->rest == L'\0')
+                {
+                    found[walk->index] = walk->node->is_word;
+                    walk->active = false;
+                    active--;
+                    break;
+                }
+                trie_prefetch(walk->node->children);
+                walk->stage = 1;
+                break;
+            case 1:
+                trie_prefetch(walk->node->children->storage);
+                walk->stage = 2;
+                break;
+            default:
+                walk->node = trie_child(walk->node, *walk->rest);
+                if(walk->node == NULL)
+                {
+                    found[walk->index] = false;
+                    walk->active = false;
+                    active--;
+                    break;
+                }
+                walk->rest++;
+                trie_prefetch(walk->node);
+                walk->stage = 0;
+                break;
+            }
+        }
+    }
+}
+
+int trie_set_frequency(Node* root, const wchar_t* word, unsigned char frequency)
+{
+    Node* word_node = jump_to_word_node(root, word);
+    if(word_node == NULL)
+        return TRIE_WORD_NOT_FOUND;
+    word_node->frequency = frequency;
+    update_bounds(word_node);
+    clear_hashes(word_node);
+    return TRIE_WORD_FOUND;
+}
+
+unsigned char trie_get_frequency(Node* root, const wchar_t* word)
+{
+    Node* word_node = jump_to_word_node(root, word);
+    return word_node == NULL ? 0 : word_node->frequency;
+}
+
 /**
  * @brief fix_after_delete Removes all unused nodes in trie after operation of delete.
  * @param node A node that was corresonding to a word that was deleted from trie.
+ * @return The lowest node which was not removed.
  * The function deallocates nodes that can be removed and calls itself for removed node parent.
  * Stops when reaching root.
  */
-static void fix_after_delete(Node* node)
+static Node* fix_after_delete(Node* node)
 {
     assert(node != NULL);
 
     if(is_root(node))
-        return;
+        return node;
     if(set_size(node->children) > 0) //cannot delete node
-        return;
+        return node;
 
     Node* current_node = node;
     Node* current_node_parent;
@@ -196,6 +730,7 @@ static void fix_after_delete(Node* node)
         set_remove(current_node_parent->children, current_node);
         current_node = current_node_parent;
     }
+    return current_node;
 }
 
 int trie_delete_word(Node* root, const wchar_t* word)
@@ -211,7 +746,10 @@ int trie_delete_word(Node* root, const wchar_t* word)
     {
         assert(word_node->is_word);
         word_node->is_word = false;
-        fix_after_delete(word_node);
+        word_node->frequency = 0;
+        add_word_count(word_node, -1);
+        clear_hashes(word_node);
+        update_bounds(fix_after_delete(word_node));
         return TRIE_WORD_DELETED;
     }
 }
@@ -261,6 +799,10 @@ static int fill_node_from_file(FILE* file, Node* filled, Node* parent)
 
     for(int i = 0; i < filled->children->element_count; i++)
         fill_node_from_file(file, (Node*)filled->children->storage[i], filled);
+    subtree_depths(filled, &filled->min_depth, &filled->max_depth);
+    filled->word_count = filled->is_word;
+    for(int i = 0; i < filled->children->element_count; i++)
+        filled->word_count += ((Node*)filled->children->storage[i])->word_count;
     return 0;
 
 }
@@ -299,6 +841,195 @@ int trie_save_to_file(Node* node, FILE* file)
     return TRIE_SAVE_TO_FILE_SUCCESS;
 }
 
+void trie_save_frequencies(const Node* node, FILE* file)
+{
+    assert(node != NULL);
+    assert(file != NULL);
+
+    if(node->is_word)
+    {
+        wchar_t digits[4];
+        int digit_count = 0;
+        for(int frequency = node->frequency; frequency > 0; frequency /= 10)
+            digits[digit_count++] = L'0' + frequency % 10;
+        while(digit_count > 0)
+            fputwc(digits[--digit_count], file);
+        fputwc(END_OF_FREQUENCY_SIGN, file);
+    }
+    for(int i = 0; i < node->children->element_count; i++)
+        trie_save_frequencies(node->children->storage[i], file);
+}
+
+int trie_load_frequencies(Node* node, FILE* file)
+{
+    assert(node != NULL);
+    assert(file != NULL);
+
+    node->max_frequency = 0;
+    if(node->is_word)
+    {
+        int frequency = 0;
+        wchar_t sign;
+        while((sign = fgetwc(file)) != END_OF_FREQUENCY_SIGN)
+        {
+            if(sign < L'0' || sign > L'9')
+                return -1;
+            frequency = frequency * 10 + (sign - L'0');
+            if(frequency > TRIE_MAX_FREQUENCY)
+                return -1;
+        }
+        node->frequency = frequency;
+        node->max_frequency = frequency;
+    }
+    for(int i = 0; i < node->children->element_count; i++)
+    {
+        Node* child = node->children->storage[i];
+        if(trie_load_frequencies(child, file) < 0)
+            return -1;
+        if(child->max_frequency > node->max_frequency)
+            node->max_frequency = child->max_frequency;
+    }
+    return 0;
+}
+
+/**
+ * @brief for_each_word_rec Visits words in the subtree of the node.
+ * @param node The node, its letter is already written at depth - 1 of the buffer.
+ * @param buffer Pointer to buffer with the current word, grown if needed.
+ * @param buffer_size Pointer to size of the buffer.
+ * @param depth Length of the word of the node.
+ * @param callback Function called for every word.
+ * @param data Passed to callback.
+ */
+static void for_each_word_rec(const Node* node, wchar_t** buffer, size_t* buffer_size, size_t depth,
+                              Trie_Word_Callback callback, void* data)
+{
+    if(depth + 1 >= *buffer_size)
+    {
+        *buffer_size *= 2;
+        *buffer = realloc(*buffer, sizeof(wchar_t) * (*buffer_size));
+        if(*buffer == NULL) report_error(MEMORY);
+    }
+    if(node->is_word)
+    {
+        (*buffer)[depth] = L'\0';
+        callback(*buffer, node, data);
+    }
+    for(int i = 0; i < node->children->element_count; i++)
+    {
+        const Node* child = node->children->storage[i];
+        (*buffer)[depth] = child->value;
+        for_each_word_rec(child, buffer, buffer_size, depth + 1, callback, data);
+    }
+}
+
+void trie_for_each_word(const Node* root, Trie_Word_Callback callback, void* data)
+{
+    assert(root != NULL);
+    assert(callback != NULL);
+
+    size_t buffer_size = TRIE_WORD_BUFFER_START_SIZE;
+    wchar_t* buffer = malloc(sizeof(wchar_t) * buffer_size);
+    if(buffer == NULL) report_error(MEMORY);
+    for_each_word_rec(root, &buffer, &buffer_size, 0, callback, data);
+    free(buffer);
+}
+
+/**
+  * State of trie_diff().
+  */
+typedef struct
+{
+    wchar_t* buffer; ///<Buffer with the current word.
+    size_t buffer_size; ///<Size of the buffer.
+    Trie_Word_Callback removed; ///<Called for removed words.
+    void* removed_data; ///<Passed to removed.
+    Trie_Word_Callback added; ///<Called for added words.
+    void* added_data; ///<Passed to added.
+    size_t found; ///<Number of visited words.
+} Trie_Diff;
+
+/**
+ * @brief diff_nodes Visits differing words of subtrees of nodes with the same word.
+ * @param diff State of the search.
+ * @param from Node of the first trie or NULL.
+ * @param to Node of the second trie or NULL.
+ * @param depth Length of the word of the nodes, already written to the buffer.
+ */
+static void diff_nodes(Trie_Diff* diff, Node* from, Node* to, size_t depth)
+{
+    if(from == NULL || to == NULL)
+    {
+        Node* node = from != NULL ? from : to;
+        diff->found += node->word_count;
+        for_each_word_rec(node, &diff->buffer, &diff->buffer_size, depth,
+                          from != NULL ? diff->removed : diff->added,
+                          from != NULL ? diff->removed_data : diff->added_data);
+        return;
+    }
+    if(trie_hash(from) == trie_hash(to))
+        return;
+    if(depth + 1 >= diff->buffer_size)
+    {
+        diff->buffer_size *= 2;
+        diff->buffer = realloc(diff->buffer, sizeof(wchar_t) * diff->buffer_size);
+        if(diff->buffer == NULL) report_error(MEMORY);
+    }
+    diff->buffer[depth] = L'\0';
+    if(from->is_word && !to->is_word)
+    {
+        diff->found++;
+        diff->removed(diff->buffer, from, diff->removed_data);
+    }
+    else if(to->is_word && (!from->is_word || from->frequency != to->frequency))
+    {
+        diff->found++;
+        diff->added(diff->buffer, to, diff->added_data);
+    }
+
+    int i = 0, j = 0;
+    while(i < from->children->element_count || j < to->children->element_count)
+    {
+        Node* from_child = i < from->children->element_count ? from->children->storage[i] : NULL;
+        Node* to_child = j < to->children->element_count ? to->children->storage[j] : NULL;
+        if(from_child != NULL && to_child != NULL && from_child->value != to_child->value)
+        {
+            if(from_child->value < to_child->value)
+                to_child = NULL;
+            else
+                from_child = NULL;
+        }
+        if(from_child != NULL)
+            i++;
+        if(to_child != NULL)
+            j++;
+        diff->buffer[depth] = from_child != NULL ? from_child->value : to_child->value;
+        diff_nodes(diff, from_child, to_child, depth + 1);
+    }
+}
+
+size_t trie_diff(Node* from, Node* to, Trie_Word_Callback removed, void* removed_data,
+                 Trie_Word_Callback added, void* added_data)
+{
+    assert(from != NULL);
+    assert(to != NULL);
+    assert(removed != NULL);
+    assert(added != NULL);
+
+    Trie_Diff diff;
+    diff.buffer_size = TRIE_WORD_BUFFER_START_SIZE;
+    diff.buffer = malloc(sizeof(wchar_t) * diff.buffer_size);
+    if(diff.buffer == NULL) report_error(MEMORY);
+    diff.removed = removed;
+    diff.removed_data = removed_data;
+    diff.added = added;
+    diff.added_data = added_data;
+    diff.found = 0;
+    diff_nodes(&diff, from, to, 0);
+    free(diff.buffer);
+    return diff.found;
+}
+
 #ifndef NDEBUG
 ///Helper function drawing indention in console.
 static void indent(int n)
@@ -365,7 +1096,13 @@ bool trie_verify(const Node* node, bool is_root)
     if(!set_check_correctness(node->children)) return false;
     for(int i = 0; i < node->children->element_count; i++)
         if(!trie_verify(node->children->storage[i], false)) return false;
-    return true;
+    unsigned short min_depth, max_depth;
+    subtree_depths(node, &min_depth, &max_depth);
+    unsigned int word_count = node->is_word;
+    for(int i = 0; i < node->children->element_count; i++)
+        word_count += ((Node*)node->children->storage[i])->word_count;
+    return node->max_frequency == subtree_max_frequency(node)
+           && node->min_depth == min_depth && node->max_depth == max_depth && node->word_count == word_count;
 
 }
 #endif //TRIE_UNIT_TESTING
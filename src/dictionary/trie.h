@@ -12,6 +12,7 @@
  */
 
 #include <stdbool.h>
+#include <stdint.h>
 #include <wchar.h>
 #include "array_set.h"
 
@@ -31,6 +32,18 @@
 #define END_OF_NODE_SIGN L' ' ///<Value used to label in file an end of node, which is not a word.
 #define END_OF_WORD_NODE_SIGN L'\t' ///<Value used to label in file an end of node, which represents a word.
 
+#define TRIE_MAX_FREQUENCY 255 ///<Greatest frequency of a word.
+#define END_OF_FREQUENCY_SIGN L';' ///<Value used to label in file an end of frequency of a word.
+
+#define TRIE_MAX_DEPTH 65535 ///<Depths of subtrees greater than this one are clamped.
+
+#define TRIE_BATCH_GROUP 16 ///<Number of words searched in lockstep by trie_find_words().
+#define TRIE_WORD_BUFFER_START_SIZE 32 ///<Initial size of the buffer of words visited by trie_for_each_word().
+
+#define TRIE_MERGE_UNION 0 ///<Operation of trie_merge(): words of any trie.
+#define TRIE_MERGE_INTERSECTION 1 ///<Operation of trie_merge(): words of both tries.
+#define TRIE_MERGE_DIFFERENCE 2 ///<Operation of trie_merge(): words of the first trie absent in the second one.
+
 /**
   * Structure representing single node
   */
@@ -38,11 +51,54 @@ typedef struct Node
 {
     wchar_t value; ///<Sign represented by node.
     bool is_word; ///<Bool determining whether node represents a full word.
+    unsigned char frequency; ///<Frequency of the word, 0 if unknown. Meaningful only if is_word.
+    unsigned char max_frequency; ///<Greatest frequency of a word in the subtree of the node.
+    unsigned short min_depth; ///<Length of the shortest word in the subtree, counted from the node, at most TRIE_MAX_DEPTH.
+    unsigned short max_depth; ///<Length of the longest word in the subtree, counted from the node, at most TRIE_MAX_DEPTH.
+    unsigned int word_count; ///<Number of words in the subtree of the node, including its own.
+    uint64_t hash; ///<Hash of the subtree computed by trie_hash() or 0 if the subtree changed since.
 
     struct Node* parent; ///<Pointer to parent node, useful when deleting node.
     Array_Set* children; ///<Pointer to Array_Set, used to store child-nodes.
 } Node;
 
+/**
+  * Position in the words of a trie, in trie order.
+  * <p>
+  * The path from the root is kept on an explicit stack. The iterator is owned by the caller and its
+  * arrays grow only when a word longer than all previous ones is reached, so iterating does not allocate per word.
+  * The trie must not be modified while iterating.
+  */
+typedef struct
+{
+    const Node** nodes; ///<Path from the root to the current node, nodes[0] is the root.
+    int* next_child; ///<For every node of the path, index of its next child to visit.
+    wchar_t* word; ///<The current word, letters of the path.
+    size_t size; ///<Size of the arrays.
+    size_t depth; ///<Length of the path, without the root.
+    bool pending; ///<True if the current node is a word not returned yet.
+} Trie_Iterator;
+
+/**
+  * Builder of a trie from words given in trie order.
+  * <p>
+  * Only the path of the last word is kept. Every new word shares some prefix with it and
+  * gets new nodes appended as last children, nodes leaving the path are complete and get their bounds.
+  */
+typedef struct
+{
+    Node** path; ///<Path from the root to the node of the last word, path[0] is the root.
+    size_t size; ///<Size of the path array.
+    size_t depth; ///<Length of the last word.
+} Trie_Builder;
+
+/**
+ * Function called for every word of the trie.
+ * First parameter is the word, valid only during the call, second is node of the word
+ * and third is the user data.
+ */
+typedef void (*Trie_Word_Callback)(const wchar_t*, const Node*, void*);
+
 /**
  * @brief trie_new_node Creates and initializes node to be a root.
  * @return Root-like node.
@@ -81,6 +137,178 @@ int trie_delete_word(Node* root, const wchar_t*  word);
  */
 int trie_find_word(Node* root, const wchar_t* word);
 
+/**
+ * @brief trie_child Finds child of the node with given letter.
+ * @param node The node.
+ * @param letter The letter.
+ * @return The child or NULL if there is none.
+ */
+const Node* trie_child(const Node* node, wchar_t letter);
+
+/**
+ * @brief trie_find_words Tests which of the words are in the trie.
+ * @param root Root of the trie.
+ * @param words The words.
+ * @param count Number of words.
+ * @param found Array of count results, true if trie contains the word.
+ * TRIE_BATCH_GROUP words are searched at once, one step of each in turn. Every step prefetches
+ * memory read by the next step of the same word, so waiting for memory overlaps.
+ */
+void trie_find_words(const Node* root, const wchar_t* const* words, size_t count, bool* found);
+
+/**
+ * @brief trie_rank Counts words of the trie preceding the word.
+ * @param root Root of the trie.
+ * @param word The word, not necessarily in the trie.
+ * @return Number of words smaller than the word in trie order, i.e. by codes of letters.
+ * Costs O(|word| * fanout).
+ */
+size_t trie_rank(const Node* root, const wchar_t* word);
+
+/**
+ * @brief trie_select Finds the word of given rank.
+ * @param root Root of the trie.
+ * @param rank Number of words preceding the searched one in trie order.
+ * @return Node of the word or NULL if rank is not less than number of words.
+ * Costs O(depth * fanout).
+ */
+const Node* trie_select(const Node* root, size_t rank);
+
+/**
+ * @brief trie_node_word Copies the word of the node.
+ * @param node Node of the word.
+ * @return New string spelled by the path from the root to the node.
+ */
+wchar_t* trie_node_word(const Node* node);
+
+/**
+ * @brief trie_iterator_init Initializes iterator at the first word of the trie.
+ * @param iterator The iterator.
+ * @param root Root of the trie.
+ */
+void trie_iterator_init(Trie_Iterator* iterator, const Node* root);
+
+/**
+ * @brief trie_iterator_done Deallocates arrays of the iterator, but not the iterator itself.
+ * @param iterator The iterator.
+ */
+void trie_iterator_done(Trie_Iterator* iterator);
+
+/**
+ * @brief trie_iterator_seek Moves the iterator before the first word not smaller than the key.
+ * @param iterator The iterator.
+ * @param key The key, f.e. a prefix. Words starting with it come first, if there are any.
+ */
+void trie_iterator_seek(Trie_Iterator* iterator, const wchar_t* key);
+
+/**
+ * @brief trie_iterator_next Moves to the next word.
+ * @param iterator The iterator.
+ * @return The word, valid until the next call, or NULL after the last word.
+ * Node of the word is iterator->nodes[iterator->depth].
+ */
+const wchar_t* trie_iterator_next(Trie_Iterator* iterator);
+
+/**
+ * @brief trie_merge Builds a new trie from words of two tries.
+ * @param a Root of the first trie.
+ * @param b Root of the second trie.
+ * @param operation TRIE_MERGE_UNION, TRIE_MERGE_INTERSECTION or TRIE_MERGE_DIFFERENCE.
+ * @return Root of the new trie.
+ * Both tries are walked once, children of nodes are merged like sorted lists, so the cost is linear
+ * in their sizes. A word of both tries gets the greater frequency, other words keep theirs.
+ */
+Node* trie_merge(const Node* a, const Node* b, int operation);
+
+/**
+ * @brief trie_builder_init Starts building an empty trie.
+ * @param builder The builder.
+ */
+void trie_builder_init(Trie_Builder* builder);
+
+/**
+ * @brief trie_builder_add Adds the word, greater than all added ones.
+ * @param builder The builder.
+ * @param word The word.
+ * @param frequency Frequency of the word.
+ * @return Number of new nodes, i.e. the last ones of the word, or -1 if the word is not greater than the previous one.
+ */
+int trie_builder_add(Trie_Builder* builder, const wchar_t* word, unsigned char frequency);
+
+/**
+ * @brief trie_builder_finish Completes the trie and deallocates the builder.
+ * @param builder The builder.
+ * @return Root of the trie.
+ */
+Node* trie_builder_finish(Trie_Builder* builder);
+
+/**
+ * @brief trie_hash Computes hash of words and frequencies in the subtree of the node.
+ * @param node The node.
+ * @return The hash, never 0.
+ * Hashes are kept in nodes and cleared on the path to the root by every modification,
+ * so only subtrees changed since the last call are hashed again.
+ */
+uint64_t trie_hash(Node* node);
+
+/**
+ * @brief trie_diff Visits words which differ between two tries.
+ * @param from Root of the first trie.
+ * @param to Root of the second trie.
+ * @param removed Called for words of the first trie absent in the second one, with nodes of the first trie.
+ * @param removed_data Passed to removed.
+ * @param added Called for words of the second trie absent in the first one or with other frequency,
+ * with nodes of the second trie.
+ * @param added_data Passed to added.
+ * @return Number of visited words.
+ * Subtrees with equal hashes are skipped, so the cost depends on the changed subtrees only.
+ */
+size_t trie_diff(Node* from, Node* to, Trie_Word_Callback removed, void* removed_data,
+                 Trie_Word_Callback added, void* added_data);
+
+/**
+ * @brief trie_set_frequency Sets frequency of the word in the trie.
+ * @param root Root of the trie.
+ * @param word The word.
+ * @param frequency New frequency, up to TRIE_MAX_FREQUENCY.
+ * @return TRIE_WORD_FOUND or TRIE_WORD_NOT_FOUND, when word is not in trie.
+ * Greatest frequencies of subtrees on the path of the word are updated.
+ */
+int trie_set_frequency(Node* root, const wchar_t* word, unsigned char frequency);
+
+/**
+ * @brief trie_get_frequency Reads frequency of the word.
+ * @param root Root of the trie.
+ * @param word The word.
+ * @return Frequency of the word, 0 if word is not in trie.
+ */
+unsigned char trie_get_frequency(Node* root, const wchar_t* word);
+
+/**
+ * @brief trie_save_frequencies Saves frequencies of all words, in the order of trie_save_to_file().
+ * @param node Root of the trie.
+ * @param file File to save in.
+ * Every frequency is written in decimal and ended by END_OF_FREQUENCY_SIGN, 0 is written as the sign only.
+ */
+void trie_save_frequencies(const Node* node, FILE* file);
+
+/**
+ * @brief trie_load_frequencies Loads frequencies saved by trie_save_frequencies().
+ * @param node Root of the trie, loaded from the same file.
+ * @param file File to load from.
+ * @return 0 if success, <0 otherwise.
+ */
+int trie_load_frequencies(Node* node, FILE* file);
+
+/**
+ * @brief trie_for_each_word Calls the callback for every word of the trie, in alphabetical order.
+ * @param root Root of the trie.
+ * @param callback The function.
+ * @param data Passed to every call.
+ * The trie must not be modified by the callback.
+ */
+void trie_for_each_word(const Node* root, Trie_Word_Callback callback, void* data);
+
 /**
  * @brief trie_save_to_file Saves trie starting in root to file.
  * @param node Root of the trie to be saved.
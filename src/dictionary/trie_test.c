@@ -305,6 +305,226 @@ static void test_trie_structure_vertical_collapse(void** state)
     return;
 }
 
+///Tests keeping greatest frequencies of subtrees after setting frequencies and deleting words.
+///Compares words returned by the iterator with expected ones.
+static void assert_iterated(Trie_Iterator* iterator, wchar_t** expected, size_t count)
+{
+    for(size_t i = 0; i < count; i++)
+    {
+        const wchar_t* word = trie_iterator_next(iterator);
+        assert_non_null(word);
+        assert_true(wcscmp(word, expected[i]) == 0);
+        assert_true(iterator->nodes[iterator->depth]->is_word);
+    }
+    assert_null(trie_iterator_next(iterator));
+    assert_null(trie_iterator_next(iterator));
+}
+
+///Tests iteration in trie order and seeking.
+static void test_iterator(void** state)
+{
+    setup_trie_full_structure(state);
+    Node* root = *state;
+    wchar_t* sorted[] = {L"b", L"d", L"ą", L"ąąb", L"ąąbąą", L"ąąbć", L"ć", L"ę"};
+    Trie_Iterator iterator;
+    trie_iterator_init(&iterator, root);
+    assert_iterated(&iterator, sorted, 8);
+
+    trie_iterator_seek(&iterator, L"");
+    assert_iterated(&iterator, sorted, 8);
+    trie_iterator_seek(&iterator, L"ąą");
+    assert_iterated(&iterator, sorted + 3, 5);
+    trie_iterator_seek(&iterator, L"ąąb");
+    assert_iterated(&iterator, sorted + 3, 5);
+    trie_iterator_seek(&iterator, L"c");
+    assert_iterated(&iterator, sorted + 1, 7);
+    trie_iterator_seek(&iterator, L"ąąc");
+    assert_iterated(&iterator, sorted + 6, 2);
+    trie_iterator_seek(&iterator, L"z");
+    assert_iterated(&iterator, sorted + 2, 6);
+    trie_iterator_seek(&iterator, L"ęz");
+    assert_iterated(&iterator, NULL, 0);
+    trie_iterator_done(&iterator);
+
+    //words longer than the starting buffer
+    wchar_t long_word[101];
+    wmemset(long_word, L'ż', 100);
+    long_word[100] = L'\0';
+    trie_insert_word(root, long_word);
+    trie_iterator_init(&iterator, root);
+    trie_iterator_seek(&iterator, L"ż");
+    wchar_t* last[] = {long_word};
+    assert_iterated(&iterator, last, 1);
+    trie_iterator_seek(&iterator, long_word);
+    assert_iterated(&iterator, last, 1);
+    trie_iterator_done(&iterator);
+    teardown_trie(state);
+}
+
+///Tests union, intersection and difference of tries.
+static void test_merge(void** state)
+{
+    (void) state;
+    Node* a = trie_new_node();
+    Node* b = trie_new_node();
+    Node* empty = trie_new_node();
+    for(int i = 0; i < 5; i++)
+        trie_insert_word(a, fill[i]);
+    for(int i = 3; i < FILL_SIZE; i++)
+        trie_insert_word(b, fill[i]);
+    trie_set_frequency(a, L"ę", 5);
+    trie_set_frequency(b, L"ę", 9);
+    trie_set_frequency(a, L"ą", 7);
+
+    wchar_t* union_words[] = {L"b", L"d", L"dąb", L"ą", L"ąąb", L"ąąbąą", L"ąąbć", L"ć", L"ę"};
+    wchar_t* intersection_words[] = {L"ąąbć", L"ę"};
+    wchar_t* difference_words[] = {L"ą", L"ąąb", L"ąąbąą"};
+    wchar_t* reverse_words[] = {L"b", L"d", L"dąb", L"ć"};
+    Trie_Iterator iterator;
+    Node* merged = trie_merge(a, b, TRIE_MERGE_UNION);
+    assert_true(trie_verify(merged, true));
+    assert_int_equal(merged->word_count, 9);
+    assert_int_equal(trie_get_frequency(merged, L"ę"), 9);
+    assert_int_equal(trie_get_frequency(merged, L"ą"), 7);
+    assert_int_equal(merged->max_frequency, 9);
+    trie_iterator_init(&iterator, merged);
+    assert_iterated(&iterator, union_words, 9);
+    trie_iterator_done(&iterator);
+    trie_free_node(merged);
+
+    merged = trie_merge(a, b, TRIE_MERGE_INTERSECTION);
+    assert_true(trie_verify(merged, true));
+    assert_int_equal(trie_get_frequency(merged, L"ę"), 9);
+    trie_iterator_init(&iterator, merged);
+    assert_iterated(&iterator, intersection_words, 2);
+    trie_iterator_done(&iterator);
+    trie_free_node(merged);
+
+    merged = trie_merge(a, b, TRIE_MERGE_DIFFERENCE);
+    assert_true(trie_verify(merged, true));
+    assert_int_equal(merged->max_frequency, 7);
+    trie_iterator_init(&iterator, merged);
+    assert_iterated(&iterator, difference_words, 3);
+    trie_iterator_done(&iterator);
+    trie_free_node(merged);
+
+    merged = trie_merge(b, a, TRIE_MERGE_DIFFERENCE);
+    assert_true(trie_verify(merged, true));
+    trie_iterator_init(&iterator, merged);
+    assert_iterated(&iterator, reverse_words, 4);
+    trie_iterator_done(&iterator);
+    trie_free_node(merged);
+
+    merged = trie_merge(a, empty, TRIE_MERGE_INTERSECTION);
+    assert_true(trie_verify(merged, true));
+    assert_int_equal(merged->word_count, 0);
+    assert_int_equal(merged->children->element_count, 0);
+    trie_free_node(merged);
+
+    trie_free_node(a);
+    trie_free_node(b);
+    trie_free_node(empty);
+}
+
+///Adds the word to the list of strings given as data.
+static void collect_word(const wchar_t* word, const Node* node, void* data)
+{
+    wchar_t* list = data;
+    wcscat(list, word);
+    wcscat(list, L",");
+}
+
+///Tests hashes of subtrees and differences of tries.
+static void test_hash_diff(void** state)
+{
+    (void) state;
+    Node* a = trie_new_node();
+    Node* b = trie_new_node();
+    for(int i = 0; i < FILL_SIZE; i++)
+        trie_insert_word(a, fill[i]);
+    for(int i = FILL_SIZE - 1; i >= 0; i--)
+        trie_insert_word(b, fill[i]);
+    assert_true(trie_hash(a) == trie_hash(b));
+    wchar_t removed[64] = L"", added[64] = L"";
+    assert_int_equal(trie_diff(a, b, collect_word, removed, collect_word, added), 0);
+
+    uint64_t before = trie_hash(a);
+    assert_true(trie_set_frequency(b, L"ąąb", 4));
+    assert_true(trie_hash(a) != trie_hash(b));
+    assert_true(trie_set_frequency(b, L"ąąb", 0));
+    assert_true(trie_hash(a) == trie_hash(b));
+
+    trie_delete_word(b, L"ąąbąą");
+    trie_delete_word(b, L"b");
+    trie_insert_word(b, L"ąąc");
+    trie_set_frequency(b, L"d", 2);
+    assert_true(trie_hash(a) == before);
+    assert_true(trie_hash(a) != trie_hash(b));
+    assert_int_equal(trie_diff(a, b, collect_word, removed, collect_word, added), 4);
+    assert_true(wcscmp(removed, L"b,ąąbąą,") == 0);
+    assert_true(wcscmp(added, L"d,ąąc,") == 0);
+
+    trie_delete_word(b, L"ąąc");
+    trie_set_frequency(b, L"d", 0);
+    trie_insert_word(b, L"b");
+    trie_insert_word(b, L"ąąbąą");
+    assert_true(trie_hash(a) == trie_hash(b));
+    trie_free_node(a);
+    trie_free_node(b);
+}
+
+///Tests building of a trie from sorted words.
+static void test_builder(void** state)
+{
+    setup_trie_full_structure(state);
+    Node* root = *state;
+    wchar_t* sorted[] = {L"b", L"d", L"ą", L"ąąb", L"ąąbąą", L"ąąbć", L"ć", L"ę"};
+    int added[] = {1, 1, 1, 2, 2, 1, 1, 1};
+    trie_set_frequency(root, L"ąąb", 3);
+    Trie_Builder builder;
+    trie_builder_init(&builder);
+    for(int i = 0; i < 8; i++)
+    {
+        assert_int_equal(trie_builder_add(&builder, sorted[i], trie_get_frequency(root, sorted[i])), added[i]);
+        assert_int_equal(trie_builder_add(&builder, sorted[i], 0), -1);
+        assert_int_equal(trie_builder_add(&builder, L"a", 0), -1);
+    }
+    Node* built = trie_builder_finish(&builder);
+    assert_true(trie_verify(built, true));
+    assert_int_equal(built->word_count, 8);
+    assert_int_equal(built->max_frequency, 3);
+    assert_true(trie_hash(built) == trie_hash(root));
+    trie_free_node(built);
+    teardown_trie(state);
+}
+
+static void test_frequencies(void** state)
+{
+    setup_trie_full_structure(state);
+    Node* root = *state;
+
+    assert_true(trie_set_frequency(root, L"ąąbąą", 200));
+    assert_true(trie_set_frequency(root, L"ąąb", 50));
+    assert_true(trie_set_frequency(root, L"d", 10));
+    assert_false(trie_set_frequency(root, L"ąą", 10));
+    assert_true(trie_verify(root, true));
+    assert_int_equal(root->max_frequency, 200);
+    assert_int_equal(trie_get_frequency(root, L"ąąb"), 50);
+    assert_int_equal(trie_get_frequency(root, L"ąą"), 0);
+
+    assert_true(trie_delete_word(root, L"ąąbąą"));
+    assert_true(trie_verify(root, true));
+    assert_int_equal(root->max_frequency, 50);
+
+    assert_true(trie_set_frequency(root, L"ąąb", 0));
+    assert_true(trie_verify(root, true));
+    assert_int_equal(root->max_frequency, 10);
+
+    assert_true(trie_insert_word(root, L"ąąbąą"));
+    assert_int_equal(trie_get_frequency(root, L"ąąbąą"), 0);
+    teardown_trie(state);
+}
+
 //IO TESTS
 
 //IO buffer size in bytes (chars)
@@ -484,6 +704,30 @@ static void test_save_load_full_structure(void** state)
     teardown_trie(state);
 }
 
+///Saving and loading frequencies of words.
+static void test_save_load_frequencies(void** state)
+{
+    reset_io_buffer();
+    setup_trie_full_structure(state);
+    Node* root = *state;
+    trie_set_frequency(root, L"ąąbć", 255);
+    trie_set_frequency(root, L"b", 7);
+
+    trie_save_to_file(root, (FILE*) 42);
+    trie_save_frequencies(root, (FILE*) 42);
+
+    Node* read_root = trie_load_from_file((FILE*) 42);
+    assert_int_equal(trie_load_frequencies(read_root, (FILE*) 42), 0);
+    assert_true(trie_verify(read_root, true));
+    assert_int_equal(read_root->max_frequency, 255);
+    assert_int_equal(trie_get_frequency(read_root, L"ąąbć"), 255);
+    assert_int_equal(trie_get_frequency(read_root, L"b"), 7);
+    assert_int_equal(trie_get_frequency(read_root, L"ąąb"), 0);
+
+    trie_free_node(read_root);
+    teardown_trie(state);
+}
+
 ///Just to document this function.
 int main(int argc, char** argv)
 {
@@ -498,7 +742,12 @@ int main(int argc, char** argv)
         cmocka_unit_test(test_insert_full_structure),
         cmocka_unit_test(test_trie_structure_basic),
         cmocka_unit_test(test_trie_structure_horizontal_collapse),
-        cmocka_unit_test(test_trie_structure_vertical_collapse)
+        cmocka_unit_test(test_trie_structure_vertical_collapse),
+        cmocka_unit_test(test_frequencies),
+        cmocka_unit_test(test_iterator),
+        cmocka_unit_test(test_merge),
+        cmocka_unit_test(test_hash_diff),
+        cmocka_unit_test(test_builder)
     };
     cmocka_run_group_tests_name("Trie logic manual tests", trie_manual_tests, NULL, NULL);
 
@@ -507,7 +756,8 @@ int main(int argc, char** argv)
         //cmocka_unit_test(test_save_read_single_node),
         cmocka_unit_test(test_save_load_empty_trie),
         cmocka_unit_test(test_save_read_three_nodes),
-        cmocka_unit_test(test_save_load_full_structure)
+        cmocka_unit_test(test_save_load_full_structure),
+        cmocka_unit_test(test_save_load_frequencies)
     };
     cmocka_run_group_tests_name("Trie io tests", trie_io_tests, NULL, NULL);
 
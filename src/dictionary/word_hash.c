@@ -0,0 +1,276 @@
+/** @file
+    Implementation of hash set of words.
+    @ingroup word_hash
+    @author agent
+    @date 2026-10
+  */
+
+#include <stdlib.h>
+#include <string.h>
+#include <wchar.h>
+#include <assert.h>
+#include <stdint.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif // __SSE2__
+
+#include "word_hash.h"
+#include "error_handling.h"
+#include "fnv_hash.h"
+
+#ifdef WORD_HASH_UNIT_TESTING
+#include <stdarg.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#ifdef malloc
+#undef malloc
+#endif // malloc
+#define malloc(size) _test_malloc(size, __FILE__, __LINE__)
+
+#ifdef realloc
+#undef realloc
+#endif // realloc
+#define realloc(ptr, size) _test_realloc(ptr, size, __FILE__, __LINE__)
+
+#ifdef free
+#undef free
+#endif // free
+#define free(ptr) _test_free(ptr, __FILE__, __LINE__)
+
+#ifdef assert
+#undef assert
+#define assert(expression) mock_assert((int)(expression), #expression, __FILE__, __LINE__);
+#endif
+#endif // WORD_HASH_UNIT_TESTING
+
+#define NO_SLOT ((size_t) -1) ///<Value returned by find_slot() for absent words.
+#define FINGERPRINT_BITS 7 ///<Number of bits of the hash kept in the control byte.
+
+///Returns mask of slots of the group with the given control byte.
+static unsigned group_match(const unsigned char* group, unsigned char byte)
+{
+#ifdef __SSE2__
+    __m128i control = _mm_loadu_si128((const __m128i*) group);
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(control, _mm_set1_epi8((char) byte)));
+#else
+    unsigned ret = 0;
+    for(int i = 0; i < WORD_HASH_GROUP; i++)
+        if(group[i] == byte)
+            ret |= 1u << i;
+    return ret;
+#endif // __SSE2__
+}
+
+///Returns mask of empty and deleted slots of the group, the only ones with the highest bit set.
+static unsigned group_free(const unsigned char* group)
+{
+#ifdef __SSE2__
+    return _mm_movemask_epi8(_mm_loadu_si128((const __m128i*) group));
+#else
+    unsigned ret = 0;
+    for(int i = 0; i < WORD_HASH_GROUP; i++)
+        if(group[i] & WORD_HASH_EMPTY)
+            ret |= 1u << i;
+    return ret;
+#endif // __SSE2__
+}
+
+///Number of slots of the set.
+static size_t capacity(const Word_Hash* hash)
+{
+    return hash->group_count * WORD_HASH_GROUP;
+}
+
+/**
+ * @brief alloc_slots Allocates empty slots.
+ * @param hash The set, its old slots are not freed.
+ * @param group_count Number of groups, a power of two.
+ */
+static void alloc_slots(Word_Hash* hash, size_t group_count)
+{
+    hash->group_count = group_count;
+    hash->control = malloc(capacity(hash));
+    hash->offsets = malloc(sizeof(size_t) * capacity(hash));
+    if(hash->control == NULL || hash->offsets == NULL) report_error(MEMORY);
+    memset(hash->control, WORD_HASH_EMPTY, capacity(hash));
+    hash->deleted_count = 0;
+}
+
+Word_Hash* word_hash_new(void)
+{
+    Word_Hash* ret = malloc(sizeof(Word_Hash));
+    if(ret == NULL) report_error(MEMORY);
+    alloc_slots(ret, 1);
+    ret->word_count = 0;
+    ret->pool_size = WORD_HASH_POOL_START_SIZE;
+    ret->pool_used = 0;
+    ret->pool_garbage = 0;
+    ret->pool = malloc(sizeof(wchar_t) * ret->pool_size);
+    if(ret->pool == NULL) report_error(MEMORY);
+    return ret;
+}
+
+void word_hash_free(Word_Hash* hash)
+{
+    assert(hash != NULL);
+    free(hash->control);
+    free(hash->offsets);
+    free(hash->pool);
+    free(hash);
+}
+
+/**
+ * @brief find_slot Finds slot of the word.
+ * @param hash The set.
+ * @param word The word.
+ * @param word_hash Hash of the word.
+ * @return Index of the slot or NO_SLOT if the word is not in the set.
+ */
+static size_t find_slot(const Word_Hash* hash, const wchar_t* word, uint64_t word_hash)
+{
+    unsigned char fingerprint = word_hash & (WORD_HASH_EMPTY - 1);
+    size_t mask = hash->group_count - 1;
+    size_t group = (word_hash >> FINGERPRINT_BITS) & mask;
+    for(size_t step = 1; ; step++)
+    {
+        const unsigned char* control = hash->control + group * WORD_HASH_GROUP;
+        for(unsigned match = group_match(control, fingerprint); match != 0; match &= match - 1)
+        {
+            size_t slot = group * WORD_HASH_GROUP + __builtin_ctz(match);
+            if(wcscmp(hash->pool + hash->offsets[slot], word) == 0)
+                return slot;
+        }
+        if(group_match(control, WORD_HASH_EMPTY) != 0)
+            return NO_SLOT;
+        group = (group + step) & mask; //triangular steps visit every group
+    }
+}
+
+/**
+ * @brief place_word Puts the word, which is not in the set, into the first free slot.
+ * @param hash The set, with at least one empty slot.
+ * @param word The word.
+ * @param word_hash Hash of the word.
+ */
+static void place_word(Word_Hash* hash, const wchar_t* word, uint64_t word_hash)
+{
+    size_t len = wcslen(word) + 1;
+    if(hash->pool_used + len > hash->pool_size)
+    {
+        while(hash->pool_used + len > hash->pool_size)
+            hash->pool_size *= 2;
+        hash->pool = realloc(hash->pool, sizeof(wchar_t) * hash->pool_size);
+        if(hash->pool == NULL) report_error(MEMORY);
+    }
+
+    size_t mask = hash->group_count - 1;
+    size_t group = (word_hash >> FINGERPRINT_BITS) & mask;
+    unsigned free_slots;
+    for(size_t step = 1; (free_slots = group_free(hash->control + group * WORD_HASH_GROUP)) == 0; step++)
+        group = (group + step) & mask;
+    size_t slot = group * WORD_HASH_GROUP + __builtin_ctz(free_slots);
+    if(hash->control[slot] == WORD_HASH_DELETED)
+        hash->deleted_count--;
+    hash->control[slot] = word_hash & (WORD_HASH_EMPTY - 1);
+    hash->offsets[slot] = hash->pool_used;
+    memcpy(hash->pool + hash->pool_used, word, sizeof(wchar_t) * len);
+    hash->pool_used += len;
+    hash->word_count++;
+}
+
+/**
+ * @brief rehash Moves words to new slots and a compacted pool.
+ * @param hash The set.
+ * @param group_count New number of groups, a power of two.
+ */
+static void rehash(Word_Hash* hash, size_t group_count)
+{
+    unsigned char* old_control = hash->control;
+    size_t* old_offsets = hash->offsets;
+    wchar_t* old_pool = hash->pool;
+    size_t old_capacity = capacity(hash);
+
+    alloc_slots(hash, group_count);
+    hash->pool_size = hash->pool_used - hash->pool_garbage;
+    if(hash->pool_size < WORD_HASH_POOL_START_SIZE)
+        hash->pool_size = WORD_HASH_POOL_START_SIZE;
+    hash->pool = malloc(sizeof(wchar_t) * hash->pool_size);
+    if(hash->pool == NULL) report_error(MEMORY);
+    hash->pool_used = 0;
+    hash->pool_garbage = 0;
+    hash->word_count = 0;
+    for(size_t slot = 0; slot < old_capacity; slot++)
+        if((old_control[slot] & WORD_HASH_EMPTY) == 0)
+        {
+            const wchar_t* word = old_pool + old_offsets[slot];
+            place_word(hash, word, fnv_hash_word(word));
+        }
+    free(old_control);
+    free(old_offsets);
+    free(old_pool);
+}
+
+bool word_hash_insert(Word_Hash* hash, const wchar_t* word)
+{
+    assert(hash != NULL);
+    assert(word != NULL);
+
+    uint64_t word_hash = fnv_hash_word(word);
+    if(find_slot(hash, word, word_hash) != NO_SLOT)
+        return false;
+    //at most 7/8 of slots are used, so probing ends quickly
+    if((hash->word_count + hash->deleted_count + 1) * 8 > capacity(hash) * 7)
+    {
+        size_t group_count = hash->group_count;
+        if((hash->word_count + 1) * 16 > capacity(hash) * 7) //otherwise deleted slots are reclaimed
+            group_count *= 2;
+        rehash(hash, group_count);
+    }
+    place_word(hash, word, word_hash);
+    return true;
+}
+
+bool word_hash_remove(Word_Hash* hash, const wchar_t* word)
+{
+    assert(hash != NULL);
+    assert(word != NULL);
+
+    size_t slot = find_slot(hash, word, fnv_hash_word(word));
+    if(slot == NO_SLOT)
+        return false;
+    //probing stops at a group with an empty slot, so the slot may become empty too
+    if(group_match(hash->control + slot / WORD_HASH_GROUP * WORD_HASH_GROUP, WORD_HASH_EMPTY) != 0)
+        hash->control[slot] = WORD_HASH_EMPTY;
+    else
+    {
+        hash->control[slot] = WORD_HASH_DELETED;
+        hash->deleted_count++;
+    }
+    hash->pool_garbage += wcslen(word) + 1;
+    hash->word_count--;
+    return true;
+}
+
+bool word_hash_contains(const Word_Hash* hash, const wchar_t* word)
+{
+    assert(hash != NULL);
+    assert(word != NULL);
+
+    return find_slot(hash, word, fnv_hash_word(word)) != NO_SLOT;
+}
+
+///Callback of trie_for_each_word() adding the word to the set.
+static void build_visit(const wchar_t* word, const Node* node, void* data)
+{
+    (void) node;
+    word_hash_insert(data, word);
+}
+
+Word_Hash* word_hash_build(const Node* root)
+{
+    assert(root != NULL);
+
+    Word_Hash* ret = word_hash_new();
+    trie_for_each_word(root, build_visit, ret);
+    return ret;
+}
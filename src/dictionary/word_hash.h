@@ -0,0 +1,89 @@
+#ifndef WORD_HASH_H_INCLUDED
+#define WORD_HASH_H_INCLUDED
+
+/** @defgroup word_hash Module word_hash
+ * Hash set of words, answering membership queries in constant time.
+ */
+/**
+ * @file word_hash.h Header file of module word_hash.
+ * @ingroup word_hash
+ * @author agent <agent@local>
+ * @date 2026-10
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <wchar.h>
+#include "trie.h"
+
+#define WORD_HASH_GROUP 16 ///<Number of slots probed at once.
+#define WORD_HASH_EMPTY 0x80 ///<Control byte of a slot never used.
+#define WORD_HASH_DELETED 0xfe ///<Control byte of a slot of a removed word.
+#define WORD_HASH_POOL_START_SIZE 1024 ///<Start size of the string pool. Must be positive.
+
+/**
+ * Open-addressing hash set of words.
+ * <p>
+ * Slots are probed in groups of WORD_HASH_GROUP. Every slot has a control byte:
+ * 7 bits of the hash of its word (fingerprint), WORD_HASH_EMPTY or WORD_HASH_DELETED.
+ * Control bytes of a group are compared with the fingerprint at once, with SSE2 if available,
+ * and only words with matching fingerprint are compared. Words are kept one after another
+ * in a string pool. Groups are visited in triangular order until one with an empty slot is found.
+ */
+typedef struct
+{
+    size_t group_count; ///<Number of groups, a power of two.
+    unsigned char* control; ///<Control bytes, WORD_HASH_GROUP per group.
+    size_t* offsets; ///<Positions of words of the slots in the pool.
+    size_t word_count; ///<Number of words.
+    size_t deleted_count; ///<Number of slots marked as WORD_HASH_DELETED.
+    wchar_t* pool; ///<Words, each ended with L'\0'.
+    size_t pool_used; ///<Number of used letters of the pool.
+    size_t pool_size; ///<Size of the pool.
+    size_t pool_garbage; ///<Number of letters of removed words, reclaimed by rehashing.
+} Word_Hash;
+
+/**
+ * @brief word_hash_new Creates an empty set.
+ * @return Pointer to the new set.
+ */
+Word_Hash* word_hash_new(void);
+
+/**
+ * @brief word_hash_build Creates set of all words of the trie.
+ * @param root Root of the trie.
+ * @return Pointer to the new set.
+ */
+Word_Hash* word_hash_build(const Node* root);
+
+/**
+ * @brief word_hash_free Deallocates the set.
+ * @param hash The set.
+ */
+void word_hash_free(Word_Hash* hash);
+
+/**
+ * @brief word_hash_insert Adds the word to the set.
+ * @param hash The set.
+ * @param word The word.
+ * @return True if the word was added, false if it was present.
+ */
+bool word_hash_insert(Word_Hash* hash, const wchar_t* word);
+
+/**
+ * @brief word_hash_remove Removes the word from the set.
+ * @param hash The set.
+ * @param word The word.
+ * @return True if the word was removed, false if it was not present.
+ */
+bool word_hash_remove(Word_Hash* hash, const wchar_t* word);
+
+/**
+ * @brief word_hash_contains Tests if the word is in the set.
+ * @param hash The set.
+ * @param word The word.
+ * @return True if the set contains the word.
+ */
+bool word_hash_contains(const Word_Hash* hash, const wchar_t* word);
+
+#endif // WORD_HASH_H_INCLUDED
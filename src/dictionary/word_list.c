@@ -121,6 +121,7 @@ void word_list_done(struct word_list *list)
     assert(list != NULL);
     if(list->first != NULL)
         delete_word_node(list->first);
+    list->word_count = 0;
     list->first = NULL;
     list->last = NULL;
 }
@@ -156,6 +157,14 @@ int word_list_add(struct word_list *list, const wchar_t *word)
 
 
 wchar_t** word_list_get(const struct word_list* list)
+{
+    wchar_t** ret = word_list_get_in_order(list);
+    if(ret != NULL)
+        qsort((void*) ret, word_list_size(list), sizeof(wchar_t*), wcscomparator);
+    return ret;
+}
+
+wchar_t** word_list_get_in_order(const struct word_list* list)
 {
     if(word_list_size(list) == 0)
         return NULL;
@@ -174,7 +183,6 @@ wchar_t** word_list_get(const struct word_list* list)
         i++;
     }
     assert(i == word_list_size(list));
-    qsort((void*) ret, i, sizeof(wchar_t*), wcscomparator);
     return ret;
 }
 
@@ -106,4 +106,11 @@ size_t word_list_size(const struct word_list* list);
  */
 wchar_t** word_list_get(const struct word_list* list);
 
+/**
+ * @brief word_list_get_in_order Returns array of copied words in the order they were added.
+ * @param list List to copy from.
+ * @return Array of wide strings, independent of words in list, or NULL if list is empty.
+ */
+wchar_t** word_list_get_in_order(const struct word_list* list);
+
 #endif /* __WORD_LIST_H__ */
@@ -16,6 +16,8 @@ size_t lang_list_len = -1;
 bool dictionary_changed = false;
 int current_dict_pos = -1;
 
+#define HINTS_SHOWN 10 ///<Number of best hints offered in the correction dialog.
+
 static void info_msg (const gchar *msg) {
     GtkWidget *dialog;  // pop up window with only OK button
 
@@ -101,6 +103,22 @@ void dictionary_hints (const struct dictionary *dict, const wchar_t* word,
 
 
 
+// Dopisuje do podpowiedzi brakujące słowa brzmiące tak samo
+static void add_sound_alike(struct word_list *hints, const wchar_t *word)
+{
+    struct word_list sound_alike;
+    word_list_init(&sound_alike);
+    dictionary_sounds_like(current_dict, word, &sound_alike);
+    for (struct word_node *node = sound_alike.first; node != NULL; node = node->next) {
+        struct word_node *hint = hints->first;
+        while (hint != NULL && wcscmp(hint->word, node->word) != 0)
+            hint = hint->next;
+        if (hint == NULL)
+            word_list_add(hints, node->word);
+    }
+    word_list_done(&sound_alike);
+}
+
 static void WhatCheck (GtkMenuItem *item, gpointer data)
 {
     if(current_dict == NULL)
@@ -151,8 +169,11 @@ static void WhatCheck (GtkMenuItem *item, gpointer data)
         int i;
         wchar_t **words;
 
-        dictionary_hints(current_dict, (wchar_t *)wword, &hints);
-        words = word_list_get(&hints);
+        Hints_Options options;
+        hints_default_options(&options);
+        dictionary_hints_weighted(current_dict, (wchar_t *)wword, HINTS_SHOWN, &options, &hints);
+        add_sound_alike(&hints, (wchar_t *)wword);
+        words = word_list_get_in_order(&hints);
         dialog = gtk_dialog_new_with_buttons("Korekta", NULL, 0,
                                              GTK_STOCK_OK,
                                              GTK_RESPONSE_ACCEPT,
@@ -222,6 +243,13 @@ static void load_dict_port(GtkWidget *widget, gpointer data)
         dictionary_done(current_dict);
     }
     current_dict = dictionary_load_lang(lang_buffer+lang_position[pos]);
+    if(current_dict != NULL)
+    {
+        dictionary_hints_cache_enable(current_dict, HINTS_CACHE_DEFAULT_ENTRIES, HINTS_CACHE_DEFAULT_BYTES);
+        dictionary_phonetic_index_enable(current_dict);
+        dictionary_filter_enable(current_dict, DICTIONARY_FILTER_DEFAULT_RATE, DICTIONARY_FILTER_DEFAULT_BYTES);
+        dictionary_find_cache_enable(current_dict, FIND_CACHE_DEFAULT_ENTRIES);
+    }
     current_dict_pos = pos;
     return;
 }
@@ -333,6 +361,31 @@ void uncolor_text(void)
     return;
 }
 
+#define CHECK_BLOCK_WORDS 256 ///<Number of words checked at once.
+
+static wchar_t *block_words[CHECK_BLOCK_WORDS]; ///<Words waiting to be checked.
+static gint block_starts[CHECK_BLOCK_WORDS]; ///<Offsets of beginnings of the words.
+static gint block_ends[CHECK_BLOCK_WORDS]; ///<Offsets of ends of the words.
+static int block_count = 0; ///<Number of words waiting to be checked.
+
+// Sprawdza wszystkie czekające słowa naraz i koloruje błędne
+static void color_block(void)
+{
+    bool found[CHECK_BLOCK_WORDS];
+    dictionary_find_batch(current_dict, (const wchar_t * const *) block_words, block_count, found);
+    for (int i = 0; i < block_count; i++) {
+        if (!found[i]) {
+            GtkTextIter start, end;
+            gtk_text_buffer_get_iter_at_offset(editor_buf, &start, block_starts[i]);
+            gtk_text_buffer_get_iter_at_offset(editor_buf, &end, block_ends[i]);
+            gtk_text_buffer_apply_tag_by_name(editor_buf, "red_fg",
+                                                &start, &end);
+        }
+        g_free(block_words[i]);
+    }
+    block_count = 0;
+}
+
 void check_buffer_correctness(void)
 {
     uncolor_text();
@@ -352,7 +405,6 @@ void check_buffer_correctness(void)
     }
     GtkTextIter start, end;
     char *word;
-    wchar_t *wword;
     gtk_text_buffer_get_start_iter(editor_buf, &end);
 
     bool quit = false;
@@ -364,18 +416,16 @@ void check_buffer_correctness(void)
         start = end;
         gtk_text_iter_backward_word_start(&start);
         word = gtk_text_iter_get_text(&start, &end);
-        wword = (wchar_t*) g_utf8_to_ucs4_fast(word, -1, NULL);
-
-        if(dictionary_find(current_dict, wword) == DICTIONARY_WORD_NOT_FOUND)
-        {
-
-            gtk_text_buffer_apply_tag_by_name(editor_buf, "red_fg",
-                                                &start, &end);
-        }
+        block_words[block_count] = (wchar_t*) g_utf8_to_ucs4_fast(word, -1, NULL);
+        block_starts[block_count] = gtk_text_iter_get_offset(&start);
+        block_ends[block_count] = gtk_text_iter_get_offset(&end);
+        block_count++;
         //g_print("%s\n", word);
         g_free(word);
-        g_free(wword);
+        if (block_count == CHECK_BLOCK_WORDS)
+            color_block();
     }
+    color_block();
 
 }
 